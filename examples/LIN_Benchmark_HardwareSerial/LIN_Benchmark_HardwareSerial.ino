@@ -0,0 +1,60 @@
+/*********************
+
+Benchmark for LIN master node using HardwareSerial
+
+This code measures frame rate, CPU time per frame, handler() cost and frame duration jitter at 9.6kBaud and 19.2kBaud
+and prints the results as CSV lines with prefix "BENCH" to the console, e.g. for regression tracking
+
+Note: master request frames only require the LIN echo. If no LIN or K-Line transceiver is used, connect Rx&Tx
+
+Supported boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - Arduino Due            https://store.arduino.cc/products/arduino-due
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+#include "LIN_master_Benchmark.h"
+
+
+// measurement duration per baudrate [ms]
+#define BENCH_DURATION    5000
+
+
+// setup LIN node
+LIN_Master_HardwareSerial   LIN(Serial3, "LIN_HW");             // parameter: HW-interface, name
+
+// setup benchmark for LIN node
+LIN_Master_Benchmark   Bench(LIN);
+
+
+// call once
+void setup()
+{
+  LIN_Master_Benchmark::result_t    result;
+
+  // for output (only) to console
+  Serial.begin(115200);
+  while(!Serial);
+
+  // print CSV header
+  LIN_Master_Benchmark::printHeader(Serial);
+
+  // measure and print 9.6kBaud
+  Bench.run(9600, BENCH_DURATION, result);
+  LIN_Master_Benchmark::printResult(Serial, "HardwareSerial", result);
+
+  // measure and print 19.2kBaud
+  Bench.run(19200, BENCH_DURATION, result);
+  LIN_Master_Benchmark::printResult(Serial, "HardwareSerial", result);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  // nothing to do
+
+} // loop()
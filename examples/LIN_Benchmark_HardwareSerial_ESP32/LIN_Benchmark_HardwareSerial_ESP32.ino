@@ -0,0 +1,65 @@
+/*********************
+
+Benchmark for LIN master node using HardwareSerial of ESP32
+
+This code measures frame rate, CPU time per frame, handler() cost and frame duration jitter at 9.6kBaud and 19.2kBaud
+and prints the results as CSV lines with prefix "BENCH" to the console, e.g. for regression tracking
+
+Note: master request frames only require the LIN echo. If no LIN or K-Line transceiver is used, connect Rx&Tx
+
+Supported boards:
+ - ESP32 Wroom-32U        https://www.etechnophiles.com/esp32-dev-board-pinout-specifications-datasheet-and-schematic/
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial_ESP32.h"
+#include "LIN_master_Benchmark.h"
+
+// board pin definitions (GPIOn is referred to as n)
+#define PIN_LIN_RX    16        // receive pin for LIN
+#define PIN_LIN_TX    17        // transmit pin for LIN
+#define PIN_LED_RX    18        // LED for LIN receive
+#define PIN_LED_TX    5         // LED for LIN transmit
+
+
+// measurement duration per baudrate [ms]
+#define BENCH_DURATION    5000
+
+
+// setup LIN node
+LIN_Master_HardwareSerial_ESP32   LIN(Serial2, PIN_LIN_RX, PIN_LIN_TX, PIN_LED_RX, PIN_LED_TX, "LIN_HW");    // parameter: interface, Rx, Tx, LED Rx, LED Tx, name
+
+// setup benchmark for LIN node
+LIN_Master_Benchmark   Bench(LIN);
+
+
+// call once
+void setup()
+{
+  LIN_Master_Benchmark::result_t    result;
+
+  // for output (only) to console
+  Serial.begin(115200);
+  while(!Serial);
+
+  // print CSV header
+  LIN_Master_Benchmark::printHeader(Serial);
+
+  // measure and print 9.6kBaud
+  Bench.run(9600, BENCH_DURATION, result);
+  LIN_Master_Benchmark::printResult(Serial, "HardwareSerial_ESP32", result);
+
+  // measure and print 19.2kBaud
+  Bench.run(19200, BENCH_DURATION, result);
+  LIN_Master_Benchmark::printResult(Serial, "HardwareSerial_ESP32", result);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  // nothing to do
+
+} // loop()
@@ -0,0 +1,60 @@
+/*********************
+
+Benchmark for LIN master node using HardwareSerial of ESP8266
+
+This code measures frame rate, CPU time per frame, handler() cost and frame duration jitter at 9.6kBaud and 19.2kBaud
+and prints the results as CSV lines with prefix "BENCH" to the console, e.g. for regression tracking
+
+Note: master request frames only require the LIN echo. If no LIN or K-Line transceiver is used, connect Rx&Tx
+Note: Serial is used for LIN, console output is via Serial1 (Tx only, pin D4)
+
+Supported boards:
+ - ESP8266 D1 mini        https://www.wemos.cc/en/latest/d1/d1_mini.html
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial_ESP8266.h"
+#include "LIN_master_Benchmark.h"
+
+
+// measurement duration per baudrate [ms]
+#define BENCH_DURATION    5000
+
+
+// setup LIN node
+LIN_Master_HardwareSerial_ESP8266   LIN(true, "LIN_HW");    // parameter: use alternate Serial2 pins (Rx=D7/Tx=D8), name
+
+// setup benchmark for LIN node
+LIN_Master_Benchmark   Bench(LIN);
+
+
+// call once
+void setup()
+{
+  LIN_Master_Benchmark::result_t    result;
+
+  // for output (only) to console
+  Serial1.begin(115200);
+  while(!Serial1);
+
+  // print CSV header
+  LIN_Master_Benchmark::printHeader(Serial1);
+
+  // measure and print 9.6kBaud
+  Bench.run(9600, BENCH_DURATION, result);
+  LIN_Master_Benchmark::printResult(Serial1, "HardwareSerial_ESP8266", result);
+
+  // measure and print 19.2kBaud
+  Bench.run(19200, BENCH_DURATION, result);
+  LIN_Master_Benchmark::printResult(Serial1, "HardwareSerial_ESP8266", result);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  // nothing to do
+
+} // loop()
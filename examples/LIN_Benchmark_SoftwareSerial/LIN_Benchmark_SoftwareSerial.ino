@@ -0,0 +1,72 @@
+/*********************
+
+Benchmark for LIN master node using SoftwareSerial
+
+This code measures frame rate, CPU time per frame, handler() cost and frame duration jitter at 9.6kBaud and 19.2kBaud
+and prints the results as CSV lines with prefix "BENCH" to the console, e.g. for regression tracking
+
+Note: master request frames only require the LIN echo. If no LIN or K-Line transceiver is used, connect Rx&Tx
+Note: SoftwareSerial is blocking, i.e. CPU time per frame equals frame duration
+
+Supported boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - ESP8266 D1 mini        https://www.wemos.cc/en/latest/d1/d1_mini.html
+
+**********************/
+
+// include files
+#include "LIN_master_SoftwareSerial.h"
+#include "LIN_master_Benchmark.h"
+
+// board pin definitions
+#if defined(ARDUINO_AVR_MEGA2560)
+  #define PIN_LIN_RX    10        // receive pin for LIN
+  #define PIN_LIN_TX    14        // transmit pin for LIN
+#elif defined(ARDUINO_ESP8266_WEMOS_D1MINI)
+  #define PIN_LIN_RX    D7
+  #define PIN_LIN_TX    D8
+#else
+  #error adapt parameters to board   
+#endif
+
+
+// measurement duration per baudrate [ms]
+#define BENCH_DURATION    5000
+
+
+// setup LIN node
+LIN_Master_SoftwareSerial   LIN(PIN_LIN_RX, PIN_LIN_TX, false, "LIN_SW");       // parameter: Rx, Tx, inverseLogic, name
+
+// setup benchmark for LIN node
+LIN_Master_Benchmark   Bench(LIN);
+
+
+// call once
+void setup()
+{
+  LIN_Master_Benchmark::result_t    result;
+
+  // for output (only) to console
+  Serial.begin(115200);
+  while(!Serial);
+
+  // print CSV header
+  LIN_Master_Benchmark::printHeader(Serial);
+
+  // measure and print 9.6kBaud
+  Bench.run(9600, BENCH_DURATION, result);
+  LIN_Master_Benchmark::printResult(Serial, "SoftwareSerial", result);
+
+  // measure and print 19.2kBaud
+  Bench.run(19200, BENCH_DURATION, result);
+  LIN_Master_Benchmark::printResult(Serial, "SoftwareSerial", result);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  // nothing to do
+
+} // loop()
@@ -0,0 +1,60 @@
+/*********************
+
+Example code for LIN-to-host bridge using HardwareSerial
+
+This code turns an ESP32 into a LIN interface for PC tools. The host sends COBS framed packets with batched
+commands (one-shot frames, schedule table, start/stop) via USB, and receives packets with batched frame results
+incl. timestamps. Host side e.g. see extras/LIN_Bridge/linbridge.py:
+  python3 extras/LIN_Bridge/linbridge.py --port /dev/ttyUSB0 --baud 921600 MREQ:0x1A:2:5000:AA55 SRESP:0x05:8:10000
+
+Note: Bridge.handler() must be called as often as possible. It also calls the schedule and LIN handler().
+      Serial must not be used otherwise, as it carries the binary bridge protocol
+
+Supported (=successfully tested) boards:
+ - ESP32 Wroom-32U        https://www.etechnophiles.com/esp32-dev-board-pinout-specifications-datasheet-and-schematic/
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial_ESP32.h"
+#include "LIN_master_Bridge.h"
+
+
+// board pin definitions (GPIOn is referred to as n)
+#define PIN_LIN_RX    16        // receive pin for LIN
+#define PIN_LIN_TX    17        // transmit pin for LIN
+#define PIN_LED_RX    18        // LED for LIN receive
+#define PIN_LED_TX    5         // LED for LIN transmit
+
+// max. delay [us] of a frame result until it is sent to host. Longer = fewer, larger USB packets
+#define FLUSH_TIME    2000
+
+
+// setup LIN node and bridge to host
+LIN_Master_HardwareSerial_ESP32   LIN(Serial2, PIN_LIN_RX, PIN_LIN_TX, PIN_LED_RX, PIN_LED_TX, "LIN_HW");    // parameter: interface, Rx, Tx, LED Rx, LED Tx, name
+LIN_Master_Bridge                 Bridge(LIN, Serial);                                                      // parameter: LIN node, host link
+
+
+// call once
+void setup()
+{
+  // open host link. Use high baudrate for wire-rate traffic
+  Serial.begin(921600);
+  while(!Serial);
+
+  // open LIN interface
+  LIN.begin(19200);
+
+  // start bridge. Host sends schedule table and start command
+  Bridge.begin(FLUSH_TIME);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  // handle host commands, schedule, LIN node and results
+  Bridge.handler();
+
+} // loop()
@@ -0,0 +1,151 @@
+/*********************
+
+Example code for LIN-to-host bridge over a simulated bus
+
+This code runs the LIN-to-host bridge without LIN hardware and without host tool. A RAM buffer acts as host link,
+i.e. the sketch sends a COBS framed schedule table as a host would (see extras/LIN_Bridge/linbridge.py), and
+decodes the returned frame records. The table contains an event triggered slot, where two emulated slaves respond
+simultaneously (collision), and a slot of an absent slave with immediate retries. The bridge resolves the collision
+via the collision resolution table sent by the host, and retries the absent slave.
+
+Note: as no hardware is used, the sketch runs on any board
+
+Supported boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - Arduino Due            https://store.arduino.cc/products/arduino-due
+ - ESP32 Wroom-32U        https://www.etechnophiles.com/esp32-dev-board-pinout-specifications-datasheet-and-schematic/
+
+**********************/
+
+// include files
+#include "LIN_master_Sim.h"
+#include "LIN_master_Bridge.h"
+
+
+// host link via RAM buffers, i.e. bridge -> host bytes are collected and decoded by this sketch
+class HostLink : public Stream
+{
+  public:
+    const uint8_t   *rx = NULL;         // host -> bridge bytes
+    uint16_t        lenRx = 0;          // number of host -> bridge bytes
+    uint8_t         tx[256];            // packet received from bridge (COBS encoded)
+    uint16_t        lenTx = 0;          // number of bytes in above packet
+    void            (*onPacket)(const uint8_t Packet[], uint16_t Len) = NULL;
+
+    int available() { return lenRx; }
+    int read() { if (lenRx == 0) return -1; lenRx--; return *(rx++); }
+    int peek() { return (lenRx == 0) ? -1 : *rx; }
+    int availableForWrite() { return sizeof(tx); }
+    size_t write(uint8_t Byte)
+    {
+      if (Byte != 0x00) { if (lenTx < sizeof(tx)) tx[lenTx++] = Byte; return 1; }
+      if (onPacket != NULL) onPacket(tx, lenTx);
+      lenTx = 0;
+      return 1;
+    }
+    using Print::write;
+};
+
+
+// host packet (COBS encoded): schedule table with 2 slots, followed by start command.
+//   slot 0: event triggered frame 0x3A, 2 bytes, 10ms, no retry, resolution table with slave responses 0x10 and 0x11 (10ms each)
+//   slot 1: slave response 0x20 (absent slave), 2 bytes, 10ms, 2 immediate retries
+// Payload: 02 02 | 23 3A 02 10 27 00 00 00 | 02 | 22 10 02 10 27 00 00 00 | 22 11 02 10 27 00 00 00 | 22 20 02 10 27 00 00 02 | 03
+const uint8_t   HostPacket[] = {
+  0x08, 0x02, 0x02, 0x23, 0x3A, 0x02, 0x10, 0x27, 0x01, 0x01, 0x07, 0x02, 0x22, 0x10, 0x02, 0x10,
+  0x27, 0x01, 0x01, 0x06, 0x22, 0x11, 0x02, 0x10, 0x27, 0x01, 0x01, 0x06, 0x22, 0x20, 0x02, 0x10,
+  0x27, 0x01, 0x03, 0x02, 0x03, 0x00 };
+
+
+// setup LIN node over virtual bus and bridge to RAM host link
+LIN_Master_Sim        LIN("LIN_Sim");                              // parameter: name
+HostLink              Host;
+LIN_Master_Bridge     Bridge(LIN, Host);                           // parameter: LIN node, host link
+
+// frame table of emulated slaves, indexed by frame ID
+LIN_Master_Responder::entry_t   Slaves[64];
+
+
+// decode and print a COBS encoded packet from bridge (without delimiter)
+void printPacket(const uint8_t Packet[], uint16_t Len)
+{
+  uint8_t   payload[256];
+  uint16_t  len = 0;
+
+  // COBS decode
+  for (uint16_t i=0; i<Len; )
+  {
+    uint8_t code = Packet[i++];
+    for (uint8_t j=1; (j<code) && (i<Len); j++)
+      payload[len++] = Packet[i++];
+    if ((code != 0xFF) && (i < Len))
+      payload[len++] = 0x00;
+  }
+
+  // print frame and status records. Skip packet sequence number
+  for (uint16_t i=1; i<len; )
+  {
+    if (payload[i] == LIN_BRIDGE_REC_FRAME)
+    {
+      Serial.print("frame ID 0x");
+      Serial.print(payload[i+2] & 0x3F, HEX);
+      Serial.print(": ");
+      if (payload[i+3] == LIN_Master::NO_ERROR)
+        Serial.println("ok");
+      else if (payload[i+3] & LIN_Master::ERROR_CHK)
+        Serial.println("checksum error (collision)");
+      else
+        Serial.println("timeout");
+      i += 9 + payload[i+4];
+    }
+    else
+    {
+      Serial.print("bridge error 0x");
+      Serial.println(payload[i+1], HEX);
+      i += 3;
+    }
+  }
+
+} // printPacket()
+
+
+// call once
+void setup()
+{
+  uint8_t   Data[2];
+
+  // for output (only) to console
+  Serial.begin(115200);
+  while(!Serial);
+
+  // setup emulated slaves 0x10 and 0x11. Both respond to event triggered frame 0x3A, which is emulated by a response
+  // with classic checksum, i.e. a checksum error as for simultaneous responses. Slave 0x20 is absent
+  memset(Slaves, 0, sizeof(Slaves));
+  LIN.attachTable(Slaves);
+  Data[0] = LIN_Master::calculatePID(0x10);
+  Data[1] = 0x01;
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V1, 0x3A, 2, Data);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 2, Data);
+  Data[0] = LIN_Master::calculatePID(0x11);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x11, 2, Data);
+
+  // open virtual bus with wire timing and start bridge
+  LIN.setTiming(true);
+  LIN.begin(19200);
+  Bridge.begin(LIN_BRIDGE_FLUSH);
+
+  // "send" host packet and print bridge packets
+  Host.onPacket = printPacket;
+  Host.rx       = HostPacket;
+  Host.lenRx    = sizeof(HostPacket);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  // handle host commands, schedule, LIN node and results
+  Bridge.handler();
+
+} // loop()
@@ -0,0 +1,107 @@
+/*********************
+
+Example code for LIN master node with slaves of different baudrates using HardwareSerial
+
+This code runs a LIN master node in "background" operation using HardwareSerial interface. At startup the
+baudrate of an unknown slave is probed by polling its slave response frame at common LIN baudrates. Then a
+schedule table polls this slave at the found baudrate and a second slave at 19.2kBaud, i.e. the baudrate is
+switched per frame without re-opening the interface
+
+Note: LIN_Schedule.handler() must be called as often as possible. It also calls LIN.handler()
+
+Supported (=successfully tested) boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - Arduino Due            https://store.arduino.cc/products/arduino-due
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+#include "LIN_master_Schedule.h"
+
+
+// indicate LIN return status
+#define PIN_ERROR     32
+
+// ID and length of slave response of slave with unknown baudrate
+#define ID_PROBE      0x05
+#define LEN_PROBE     8
+
+// skip serial output (for time measurements)
+//#define SKIP_CONSOLE
+
+
+// schedule table. Parameter: type, version, ID, number of data, data, slot time [us], ET/sporadic table, table size,
+// retries, retry policy, baudrate [Baud] (0 = baudrate of LIN.begin())
+LIN_Master_Schedule::slot_t   Table[] = {
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, ID_PROBE, LEN_PROBE, NULL, 20000, NULL, 0, 0, LIN_Master_Schedule::RETRY_IMMEDIATE, 0 },
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x06,     4,         NULL, 10000, NULL, 0, 0, LIN_Master_Schedule::RETRY_IMMEDIATE, 19200 }
+};
+
+
+// setup LIN node and schedule
+LIN_Master_HardwareSerial   LIN(Serial3, "LIN_HW");             // parameter: HW-interface, name
+LIN_Master_Schedule         LIN_Schedule(LIN);                  // parameter: LIN node
+
+
+// called when frame of a slot is finished, state and error are reset afterwards
+void frameFinished(LIN_Master &Node, uint8_t Slot)
+{
+  // indicate status via pin
+  digitalWrite(PIN_ERROR, Node.getError());
+
+  // print result
+  #if !defined(SKIP_CONSOLE)
+    Serial.print(Node.nameLIN);
+    Serial.print(" slot ");
+    Serial.print((int) Slot);
+    Serial.print(" @ ");
+    Serial.print((int) Node.getBaudrate());
+    Serial.print("Bd: 0x");
+    Serial.println(Node.getError(), HEX);
+  #endif // SKIP_CONSOLE
+
+} // frameFinished()
+
+
+// call once
+void setup()
+{
+  uint16_t    baudrate;
+
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // for user interaction via console
+  Serial.begin(115200);
+  while(!Serial);
+
+  // open LIN interface
+  LIN.begin(19200);
+
+  // find baudrate of slave by polling its response at 19200, 10417, 9600, 4800 and 2400 Baud
+  baudrate = LIN.probeBaudrate(LIN_Master::LIN_V2, ID_PROBE, LEN_PROBE);
+  #if !defined(SKIP_CONSOLE)
+    Serial.print("slave 0x");
+    Serial.print((int) ID_PROBE, HEX);
+    Serial.print(" baudrate: ");
+    Serial.println((int) baudrate);
+  #endif
+  if (baudrate != 0)
+    Table[0].baudrate = baudrate;
+
+  // start schedule
+  LIN_Schedule.attachCallback(frameFinished);
+  LIN_Schedule.setTable(Table, sizeof(Table)/sizeof(LIN_Master_Schedule::slot_t));
+  LIN_Schedule.start();
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  // call LIN schedule handler (also calls LIN.handler())
+  LIN_Schedule.handler();
+
+} // loop()
@@ -0,0 +1,144 @@
+/*********************
+
+Example code for LIN master node with event driven background operation using HardwareSerial
+
+This code runs a LIN master node in event driven "background" operation using HardwareSerial interface.
+The state machine is progressed by Serial.event() on reception of the LIN echo, and a callback is called
+when the frame is finished. loop() only checks for timeouts every few ms and is free otherwise.
+
+Supported (=successfully tested) boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - Arduino Due            https://store.arduino.cc/products/arduino-due
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+
+
+// pin to demonstrate background operation
+#define PIN_TOGGLE    30
+
+// indicate LIN return status
+#define PIN_ERROR     32
+
+// pause between LIN frames
+#define LIN_PAUSE     100
+
+// interval for timeout check [ms]
+#define LIN_TIMEOUT_CHECK 5
+
+// skip serial output (for time measurements)
+//#define SKIP_CONSOLE
+
+
+// setup LIN node
+LIN_Master_HardwareSerial   LIN(Serial3, "LIN_HW");             // parameter: HW-interface, name
+
+
+// call when byte was received via Serial3. This routine is run between each time loop() runs, 
+// so using delay inside loop delays response. Multiple bytes of data may be available.
+void serialEvent3()
+{
+  // call LIN background handler
+  LIN.handler();
+
+} // serialEvent3()
+
+
+// called by LIN.handler() when frame is finished
+void frameFinished(LIN_Master &Node)
+{
+  LIN_Master::frame_t   Type;
+  uint8_t               Id;
+  uint8_t               NumData;
+  uint8_t               Data[8];
+
+  // get frame data
+  Node.getFrame(Type, Id, NumData, Data);
+
+  // indicate status via pin
+  digitalWrite(PIN_ERROR, Node.getError());
+
+  // print result
+  #if !defined(SKIP_CONSOLE)
+    Serial.print(millis());
+    Serial.print("\t");
+    Serial.print(Node.nameLIN);
+    if (Type == LIN_Master::MASTER_REQUEST)
+      Serial.print(" request callback: 0x");
+    else
+      Serial.print(" response callback: 0x");
+    Serial.println(Node.getError(), HEX);
+  #endif // SKIP_CONSOLE
+
+  // reset state machine & error
+  Node.resetStateMachine();
+  Node.resetError();
+
+} // frameFinished()
+
+
+// call once
+void setup()
+{
+  // indicate background operation
+  pinMode(PIN_TOGGLE, OUTPUT);
+
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // open LIN connection and attach callback
+  LIN.begin(19200);
+  LIN.attachCallback(frameFinished);
+  
+  // for user interaction via console
+  Serial.begin(115200);
+  while(!Serial);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t       lastLINFrame = 0;
+  static uint32_t       lastTimeoutCheck = 0;
+  static uint8_t        count = 0;
+  uint8_t               Tx[4] = {0x01, 0x02, 0x03, 0x04};
+  
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+
+  // missing slave response causes no serial event -> check for timeout occasionally
+  if (millis() - lastTimeoutCheck >= LIN_TIMEOUT_CHECK)
+  {
+    lastTimeoutCheck = millis();
+    LIN.handler();
+  }
+
+
+  // SW scheduler for sending/receiving LIN frames
+  if (millis() - lastLINFrame > LIN_PAUSE)
+  {
+    lastLINFrame = millis();
+
+    // send master request frame (background)
+    if (count == 0)
+    {
+      count++;
+      LIN.sendMasterRequest(LIN_Master::LIN_V2, 0x1B, 3, Tx);
+    }
+
+    // send slave response frame (background)
+    else
+    {
+      count = 0;
+      LIN.receiveSlaveResponse(LIN_Master::LIN_V2, 0x05, 8);
+    }
+    
+  } // SW scheduler
+
+} // loop()
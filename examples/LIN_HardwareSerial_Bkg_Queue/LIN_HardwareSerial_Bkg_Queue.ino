@@ -0,0 +1,133 @@
+/*********************
+
+Example code for LIN master node with background operation, job and result queue using HardwareSerial
+
+This code runs a LIN master node in "background" operation using HardwareSerial interface. Frames are
+appended to a job queue and are sent back-to-back by LIN.handler(). Finished frames are stored in a
+result queue, which is read in batches without polling getState() or resetting the state machine.
+
+Supported (=successfully tested) boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - Arduino Due            https://store.arduino.cc/products/arduino-due
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+
+
+// indicate LIN return status of response 0x05
+#define PIN_ERROR     32
+
+// pause between reading the result queue
+#define PRINT_PAUSE   100
+
+// size of result queue (holds SIZE_QUEUE-1 results)
+#define SIZE_QUEUE    16
+
+// size of job queue (holds SIZE_JOBS-1 frames)
+#define SIZE_JOBS     4
+
+// skip serial output (for time measurements)
+//#define SKIP_CONSOLE
+
+
+// setup LIN node
+LIN_Master_HardwareSerial   LIN(Serial3, "LIN_HW");             // parameter: HW-interface, name
+
+// buffers for result and job queue
+LIN_Master::result_t        Results[SIZE_QUEUE];
+LIN_Master::job_t           Jobs[SIZE_JOBS];
+
+
+// called when response frame 0x05 is finished (optional)
+void response05(const LIN_Master::result_t &Result)
+{
+  // indicate error via pin
+  digitalWrite(PIN_ERROR, (Result.error != LIN_Master::NO_ERROR));
+
+} // response05()
+
+
+// call once
+void setup()
+{
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // open LIN interface and attach queues
+  LIN.begin(19200);
+  LIN.attachResultQueue(Results, SIZE_QUEUE);
+  LIN.attachJobQueue(Jobs, SIZE_JOBS);
+  
+  // for user interaction via console
+  Serial.begin(115200);
+  while(!Serial);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t       lastPrint = 0;
+  static uint8_t        count = 0;
+  uint8_t               Tx[4] = {0x01, 0x02, 0x03, 0x04};
+  LIN_Master::result_t  Batch[4];
+  uint8_t               num;
+  
+
+  // call LIN background handler
+  LIN.handler();
+
+
+  // keep job queue filled. Frames are started back-to-back by handler()
+  while (LIN.freeJobs() > 0)
+  {
+    if (count == 0)
+    {
+      count++;
+      LIN.queueMasterRequest(LIN_Master::LIN_V2, 0x1B, 3, Tx);
+    }
+    else
+    {
+      count = 0;
+      LIN.queueSlaveResponse(LIN_Master::LIN_V2, 0x05, 8, response05);
+    }
+  }
+
+
+  // read and print results in batches
+  if (millis() - lastPrint > PRINT_PAUSE)
+  {
+    lastPrint = millis();
+
+    while ((num = LIN.readResults(Batch, 4)) > 0)
+    {
+      #if !defined(SKIP_CONSOLE)
+        for (uint8_t i=0; i<num; i++)
+        {
+          Serial.print(Batch[i].timestamp);
+          Serial.print("\t");
+          Serial.print(LIN.nameLIN);
+          Serial.print(" ID 0x");
+          Serial.print((int) Batch[i].id, HEX);
+          Serial.print(": 0x");
+          Serial.println(Batch[i].error, HEX);
+        }
+      #endif // SKIP_CONSOLE
+    }
+
+    // report lost results
+    if (LIN.getLostResults() > 0)
+    {
+      #if !defined(SKIP_CONSOLE)
+        Serial.print("lost results: ");
+        Serial.println((int) LIN.getLostResults());
+      #endif // SKIP_CONSOLE
+      LIN.resetLostResults();
+    }
+
+  } // read results
+
+} // loop()
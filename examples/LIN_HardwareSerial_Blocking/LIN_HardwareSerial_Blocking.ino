@@ -43,6 +43,9 @@ void setup()
   // open LIN interface
   LIN.begin(19200);  
 
+  // optionally generate BREAK via Tx pin override instead of baudrate switching (AVR, SAM). Tx of Serial3 is pin 14
+  //LIN.setBreakMode(LIN_Master_HardwareSerial::BREAK_PIN, 14);
+
   // for user interaction via console
   Serial.begin(115200);
   while(!Serial);
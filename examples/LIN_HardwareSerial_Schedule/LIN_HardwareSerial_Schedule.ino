@@ -0,0 +1,137 @@
+/*********************
+
+Example code for LIN master node with schedule table using HardwareSerial
+
+This code runs a LIN master node in "background" operation using HardwareSerial interface. Frames are
+sent via a schedule table with fixed slot times. The table is switched every 5s. Slave responses in table B
+are retried on timeout or checksum error, either directly within the slot or in an inserted slot
+
+Note: LIN_Schedule.handler() must be called as often as possible. It also calls LIN.handler()
+
+Supported (=successfully tested) boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - Arduino Due            https://store.arduino.cc/products/arduino-due
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+#include "LIN_master_Schedule.h"
+
+
+// pin to demonstrate background operation
+#define PIN_TOGGLE    30
+
+// indicate LIN return status
+#define PIN_ERROR     32
+
+// time between schedule table switches
+#define TABLE_SWITCH  5000
+
+// skip serial output (for time measurements)
+//#define SKIP_CONSOLE
+
+
+// data of master request frames
+uint8_t  Tx1[4] = {0x01, 0x02, 0x03, 0x04};
+uint8_t  Tx2[2] = {0xAA, 0x55};
+
+// schedule tables. Parameter: type, version, ID, number of data, data, slot time [us] (, ET/sporadic table, table size, retries, retry policy)
+const LIN_Master_Schedule::slot_t   TableA[] = {
+  { LIN_Master::MASTER_REQUEST, LIN_Master::LIN_V2, 0x1B, 4, Tx1,  10000 },
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x05, 8, NULL, 10000 }
+};
+const LIN_Master_Schedule::slot_t   TableB[] = {
+  { LIN_Master::MASTER_REQUEST, LIN_Master::LIN_V2, 0x1A, 2, Tx2,  5000 },
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x05, 8, NULL, 10000, NULL, 0, 1, LIN_Master_Schedule::RETRY_IMMEDIATE },
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x06, 4, NULL, 5000,  NULL, 0, 2, LIN_Master_Schedule::RETRY_NEXT_SLOT }
+};
+
+
+// setup LIN node and schedule
+LIN_Master_HardwareSerial   LIN(Serial3, "LIN_HW");             // parameter: HW-interface, name
+LIN_Master_Schedule         LIN_Schedule(LIN);                  // parameter: LIN node
+
+// learned slave response times per ID, for adaptive timeouts and skipping absent slaves
+LIN_Master::response_t      Responses[64];
+
+
+// called when frame of a slot is finished, state and error are reset afterwards
+void frameFinished(LIN_Master &Node, uint8_t Slot)
+{
+  LIN_Master::frame_t   Type;
+  uint8_t               Id;
+  uint8_t               NumData;
+  uint8_t               Data[8];
+
+  // get frame data
+  Node.getFrame(Type, Id, NumData, Data);
+
+  // indicate status via pin
+  digitalWrite(PIN_ERROR, Node.getError());
+
+  // print result
+  #if !defined(SKIP_CONSOLE)
+    Serial.print(micros());
+    Serial.print("\t");
+    Serial.print(Node.nameLIN);
+    Serial.print(" slot ");
+    Serial.print((int) Slot);
+    Serial.print(", ID 0x");
+    Serial.print((int) Id, HEX);
+    Serial.print(": 0x");
+    Serial.println(Node.getError(), HEX);
+  #endif // SKIP_CONSOLE
+
+} // frameFinished()
+
+
+// call once
+void setup()
+{
+  // indicate background operation
+  pinMode(PIN_TOGGLE, OUTPUT);
+
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // for user interaction via console
+  Serial.begin(115200);
+  while(!Serial);
+
+  // open LIN interface
+  LIN.begin(19200);
+  LIN.attachResponseTable(Responses);
+
+  // start schedule
+  LIN_Schedule.attachCallback(frameFinished);
+  LIN_Schedule.setTable(TableA, sizeof(TableA)/sizeof(LIN_Master_Schedule::slot_t));
+  LIN_Schedule.start();
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t   lastSwitch = 0;
+  static bool       useTableA = true;
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // call LIN schedule handler (also calls LIN.handler())
+  LIN_Schedule.handler();
+
+  // switch schedule table at end of current table
+  if (millis() - lastSwitch > TABLE_SWITCH)
+  {
+    lastSwitch = millis();
+    useTableA = !useTableA;
+    if (useTableA)
+      LIN_Schedule.setTable(TableA, sizeof(TableA)/sizeof(LIN_Master_Schedule::slot_t), false);
+    else
+      LIN_Schedule.setTable(TableB, sizeof(TableB)/sizeof(LIN_Master_Schedule::slot_t), false);
+  }
+
+} // loop()
@@ -0,0 +1,160 @@
+/*********************
+
+Example code for LIN master node with event triggered and sporadic frames using HardwareSerial
+
+This code runs a LIN master node in "background" operation using HardwareSerial interface. Four door nodes
+are polled via a single event triggered frame, i.e. only nodes with changed data respond. If several nodes
+respond at the same time (collision), the unconditional frames of all door nodes are polled via a collision
+resolution table in the following slots. A sporadic slot sends window commands only if they have changed
+
+Note: LIN_Schedule.handler() must be called as often as possible. It also calls LIN.handler()
+
+Supported (=successfully tested) boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - Arduino Due            https://store.arduino.cc/products/arduino-due
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+#include "LIN_master_Schedule.h"
+
+
+// pin to demonstrate background operation
+#define PIN_TOGGLE    30
+
+// indicate LIN return status
+#define PIN_ERROR     32
+
+// time between window commands
+#define TIME_COMMAND  2000
+
+// skip serial output (for time measurements)
+//#define SKIP_CONSOLE
+
+
+// data of sporadic master request frames
+uint8_t  TxWindowFront[2] = {0x00, 0x00};
+uint8_t  TxWindowRear[2]  = {0x00, 0x00};
+
+// collision resolution table: unconditional frames of door nodes (PID of frame + 2 data bytes)
+const LIN_Master_Schedule::slot_t   Doors[] = {
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 3, NULL, 10000 },
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x11, 3, NULL, 10000 },
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x12, 3, NULL, 10000 },
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x13, 3, NULL, 10000 }
+};
+
+// frames associated to sporadic slot, highest priority first
+const LIN_Master_Schedule::slot_t   Windows[] = {
+  { LIN_Master::MASTER_REQUEST, LIN_Master::LIN_V2, 0x20, 2, TxWindowFront, 10000 },
+  { LIN_Master::MASTER_REQUEST, LIN_Master::LIN_V2, 0x21, 2, TxWindowRear,  10000 }
+};
+
+// schedule table. Parameter: type, version, ID, number of data, data, slot time [us], resolution/associated frames, number of frames
+const LIN_Master_Schedule::slot_t   Table[] = {
+  { LIN_Master::EVENT_TRIGGERED, LIN_Master::LIN_V2, 0x3A, 3, NULL, 10000, Doors, sizeof(Doors)/sizeof(LIN_Master_Schedule::slot_t) },
+  { LIN_Master::SPORADIC,        LIN_Master::LIN_V2, 0x00, 0, NULL, 10000, Windows, sizeof(Windows)/sizeof(LIN_Master_Schedule::slot_t) }
+};
+
+
+// setup LIN node and schedule
+LIN_Master_HardwareSerial   LIN(Serial3, "LIN_HW");             // parameter: HW-interface, name
+LIN_Master_Schedule         LIN_Schedule(LIN);                  // parameter: LIN node
+
+
+// called when frame of a slot is finished, state and error are reset afterwards
+void frameFinished(LIN_Master &Node, uint8_t Slot)
+{
+  LIN_Master::frame_t   Type;
+  uint8_t               Id;
+  uint8_t               NumData;
+  uint8_t               Data[8];
+  LIN_Master::error_t   Error = Node.getError();
+
+  // get frame data
+  Node.getFrame(Type, Id, NumData, Data);
+
+  // event triggered frame without response -> no door has changed, nothing to report
+  if ((Type == LIN_Master::EVENT_TRIGGERED) && (Error == LIN_Master::ERROR_TIMEOUT))
+    return;
+
+  // indicate status via pin
+  digitalWrite(PIN_ERROR, Error);
+
+  // print result
+  #if !defined(SKIP_CONSOLE)
+    Serial.print(micros());
+    Serial.print("\t");
+    Serial.print(Node.nameLIN);
+    Serial.print(" slot ");
+    Serial.print((int) Slot);
+    Serial.print(", ID 0x");
+    Serial.print((int) Id, HEX);
+    if ((Type == LIN_Master::EVENT_TRIGGERED) && (Error == LIN_Master::ERROR_CHK))
+      Serial.println(": collision -> resolve");
+    else if (Error != LIN_Master::NO_ERROR)
+    {
+      Serial.print(": error 0x");
+      Serial.println(Error, HEX);
+    }
+    else if (Type == LIN_Master::MASTER_REQUEST)
+      Serial.println(": window command sent");
+    else
+    {
+      Serial.print(": door PID 0x");
+      Serial.print((int) Data[0], HEX);
+      Serial.print(", status 0x");
+      Serial.print((int) Data[1], HEX);
+      Serial.print(" 0x");
+      Serial.println((int) Data[2], HEX);
+    }
+  #endif // SKIP_CONSOLE
+
+} // frameFinished()
+
+
+// call once
+void setup()
+{
+  // indicate background operation
+  pinMode(PIN_TOGGLE, OUTPUT);
+
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // for user interaction via console
+  Serial.begin(115200);
+  while(!Serial);
+
+  // open LIN interface
+  LIN.begin(19200);
+
+  // start schedule
+  LIN_Schedule.attachCallback(frameFinished);
+  LIN_Schedule.setTable(Table, sizeof(Table)/sizeof(LIN_Master_Schedule::slot_t));
+  LIN_Schedule.start();
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t   lastCommand = 0;
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // call LIN schedule handler (also calls LIN.handler())
+  LIN_Schedule.handler();
+
+  // change front window command -> send in next sporadic slot
+  if (millis() - lastCommand > TIME_COMMAND)
+  {
+    lastCommand = millis();
+    TxWindowFront[0] ^= 0x01;
+    LIN_Schedule.setUpdated(0x20);
+  }
+
+} // loop()
@@ -0,0 +1,112 @@
+/*********************
+
+Example code for LIN master node with sleep and wake-up using HardwareSerial
+
+This code runs a LIN master node in "background" operation using HardwareSerial interface. While a key pin
+is active (low), frames are sent periodically. When the key is released, the go-to-sleep command is sent and
+the bus enters sleep mode. Pressing the key (or a wake-up pulse from a slave) wakes the bus up again.
+Frames requested during sleep are queued and sent directly after the wake-up delay, for a short key-on response.
+
+Supported (=successfully tested) boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - Arduino Due            https://store.arduino.cc/products/arduino-due
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+
+
+// key input (active low)
+#define PIN_KEY       31
+
+// indicate sleep mode
+#define PIN_SLEEP     32
+
+// pause between frames [ms]
+#define FRAME_PAUSE   100
+
+// delay after wake-up until first frame [ms]. Depends on slaves
+#define WAKEUP_DELAY  50
+
+// size of job queue (holds SIZE_JOBS-1 frames)
+#define SIZE_JOBS     4
+
+// skip serial output (for time measurements)
+//#define SKIP_CONSOLE
+
+
+// setup LIN node
+LIN_Master_HardwareSerial   LIN(Serial3, "LIN_HW");             // parameter: HW-interface, name
+
+// buffer for job queue
+LIN_Master::job_t           Jobs[SIZE_JOBS];
+
+
+// call once
+void setup()
+{
+  // key input and sleep indicator
+  pinMode(PIN_KEY, INPUT_PULLUP);
+  pinMode(PIN_SLEEP, OUTPUT);
+
+  // open LIN interface and attach job queue
+  LIN.begin(19200);
+  LIN.attachJobQueue(Jobs, SIZE_JOBS);
+  LIN.setWakeupDelay(WAKEUP_DELAY);
+
+  // slaves enter sleep mode after 4s bus idle -> follow them
+  LIN.setIdleTimeout(LIN_IDLE_TIMEOUT);
+
+  // for user interaction via console
+  Serial.begin(115200);
+  while(!Serial);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t       lastFrame = 0;
+  static bool           keyOld = false;
+  uint8_t               Tx[2] = {0x01, 0x02};
+  bool                  key = (digitalRead(PIN_KEY) == LOW);
+  LIN_Master::state_t   state;
+
+  // call LIN background handler
+  state = LIN.handler();
+
+  // indicate sleep mode
+  digitalWrite(PIN_SLEEP, (state == LIN_Master::STATE_SLEEP));
+
+  // key pressed -> wake up bus (if sleeping)
+  if (key && !keyOld)
+  {
+    if (LIN.wakeup())
+    {
+      #if !defined(SKIP_CONSOLE)
+        Serial.println("wake-up");
+      #endif
+    }
+  }
+
+  // key released -> send go-to-sleep command after queued frames (if not yet sleeping)
+  if (!key && keyOld)
+  {
+    while ((LIN.getState() != LIN_Master::STATE_SLEEP) && !LIN.goToSleep())
+      LIN.handler();
+    #if !defined(SKIP_CONSOLE)
+      Serial.println("go to sleep");
+    #endif
+  }
+  keyOld = key;
+
+  // key active -> send frames periodically. During wake-up they are queued
+  if (key && (millis() - lastFrame > FRAME_PAUSE) && (LIN.freeJobs() > 0))
+  {
+    lastFrame = millis();
+    LIN.queueMasterRequest(LIN_Master::LIN_V2, 0x1B, 2, Tx);
+  }
+
+} // loop()
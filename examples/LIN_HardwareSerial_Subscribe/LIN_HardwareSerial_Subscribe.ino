@@ -0,0 +1,119 @@
+/*********************
+
+Example code for LIN master node with last-value cache and change subscribers
+
+This code runs a LIN master node with a schedule table using HardwareSerial interface. The slave responses are
+stored in a last-value cache. A subscriber is only called if the response data has changed, and decodes only the
+changed signals. A second ID is polled from loop() via readChanges(), e.g. for forwarding only deltas to a gateway.
+
+Note: LIN_Schedule.handler() must be called as often as possible. It also calls LIN.handler()
+
+Supported (=successfully tested) boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+#include "LIN_master_Schedule.h"
+#include "LIN_master_Signal.h"
+
+
+// IDs of slave responses
+#define ID_STATUS     0x05
+#define ID_SENSOR     0x06
+
+// signals of status frame. Parameter: start bit, length [bit]
+typedef LIN_Master_Signal<0, 4>       StatusState;
+typedef LIN_Master_Signal<8, 12>      StatusCurrent;
+
+// skip serial output (for time measurements)
+//#define SKIP_CONSOLE
+
+
+// schedule table. Parameter: type, version, ID, number of data, data, slot time [us]
+const LIN_Master_Schedule::slot_t   Table[] = {
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, ID_STATUS, 4, NULL, 10000 },
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, ID_SENSOR, 8, NULL, 10000 }
+};
+
+
+// setup LIN node and schedule
+LIN_Master_HardwareSerial   LIN(Serial3, "LIN_HW");             // parameter: HW-interface, name
+LIN_Master_Schedule         LIN_Schedule(LIN);                  // parameter: LIN node
+
+// last-value cache with one entry per subscribed ID
+LIN_Master::cache_t         Cache[2];
+
+
+// called from handler() only if status data has changed
+void statusChanged(LIN_Master &Node, const LIN_Master::cache_t &Entry)
+{
+  (void) Node;
+
+  // print changed signals only
+  #if !defined(SKIP_CONSOLE)
+    if (StatusState::isChanged(Entry))
+    {
+      Serial.print("state: ");
+      Serial.println(StatusState::get(Entry.data));
+    }
+    if (StatusCurrent::isChanged(Entry))
+    {
+      Serial.print("current: ");
+      Serial.println(StatusCurrent::get(Entry.data));
+    }
+  #endif // SKIP_CONSOLE
+
+} // statusChanged()
+
+
+// call once
+void setup()
+{
+  // for user interaction via console
+  Serial.begin(115200);
+  while(!Serial);
+
+  // open LIN connection
+  LIN.begin(19200);
+
+  // cache slave responses. Status via subscriber, sensor is polled
+  LIN.attachChangeCache(Cache, 2);
+  LIN.subscribe(ID_STATUS, statusChanged);
+  LIN.subscribe(ID_SENSOR);
+
+  // start schedule
+  LIN_Schedule.setTable(Table, sizeof(Table)/sizeof(LIN_Master_Schedule::slot_t));
+  LIN_Schedule.start();
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  uint8_t   Data[8], Diff[8], NumData;
+
+  // call schedule handler (also calls LIN.handler())
+  LIN_Schedule.handler();
+
+  // print changed bytes of sensor frame
+  #if !defined(SKIP_CONSOLE)
+    if (LIN.readChanges(ID_SENSOR, Data, Diff, &NumData))
+    {
+      Serial.print("sensor:");
+      for (uint8_t i=0; i<NumData; i++)
+      {
+        if (Diff[i] == 0)
+          continue;
+        Serial.print(" [");
+        Serial.print((int) i);
+        Serial.print("]=0x");
+        Serial.print((int) Data[i], HEX);
+      }
+      Serial.println();
+    }
+  #endif // SKIP_CONSOLE
+
+} // loop()
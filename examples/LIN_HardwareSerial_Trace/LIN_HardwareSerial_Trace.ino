@@ -0,0 +1,98 @@
+/*********************
+
+Example code for LIN master node with binary frame trace using HardwareSerial
+
+This code runs a LIN master node in "background" operation using HardwareSerial interface. Frames are
+appended to a job queue and are sent back-to-back by LIN.handler(). Each finished frame is recorded into a
+RAM ring buffer as packed binary record (timestamp, PID, data, checksum, error, durations), which is streamed
+to the PC via Serial in bulk. Decode the trace on the PC with
+  python3 extras/LIN_Trace/lintrace.py --port <PORT> --baud 115200
+
+Note: Serial only outputs binary trace data, i.e. it can't be viewed in the serial monitor
+
+Supported (=successfully tested) boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - Arduino Due            https://store.arduino.cc/products/arduino-due
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+
+
+// pin to demonstrate background operation
+#define PIN_TOGGLE    30
+
+// indicate lost trace records, i.e. Serial too slow for bus load
+#define PIN_LOST      32
+
+// size of trace ring buffer [B]. A record takes 15..23 bytes
+#define SIZE_TRACE    512
+
+// size of job queue (holds SIZE_JOBS-1 frames)
+#define SIZE_JOBS     4
+
+
+// setup LIN node
+LIN_Master_HardwareSerial   LIN(Serial3, "LIN_HW");             // parameter: HW-interface, name
+
+// buffers for trace and job queue
+uint8_t                     Trace[SIZE_TRACE];
+LIN_Master::job_t           Jobs[SIZE_JOBS];
+
+
+// call once
+void setup()
+{
+  // indicate background operation
+  pinMode(PIN_TOGGLE, OUTPUT);
+
+  // indicate lost trace records via pin
+  pinMode(PIN_LOST, OUTPUT);
+
+  // open LIN interface, attach job queue and trace buffer
+  LIN.begin(19200);
+  LIN.attachJobQueue(Jobs, SIZE_JOBS);
+  LIN.attachTrace(Trace, SIZE_TRACE);
+
+  // for streaming trace to PC
+  Serial.begin(115200);
+  while(!Serial);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint8_t        count = 0;
+  uint8_t               Tx[4] = {0x01, 0x02, 0x03, 0x04};
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // call LIN background handler
+  LIN.handler();
+
+  // keep job queue filled. Frames are started back-to-back by handler()
+  while (LIN.freeJobs() > 0)
+  {
+    if (count == 0)
+    {
+      count++;
+      LIN.queueMasterRequest(LIN_Master::LIN_V2, 0x1B, 4, Tx);
+    }
+    else
+    {
+      count = 0;
+      LIN.queueSlaveResponse(LIN_Master::LIN_V2, 0x05, 8);
+    }
+  }
+
+  // stream trace to PC without blocking, i.e. only as much as fits into the Serial Tx buffer
+  LIN.drainTrace(Serial, Serial.availableForWrite());
+
+  // indicate lost records due to full trace buffer
+  digitalWrite(PIN_LOST, (LIN.getLostTrace() > 0));
+
+} // loop()
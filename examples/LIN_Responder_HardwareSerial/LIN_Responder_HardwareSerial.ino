@@ -0,0 +1,154 @@
+/*********************
+
+Example code for LIN master node with emulated slave nodes on a second HardwareSerial
+
+This code runs a LIN master node on Serial3 and emulates 12 slave nodes on Serial2 of the same board, e.g. for
+testing master code in a hardware-in-the-loop rig. Connect both interfaces to the same LIN bus (or connect
+Tx3, Rx3, Tx2 and Rx2 via diodes as wired-AND). The master polls the slave responses via a schedule table, and
+sends a master request which is received by the emulated slaves. Slave data is updated after each response.
+
+Note: LIN_Schedule.handler() and Slaves.handler() must be called as often as possible
+
+Supported (=successfully tested) boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+#include "LIN_master_Schedule.h"
+#include "LIN_master_Responder.h"
+
+
+// indicate LIN return status of master
+#define PIN_ERROR     32
+
+// number of emulated slaves, with response IDs 0x10..
+#define NUM_SLAVES    12
+
+// ID of master request received by all slaves
+#define ID_REQUEST    0x2A
+
+// skip serial output (for time measurements)
+//#define SKIP_CONSOLE
+
+
+// data of master request frame
+uint8_t  Tx[2] = {0x12, 0x34};
+
+// schedule table. Parameter: type, version, ID, number of data, data, slot time [us]
+LIN_Master_Schedule::slot_t   Table[NUM_SLAVES+1];
+
+
+// setup LIN master, schedule and slave emulation
+LIN_Master_HardwareSerial   LIN(Serial3, "Master");             // parameter: HW-interface, name
+LIN_Master_Schedule         LIN_Schedule(LIN);                  // parameter: LIN node
+LIN_Master_Responder        Slaves(Serial2);                    // parameter: HW-interface
+
+// frame table of emulated slaves, indexed by frame ID
+LIN_Master_Responder::entry_t   Frames[64];
+
+
+// called when emulated slaves have sent a response or received a request
+void slaveFrame(uint8_t Id, LIN_Master::error_t Error)
+{
+  uint8_t   Data[4];
+
+  // response sent -> update data for next response
+  if ((Error == LIN_Master::NO_ERROR) && (Id != ID_REQUEST))
+  {
+    Data[0] = Id;
+    Data[1] = Frames[Id].count;
+    Data[2] = 0x00;
+    Data[3] = 0xFF;
+    Slaves.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, Id, 4, Data);
+  }
+
+} // slaveFrame()
+
+
+// called when frame of a master slot is finished
+void masterFrame(LIN_Master &Node, uint8_t Slot)
+{
+  // indicate status via pin
+  digitalWrite(PIN_ERROR, Node.getError());
+
+  // print errors
+  #if !defined(SKIP_CONSOLE)
+    if (Node.getError() != LIN_Master::NO_ERROR)
+    {
+      Serial.print(Node.nameLIN);
+      Serial.print(" slot ");
+      Serial.print((int) Slot);
+      Serial.print(": error 0x");
+      Serial.println(Node.getError(), HEX);
+    }
+  #endif // SKIP_CONSOLE
+
+} // masterFrame()
+
+
+// call once
+void setup()
+{
+  uint8_t   Data[4] = {0x00, 0x00, 0x00, 0xFF};
+
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // for user interaction via console
+  Serial.begin(115200);
+  while(!Serial);
+
+  // setup emulated slaves: one response frame per slave, and one common master request
+  memset(Frames, 0, sizeof(Frames));
+  Slaves.attachTable(Frames);
+  Slaves.attachCallback(slaveFrame);
+  for (uint8_t i=0; i<NUM_SLAVES; i++)
+  {
+    Data[0] = 0x10 + i;
+    Slaves.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10 + i, 4, Data);
+  }
+  Slaves.setFrame(LIN_Master::MASTER_REQUEST, LIN_Master::LIN_V2, ID_REQUEST, 2);
+  Slaves.begin(19200);
+
+  // setup master schedule: poll all slaves, then send request
+  for (uint8_t i=0; i<NUM_SLAVES; i++)
+    Table[i] = { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, (uint8_t) (0x10 + i), 4, NULL, 5000 };
+  Table[NUM_SLAVES] = { LIN_Master::MASTER_REQUEST, LIN_Master::LIN_V2, ID_REQUEST, 2, Tx, 5000 };
+  LIN.begin(19200);
+  LIN_Schedule.attachCallback(masterFrame);
+  LIN_Schedule.setTable(Table, NUM_SLAVES+1);
+  LIN_Schedule.start();
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t   lastPrint = 0;
+  uint8_t           Rx[2];
+
+  // call master schedule handler (also calls LIN.handler())
+  LIN_Schedule.handler();
+
+  // call slave emulation handler. Responses are sent directly after the received PID
+  Slaves.handler();
+
+  // print request received by emulated slaves
+  if (millis() - lastPrint > 1000)
+  {
+    lastPrint = millis();
+    Slaves.getData(ID_REQUEST, Rx);
+    #if !defined(SKIP_CONSOLE)
+      Serial.print("slaves received 0x");
+      Serial.print((int) Rx[0], HEX);
+      Serial.print(" 0x");
+      Serial.print((int) Rx[1], HEX);
+      Serial.print(", count ");
+      Serial.println((int) Frames[ID_REQUEST].count);
+    #endif // SKIP_CONSOLE
+  }
+
+} // loop()
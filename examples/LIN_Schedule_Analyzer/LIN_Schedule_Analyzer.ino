@@ -0,0 +1,157 @@
+/*********************
+
+Example code for checking LIN schedule tables at compile time and run time
+
+This code checks a schedule table at compile time via static_assert(), prints cycle time, bus load and timing
+violations per slot, and suggests a compressed table with minimal slot times that still tolerate silent slaves
+and immediate retries. Finally, the compressed table is executed on a simulated bus.
+
+Note: to reject infeasible tables in LIN_Master_Schedule::setTable() and start() at run time,
+      enable LIN_SCHEDULE_CHECK in LIN_master_Schedule.h
+
+Supported boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - Arduino Due            https://store.arduino.cc/products/arduino-due
+ - ESP32 Wroom-32U        https://www.etechnophiles.com/esp32-dev-board-pinout-specifications-datasheet-and-schematic/
+
+**********************/
+
+// include files
+#include "LIN_master_Sim.h"
+#include "LIN_master_Schedule.h"
+#include "LIN_master_Analyzer.h"
+
+
+// LIN baudrate
+#define LIN_BAUDRATE    19200
+
+// number of slots in below table
+#define NUM_SLOTS       4
+
+
+// data of master request frame
+uint8_t  Tx[4] = {0x01, 0x02, 0x03, 0x04};
+
+// schedule table. Must be constexpr for compile-time checks. Parameter: type, version, ID, number of data, data, slot time [us], -, -, retries, retry policy
+constexpr LIN_Master_Schedule::slot_t   Table[NUM_SLOTS] = {
+  { LIN_Master::MASTER_REQUEST, LIN_Master::LIN_V2, 0x1B, 4, Tx,   10000 },
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x05, 8, NULL, 10000 },
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x06, 2, NULL, 20000, NULL, 0, 1, LIN_Master_Schedule::RETRY_IMMEDIATE },
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V1, 0x07, 1, NULL, 5000 }
+};
+
+// compile-time check: every slot holds its frame with 140% LIN tolerance
+static_assert(LIN_Master_Analyzer::isFeasible(Table, NUM_SLOTS, LIN_BAUDRATE), "schedule table is infeasible");
+static_assert(LIN_Master_Analyzer::loadNominal(Table, NUM_SLOTS, LIN_BAUDRATE) < 80, "bus load exceeds 80%");
+
+
+// setup LIN node over virtual bus and schedule
+LIN_Master_Sim        LIN("LIN_Sim");                              // parameter: name
+LIN_Master_Schedule   LIN_Schedule(LIN);                           // parameter: LIN node
+
+// compressed copy of above table
+LIN_Master_Schedule::slot_t   Compressed[NUM_SLOTS];
+
+// frame table of emulated slaves, indexed by frame ID
+LIN_Master_Responder::entry_t   Slaves[64];
+
+
+// print analysis of a schedule table
+void printAnalysis(const char Name[], const LIN_Master_Schedule::slot_t Table[], uint8_t NumSlots)
+{
+  LIN_Master_Analyzer::result_t   result;
+
+  // analyze table at run time
+  LIN_Master_Analyzer::analyze(Table, NumSlots, LIN_BAUDRATE, result);
+
+  // print table summary
+  Serial.print(Name);
+  Serial.print(": cycle [us] ");
+  Serial.print(result.cycleNominal);
+  Serial.print(" (worst ");
+  Serial.print(result.cycleWorst);
+  Serial.print("), bus load [%] ");
+  Serial.print((int) result.loadNominal);
+  Serial.print(" (worst ");
+  Serial.print((int) result.loadWorst);
+  Serial.print("), infeasible slots ");
+  Serial.println((int) result.numInfeasible);
+
+  // print slots
+  for (uint8_t i=0; i<NumSlots; i++)
+  {
+    uint8_t   violation = LIN_Master_Analyzer::checkSlot(Table[i], LIN_BAUDRATE);
+
+    Serial.print("  slot ");
+    Serial.print((int) i);
+    Serial.print(": time ");
+    Serial.print(Table[i].slotTime);
+    Serial.print(", frame nominal ");
+    Serial.print(LIN_Master_Analyzer::slotNominal(Table[i], LIN_BAUDRATE));
+    Serial.print(", max ");
+    Serial.print(LIN_Master_Analyzer::slotMax(Table[i], LIN_BAUDRATE));
+    Serial.print(", worst ");
+    Serial.print(LIN_Master_Analyzer::slotWorst(Table[i], LIN_BAUDRATE));
+    if (violation == LIN_Master_Analyzer::SLOT_OK)
+      Serial.println(" -> ok");
+    else if (violation & (LIN_Master_Analyzer::SLOT_NOMINAL | LIN_Master_Analyzer::SLOT_MAX | LIN_Master_Analyzer::SLOT_INVALID))
+      Serial.println(" -> infeasible");
+    else
+      Serial.println(" -> overrun if slave is silent");
+  }
+
+} // printAnalysis()
+
+
+// call once
+void setup()
+{
+  // for output (only) to console
+  Serial.begin(115200);
+  while(!Serial);
+
+  // print analysis of original table
+  printAnalysis("original", Table, NUM_SLOTS);
+
+  // create and print compressed table with 1ms time base and 100us inter-frame space
+  LIN_Master_Analyzer::compress(Table, Compressed, NUM_SLOTS, LIN_BAUDRATE, 100, 1000);
+  printAnalysis("compressed", Compressed, NUM_SLOTS);
+
+  // setup emulated slaves. Slave 0x07 is absent
+  memset(Slaves, 0, sizeof(Slaves));
+  LIN.attachTable(Slaves);
+  LIN.setFrame(LIN_Master::MASTER_REQUEST, LIN_Master::LIN_V2, 0x1B, 4);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x05, 8);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x06, 2);
+
+  // execute compressed table on virtual bus with wire timing
+  LIN.setTiming(true);
+  LIN.begin(LIN_BAUDRATE);
+  LIN_Schedule.setTable(Compressed, NUM_SLOTS);
+  if (!LIN_Schedule.start())
+    Serial.println("schedule rejected");
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t   lastPrint = 0;
+
+  // handle schedule and LIN node
+  LIN_Schedule.handler();
+
+  // print frame counters of emulated slaves every second
+  if (millis() - lastPrint > 1000)
+  {
+    lastPrint = millis();
+    Serial.print("frames: 0x1B=");
+    Serial.print((int) Slaves[0x1B].count);
+    Serial.print(", 0x05=");
+    Serial.print((int) Slaves[0x05].count);
+    Serial.print(", 0x06=");
+    Serial.println((int) Slaves[0x06].count);
+  }
+
+} // loop()
@@ -0,0 +1,60 @@
+/**
+  \file     LDF_Example.h
+  \brief    LIN signal descriptors and schedule tables generated from Example.ldf
+  \details  Generated by extras/LDF_Generator/ldf2h.py. Do not edit!
+            Frame buffers and tables have internal linkage, i.e. include this file in one source file only.
+*/
+
+#ifndef _LDF_EXAMPLE_H_
+#define _LDF_EXAMPLE_H_
+
+#include "LIN_master_Signal.h"
+#include "LIN_master_Schedule.h"
+
+namespace LDF_Example
+{
+  constexpr LIN_Master::version_t  version  = LIN_Master::LIN_V2;    //!< LIN protocol version
+  constexpr uint16_t               baudrate = 19200;    //!< LIN_speed [Baud]
+
+  /// frame MotorCmd (master request)
+  namespace MotorCmd
+  {
+    constexpr LIN_Master::frame_t  type    = LIN_Master::MASTER_REQUEST;
+    constexpr uint8_t              id      = 0x1B;
+    constexpr uint8_t              numData = 2;
+    typedef LIN_Master_Signal<0, 1>  MotorOn;    //!< signal MotorOn, 1 bit @ bit 0
+    typedef LIN_Master_Signal<1, 1>  MotorDir;    //!< signal MotorDir, 1 bit @ bit 1
+    typedef LIN_Master_Signal<2, 12>  MotorSpeed;    //!< signal MotorSpeed, 12 bit @ bit 2
+    static LIN_Master_SignalFrame<numData>  frame;    //!< frame data with change tracking
+  }
+
+  /// frame MotorStatus (slave response)
+  namespace MotorStatus
+  {
+    constexpr LIN_Master::frame_t  type    = LIN_Master::SLAVE_RESPONSE;
+    constexpr uint8_t              id      = 0x05;
+    constexpr uint8_t              numData = 8;
+    typedef LIN_Master_Signal<0, 2>  MotorState;    //!< signal MotorState, 2 bit @ bit 0
+    typedef LIN_Master_Signal<2, 10>  MotorTemp;    //!< signal MotorTemp, 10 bit @ bit 2
+    typedef LIN_Master_Signal<16, 8>  MotorCurrent;    //!< signal MotorCurrent, 8 bit @ bit 16
+    typedef LIN_Master_SignalArray<4, 4>  MotorSerial;    //!< array signal MotorSerial, 4 byte @ byte 4
+    static LIN_Master_SignalFrame<numData>  frame;    //!< frame data with change tracking
+  }
+
+  /// schedule table Normal
+  static const LIN_Master_Schedule::slot_t  Normal[] = {
+    { MotorCmd::type, version, MotorCmd::id, MotorCmd::numData, MotorCmd::frame.data, 10000, NULL, 0, 0, LIN_Master_Schedule::RETRY_IMMEDIATE, 0 },
+    { MotorStatus::type, version, MotorStatus::id, MotorStatus::numData, NULL, 10000, NULL, 0, 0, LIN_Master_Schedule::RETRY_IMMEDIATE, 0 },
+  };
+  constexpr uint8_t  Normal_numSlots = sizeof(Normal) / sizeof(LIN_Master_Schedule::slot_t);
+
+  /// schedule table Diagnostic
+  static const LIN_Master_Schedule::slot_t  Diagnostic[] = {
+    // MasterReq skipped (no unconditional frame)
+    { MotorStatus::type, version, MotorStatus::id, MotorStatus::numData, NULL, 10000, NULL, 0, 0, LIN_Master_Schedule::RETRY_IMMEDIATE, 0 },
+  };
+  constexpr uint8_t  Diagnostic_numSlots = sizeof(Diagnostic) / sizeof(LIN_Master_Schedule::slot_t);
+
+} // namespace LDF_Example
+
+#endif // _LDF_EXAMPLE_H_
@@ -0,0 +1,116 @@
+/*********************
+
+Example code for LIN master node with signal layer and schedule table generated from an LDF
+
+This code runs a LIN master node with a schedule table using HardwareSerial interface. Frame and signal
+descriptors and the schedule table in LDF_Example.h are generated from extras/LDF_Generator/Example.ldf via
+  python3 extras/LDF_Generator/ldf2h.py extras/LDF_Generator/Example.ldf examples/LIN_Signal_Schedule/LDF_Example.h
+Signals are packed into the master request and only changed signals of the slave response are decoded
+
+Note: LIN_Schedule.handler() must be called as often as possible. It also calls LIN.handler()
+
+Supported (=successfully tested) boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - Arduino Due            https://store.arduino.cc/products/arduino-due
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+#include "LIN_master_Schedule.h"
+#include "LDF_Example.h"
+
+
+// time between motor speed changes
+#define SPEED_PAUSE   1000
+
+// skip serial output (for time measurements)
+//#define SKIP_CONSOLE
+
+
+// shortcuts for generated frames
+namespace Cmd    = LDF_Example::MotorCmd;
+namespace Status = LDF_Example::MotorStatus;
+
+
+// setup LIN node and schedule
+LIN_Master_HardwareSerial   LIN(Serial3, "LIN_HW");             // parameter: HW-interface, name
+LIN_Master_Schedule         LIN_Schedule(LIN);                  // parameter: LIN node
+
+
+// called when frame of a slot is finished, state and error are reset afterwards
+void frameFinished(LIN_Master &Node, uint8_t Slot)
+{
+  LIN_Master::view_t    view;
+
+  (void) Slot;
+
+  // only handle error-free motor status frames
+  if ((!Node.getFrameView(view)) || (view.id != Status::id))
+    return;
+
+  // store frame and check for changes. Skip decoding if frame is unchanged
+  if (!Status::frame.update(view))
+    return;
+
+  // print changed signals only
+  #if !defined(SKIP_CONSOLE)
+    if (Status::frame.isChanged<Status::MotorState>())
+    {
+      Serial.print("state: ");
+      Serial.println(Status::frame.get<Status::MotorState>());
+    }
+    if (Status::frame.isChanged<Status::MotorTemp>())
+    {
+      Serial.print("temperature: ");
+      Serial.println(Status::frame.get<Status::MotorTemp>());
+    }
+    if (Status::frame.isChanged<Status::MotorCurrent>())
+    {
+      Serial.print("current: ");
+      Serial.println(Status::frame.get<Status::MotorCurrent>());
+    }
+  #endif // SKIP_CONSOLE
+
+} // frameFinished()
+
+
+// call once
+void setup()
+{
+  // for user interaction via console
+  Serial.begin(115200);
+  while(!Serial);
+
+  // open LIN interface with LDF baudrate
+  LIN.begin(LDF_Example::baudrate);
+
+  // initial motor command
+  Cmd::frame.set<Cmd::MotorOn>(1);
+  Cmd::frame.set<Cmd::MotorDir>(0);
+  Cmd::frame.set<Cmd::MotorSpeed>(500);
+
+  // start generated schedule
+  LIN_Schedule.attachCallback(frameFinished);
+  LIN_Schedule.setTable(LDF_Example::Normal, LDF_Example::Normal_numSlots);
+  LIN_Schedule.start();
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t   lastChange = 0;
+
+  // call LIN schedule handler (also calls LIN.handler())
+  LIN_Schedule.handler();
+
+  // change motor speed. Is sent with next MotorCmd slot
+  if (millis() - lastChange > SPEED_PAUSE)
+  {
+    lastChange = millis();
+    Cmd::frame.set<Cmd::MotorSpeed>((Cmd::frame.get<Cmd::MotorSpeed>() + 100) & Cmd::MotorSpeed::mask);
+  }
+
+} // loop()
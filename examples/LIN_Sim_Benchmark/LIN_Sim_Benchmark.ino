@@ -0,0 +1,151 @@
+/*********************
+
+Benchmark and self-check of LIN master node over a simulated bus
+
+This code runs the LIN master frame engine and schedule over a virtual bus without LIN hardware. First the CPU
+overhead of the library is measured with instant bus timing and printed as CSV lines with prefix "BENCH". Then
+a schedule with emulated slaves is executed with pseudo-random fault injection, and the detected frame errors
+are compared with the injected faults. Results are reproducible, e.g. for comparing library changes.
+
+Note: as no hardware is used, the sketch runs on any board
+
+Supported boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - Arduino Due            https://store.arduino.cc/products/arduino-due
+ - ESP32 Wroom-32U        https://www.etechnophiles.com/esp32-dev-board-pinout-specifications-datasheet-and-schematic/
+
+**********************/
+
+// include files
+#include "LIN_master_Sim.h"
+#include "LIN_master_Schedule.h"
+#include "LIN_master_Benchmark.h"
+
+
+// measurement duration per frame type [ms]
+#define BENCH_DURATION    2000
+
+// number of frames with fault injection
+#define NUM_FRAMES        100000L
+
+// probability of each fault per frame [1/65536], i.e. ~1%
+#define FAULT_RATE        655
+
+
+// data of master request frame
+uint8_t  Tx[2] = {0x12, 0x34};
+
+// schedule table. Parameter: type, version, ID, number of data, data, slot time [us] (0 = back-to-back)
+const LIN_Master_Schedule::slot_t   Table[] = {
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 8, NULL, 0 },
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V1, 0x11, 4, NULL, 0 },
+  { LIN_Master::MASTER_REQUEST, LIN_Master::LIN_V2, 0x20, 2, Tx,   0 }
+};
+
+
+// setup LIN node over virtual bus, schedule and benchmark
+LIN_Master_Sim        LIN("LIN_Sim");                              // parameter: name
+LIN_Master_Schedule   LIN_Schedule(LIN);                           // parameter: LIN node
+LIN_Master_Benchmark  Bench(LIN);                                  // parameter: LIN node
+
+// frame table of emulated slaves, indexed by frame ID
+LIN_Master_Responder::entry_t   Slaves[64];
+
+// frame and error counters of fault injection run
+uint32_t  numFrames = 0;
+uint32_t  numErrors = 0;
+uint32_t  numEcho = 0, numChk = 0, numTimeout = 0;
+
+
+// called when frame of a slot is finished
+void frameFinished(LIN_Master &Node, uint8_t Slot)
+{
+  LIN_Master::error_t   error = Node.getError();
+
+  (void) Slot;
+
+  // count frames and errors
+  numFrames++;
+  if (error == LIN_Master::NO_ERROR)
+    return;
+  numErrors++;
+  if (error & LIN_Master::ERROR_ECHO)
+    numEcho++;
+  if (error & LIN_Master::ERROR_CHK)
+    numChk++;
+  if (error & LIN_Master::ERROR_TIMEOUT)
+    numTimeout++;
+
+} // frameFinished()
+
+
+// call once
+void setup()
+{
+  LIN_Master_Benchmark::result_t    result;
+  uint8_t                           Data[8] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+  uint32_t                          timeStart;
+
+  // for output (only) to console
+  Serial.begin(115200);
+  while(!Serial);
+
+  // setup emulated slaves, incl. one with classic checksum
+  memset(Slaves, 0, sizeof(Slaves));
+  LIN.attachTable(Slaves);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 8, Data);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V1, 0x11, 4, Data);
+  LIN.setFrame(LIN_Master::MASTER_REQUEST, LIN_Master::LIN_V2, 0x20, 2);
+
+  // measure CPU overhead with instant bus timing
+  LIN_Master_Benchmark::printHeader(Serial);
+  Bench.setFrame(LIN_Master::MASTER_REQUEST, 0x20, 2);
+  Bench.run(19200, BENCH_DURATION, result);
+  LIN_Master_Benchmark::printResult(Serial, "Sim_Request", result);
+  Bench.setFrame(LIN_Master::SLAVE_RESPONSE, 0x10, 8);
+  Bench.run(19200, BENCH_DURATION, result);
+  LIN_Master_Benchmark::printResult(Serial, "Sim_Response", result);
+
+  // run schedule with fault injection. Same seed gives same faults
+  LIN.setFaults(LIN_Master_Sim::FAULT_ECHO | LIN_Master_Sim::FAULT_CHK | LIN_Master_Sim::FAULT_TIMEOUT | LIN_Master_Sim::FAULT_SHORT, FAULT_RATE, 12345);
+  LIN_Schedule.attachCallback(frameFinished);
+  LIN_Schedule.setTable(Table, sizeof(Table)/sizeof(LIN_Master_Schedule::slot_t));
+  timeStart = millis();
+  LIN_Schedule.start();
+  while (numFrames < NUM_FRAMES)
+    LIN_Schedule.handler();
+  LIN_Schedule.stop();
+
+  // print result. Each injected fault must be detected as frame error
+  Serial.print("frames: ");
+  Serial.print(numFrames);
+  Serial.print(", time [ms]: ");
+  Serial.println(millis() - timeStart);
+  Serial.print("injected faults: ");
+  Serial.print(LIN.getNumFaults());
+  Serial.print(", detected errors: ");
+  Serial.print(numErrors);
+  Serial.print(" (echo ");
+  Serial.print(numEcho);
+  Serial.print(", checksum ");
+  Serial.print(numChk);
+  Serial.print(", timeout ");
+  Serial.print(numTimeout);
+  Serial.println(")");
+  Serial.print("slave frames: 0x10=");
+  Serial.print((int) Slaves[0x10].count);
+  Serial.print(", 0x11=");
+  Serial.print((int) Slaves[0x11].count);
+  Serial.print(", 0x20=");
+  Serial.println((int) Slaves[0x20].count);
+  Serial.println((numErrors == LIN.getNumFaults()) ? "result: ok" : "result: MISMATCH");
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  // nothing to do
+
+} // loop()
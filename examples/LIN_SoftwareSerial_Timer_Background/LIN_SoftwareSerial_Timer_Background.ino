@@ -0,0 +1,158 @@
+/*********************
+
+Example code for LIN master node with background operation using a timer driven software UART
+
+This code runs a LIN master node in "background" operation using a software UART, which is clocked by a timer ISR.
+In contrast to SoftwareSerial, the main loop is not blocked during a frame
+
+Note: uses Timer1 on ATtinyX5 and Timer2 on ATmega, i.e. tone() is not available
+
+Supported boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - Adafruit Trinket       https://www.adafruit.com/product/1501
+
+**********************/
+
+// include files
+#include "LIN_master_SoftwareSerial_Timer.h"
+
+
+// board pin definitions
+#if defined(ARDUINO_AVR_MEGA2560)
+  #define PIN_TOGGLE    30        // pin to demonstrate background operation
+  #define PIN_ERROR     32        // indicate LIN return status
+  #define PIN_LIN_RX    10        // receive pin for LIN
+  #define PIN_LIN_TX    14        // transmit pin for LIN
+#elif defined(ARDUINO_AVR_TRINKET3)
+  #define PIN_TOGGLE    1
+  #define PIN_ERROR     3
+  #define PIN_LIN_RX    0
+  #define PIN_LIN_TX    2
+  #define SKIP_CONSOLE            // Trinket has no Serial
+#else
+  #error adapt parameters to board   
+#endif
+
+// pause between LIN frames
+#define LIN_PAUSE     100
+
+// skip serial output (for time measurements)
+//#define SKIP_CONSOLE
+
+
+// setup LIN node
+LIN_Master_SoftwareSerial_Timer   LIN(PIN_LIN_RX, PIN_LIN_TX, "LIN_Timer");    // parameter: Rx, Tx, name
+
+
+// call once
+void setup()
+{
+  // indicate background operation
+  pinMode(PIN_TOGGLE, OUTPUT);
+
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // open LIN interface
+  LIN.begin(19200);  
+
+  // for output (only) to console
+  #if !defined(SKIP_CONSOLE)
+    Serial.begin(115200);
+    while(!Serial);
+  #endif
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t       lastLINFrame = 0;
+  static uint8_t        count = 0;
+  uint8_t               Tx[4] = {0x01, 0x02, 0x03, 0x04};
+  LIN_Master::frame_t   Type;
+  uint8_t               Id;
+  uint8_t               NumData;
+  uint8_t               Data[8];
+  LIN_Master::error_t   error;
+  
+
+  ///////////////
+  // as fast as possible
+  ///////////////
+  
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // call LIN background handler
+  LIN.handler();
+
+
+  ///////////////
+  // check if LIN frame has finished
+  ///////////////
+  if (LIN.getState() == LIN_Master::STATE_DONE)
+  {
+    // get frame data
+    LIN.getFrame(Type, Id, NumData, Data);
+
+    // indicate status via pin
+    digitalWrite(PIN_ERROR, LIN.getError());
+
+    // print result
+    #if !defined(SKIP_CONSOLE)
+      Serial.print(millis());
+      Serial.print("\t");
+      Serial.print(LIN.nameLIN);
+      if (Type == LIN_Master::MASTER_REQUEST)
+      {
+        Serial.print(" request background: 0x");
+        Serial.println(LIN.getError(), HEX);
+      }
+      else
+      {
+        Serial.print(" reponse background: 0x");
+        Serial.println(LIN.getError(), HEX);
+        for (uint8_t i=0; (i < NumData) && (LIN.getError() == LIN_Master::NO_ERROR); i++)
+        {
+          Serial.print("\t");        
+          Serial.print((int) i);
+          Serial.print("\t0x");
+          Serial.println((int) Data[i], HEX);
+        }
+      }
+    #endif // SKIP_CONSOLE
+
+    // reset state machine & error
+    LIN.resetStateMachine();
+    LIN.resetError();
+
+  } // if LIN frame finished
+
+
+  ///////////////
+  // SW scheduler for sending/receiving LIN frames
+  ///////////////
+  if (millis() - lastLINFrame > LIN_PAUSE)
+  {
+    lastLINFrame = millis();
+
+    // send master request frame (background)
+    if (count == 0)
+    {
+      count++;
+      LIN.sendMasterRequest(LIN_Master::LIN_V2, 0x1B, 3, Tx);
+    }
+
+
+    // send slave response frame (background)
+    else
+    {
+      count = 0;
+      LIN.receiveSlaveResponse(LIN_Master::LIN_V2, 0x05, 8);
+    }
+    
+  } // SW scheduler
+
+} // loop()
@@ -0,0 +1,119 @@
+/*********************
+
+Example code for compile-time configured LIN master node using HardwareSerial
+
+This code runs a LIN master node on Serial3 via LIN_Master_Static_HardwareSerial, which has no virtual functions.
+Max. frame length, statistics and job queue are selected via template parameters, i.e. unused features cost
+neither flash nor RAM. A master request and a slave response are queued periodically and sent back-to-back.
+Results are printed from the frame callback.
+
+Note: LIN.handler() must be called as often as possible
+
+Supported (=successfully tested) boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+
+**********************/
+
+// include files
+#include "LIN_master_Static.h"
+
+
+// indicate LIN return status
+#define PIN_ERROR     32
+
+// pause between LIN frames
+#define LIN_PAUSE     100
+
+// skip serial output (for time measurements)
+//#define SKIP_CONSOLE
+
+
+// setup LIN node. Parameter: max. 4 data bytes, statistics enabled, job queue with 4 entries
+typedef LIN_Master_Static_HardwareSerial<4, LIN_FEATURE_STATS, 4>   LIN_Node;
+LIN_Node    LIN(Serial3);                                           // parameter: HW-interface
+
+
+// called when frame is finished
+void frameDone(LIN_Node &Node)
+{
+  LIN_Master::frame_t   Type;
+  uint8_t               Id;
+  uint8_t               NumData;
+  uint8_t               Data[4];
+
+  // indicate status via pin
+  digitalWrite(PIN_ERROR, Node.getError());
+
+  // get frame data
+  Node.getFrame(Type, Id, NumData, Data);
+
+  // print result
+  #if !defined(SKIP_CONSOLE)
+    Serial.print(millis());
+    Serial.print("\tID 0x");
+    Serial.print((int) Id, HEX);
+    Serial.print(": error 0x");
+    Serial.print(Node.getError(), HEX);
+    for (uint8_t i=0; (i < NumData) && (Node.getError() == LIN_Master::NO_ERROR); i++)
+    {
+      Serial.print(" 0x");
+      Serial.print((int) Data[i], HEX);
+    }
+    Serial.println();
+  #endif // SKIP_CONSOLE
+
+} // frameDone()
+
+
+// call once
+void setup()
+{
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // open LIN interface
+  LIN.begin(19200);
+  LIN.attachCallback(frameDone);
+
+  // for user interaction via console
+  Serial.begin(115200);
+  while(!Serial);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t       lastFrame = 0;
+  static uint32_t       lastPrint = 0;
+  uint8_t               Tx[4] = {0x01, 0x02, 0x03, 0x04};
+  LIN_Master::stats_t   Stats;
+
+  // handle LIN background operation. Starts queued frames back-to-back
+  LIN.handler();
+
+  // periodically queue a master request and a slave response
+  if ((millis() - lastFrame > LIN_PAUSE) && (LIN.freeJobs() >= 2))
+  {
+    lastFrame = millis();
+    LIN.sendMasterRequest(LIN_Master::LIN_V2, 0x1A, 4, Tx);
+    LIN.receiveSlaveResponse(LIN_Master::LIN_V2, 0x05, 4);
+  }
+
+  // print statistics
+  if (millis() - lastPrint > 5000)
+  {
+    lastPrint = millis();
+    LIN.getStats(Stats);
+    #if !defined(SKIP_CONSOLE)
+      Serial.print("frames ");
+      Serial.print(Stats.numFrames);
+      Serial.print(", errors ");
+      Serial.print(Stats.numErrors);
+      Serial.print(", max. handler() [us] ");
+      Serial.println(Stats.timeHandlerMax);
+    #endif // SKIP_CONSOLE
+  }
+
+} // loop()
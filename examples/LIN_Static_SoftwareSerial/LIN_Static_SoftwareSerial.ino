@@ -0,0 +1,75 @@
+/*********************
+
+Example code for compile-time configured LIN master node using SoftwareSerial
+
+This code runs a LIN master node on a device without hardware UART, e.g. ATtiny85, via LIN_Master_Static_SoftwareSerial.
+BREAK is sent via GPIO and reception is disabled while sending, i.e. a LIN transceiver is required. A master request
+and a slave response are queued periodically and sent back-to-back. The frame status is indicated via pin.
+
+Note: LIN.handler() must be called as often as possible
+
+Supported boards:
+ - ATtiny85, e.g. Adafruit Trinket       https://www.adafruit.com/product/1501
+ - Arduino Uno                           https://store.arduino.cc/products/arduino-uno-rev3
+
+**********************/
+
+// include files
+#include "LIN_master_Static.h"
+
+
+// pins for LIN transceiver and status indication
+#define PIN_RX        3
+#define PIN_TX        4
+#define PIN_ERROR     1
+
+// pause between LIN frames
+#define LIN_PAUSE     100
+
+
+// setup LIN node. Parameter: max. 4 data bytes, no features, job queue with 3 entries
+typedef LIN_Master_Static_SoftwareSerial<4, 0, 3>   LIN_Node;
+SoftwareSerial  Interface(PIN_RX, PIN_TX);                          // parameter: Rx, Tx
+LIN_Node        LIN(Interface, PIN_TX);                             // parameter: SW-interface, Tx pin for BREAK
+
+
+// called when frame is finished
+void frameDone(LIN_Node &Node)
+{
+  // indicate status via pin
+  digitalWrite(PIN_ERROR, Node.getError());
+
+} // frameDone()
+
+
+// call once
+void setup()
+{
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // open LIN interface
+  LIN.begin(19200);
+  LIN.attachCallback(frameDone);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t   lastFrame = 0;
+  uint8_t           Tx[4] = {0x01, 0x02, 0x03, 0x04};
+
+  // handle LIN background operation. Starts queued frames back-to-back
+  LIN.handler();
+
+  // periodically queue a master request and a slave response
+  if ((millis() - lastFrame > LIN_PAUSE) && (LIN.freeJobs() >= 2))
+  {
+    lastFrame = millis();
+    LIN.sendMasterRequest(LIN_Master::LIN_V2, 0x1A, 4, Tx);
+    LIN.receiveSlaveResponse(LIN_Master::LIN_V2, 0x05, 4);
+  }
+
+} // loop()
@@ -0,0 +1,94 @@
+/*********************
+
+Example code for LIN diagnostic requests via transport layer (LIN TP) using HardwareSerial
+
+This code periodically sends a diagnostic request (UDS ReadDataByIdentifier) to a LIN slave in "background"
+operation. Request and response are segmented into single/first/consecutive frames via IDs 0x3C/0x3D and
+the response is reassembled in the request buffer
+
+Note: LIN_TP.handler() must be called as often as possible. It also calls LIN.handler()
+
+Supported (=successfully tested) boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - Arduino Due            https://store.arduino.cc/products/arduino-due
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+#include "LIN_master_TP.h"
+
+
+// node address of diagnostic slave
+#define SLAVE_NAD     0x01
+
+// pause between diagnostic requests
+#define TP_PAUSE      1000
+
+// skip serial output (for time measurements)
+//#define SKIP_CONSOLE
+
+
+// message buffer for request and response
+uint8_t   Buffer[64];
+
+// setup LIN node and transport layer
+LIN_Master_HardwareSerial   LIN(Serial3, "LIN_HW");             // parameter: HW-interface, name
+LIN_Master_TP               LIN_TP(LIN, Buffer, sizeof(Buffer)); // parameter: LIN node, message buffer, buffer size
+
+
+// call once
+void setup()
+{
+  // for user interaction via console
+  Serial.begin(115200);
+  while(!Serial);
+
+  // open LIN interface
+  LIN.begin(19200);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t   lastRequest = 0;
+  const uint8_t     Request[3] = {0x22, 0xF1, 0x8C};            // ReadDataByIdentifier: ECU serial number
+
+  // handle transport layer (also calls LIN.handler())
+  LIN_TP.handler();
+
+  // request finished -> print response
+  if (LIN_TP.getState() == LIN_Master_TP::STATE_DONE)
+  {
+    #if !defined(SKIP_CONSOLE)
+      Serial.print(millis());
+      Serial.print("\tNAD 0x");
+      Serial.print(SLAVE_NAD, HEX);
+      Serial.print(": error 0x");
+      Serial.print(LIN_TP.getError(), HEX);
+      if (LIN_TP.getError() == LIN_Master_TP::NO_ERROR)
+      {
+        Serial.print(", response");
+        for (uint16_t i=0; i < LIN_TP.getLength(); i++)
+        {
+          Serial.print(" 0x");
+          Serial.print((int) Buffer[i], HEX);
+        }
+      }
+      Serial.println();
+    #endif // SKIP_CONSOLE
+
+    // release transport layer
+    LIN_TP.reset();
+  }
+
+  // start next request
+  if ((millis() - lastRequest > TP_PAUSE) && (LIN_TP.getState() == LIN_Master_TP::STATE_IDLE))
+  {
+    lastRequest = millis();
+    LIN_TP.request(SLAVE_NAD, Request, sizeof(Request));
+  }
+
+} // loop()
@@ -0,0 +1,136 @@
+/*********************
+
+Example code for LIN master node running in its own FreeRTOS task using ESP32 UART driver
+
+This code runs a LIN master node in a FreeRTOS task pinned to core 0. The task blocks on the UART event queue
+during a frame and on its job queue while idle, i.e. no polling and no 1ms Ticker granularity. Frames are
+posted to the task and results are read from a FreeRTOS queue, so loop() on core 1 is free of LIN handling
+
+Note: the UART is used directly, i.e. Serial2 must not be used
+
+Supported (=successfully tested) boards:
+ - ESP32 Wroom-32U        https://www.etechnophiles.com/esp32-dev-board-pinout-specifications-datasheet-and-schematic/
+
+**********************/
+
+// include files
+#include "LIN_master_UART_ESP32.h"
+
+
+// board pin definitions (GPIOn is referred to as n)
+#define PIN_TOGGLE    19        // pin to demonstrate background operation
+#define PIN_ERROR     23        // indicate LIN return status
+#define PIN_LIN_RX    16        // receive pin for LIN
+#define PIN_LIN_TX    17        // transmit pin for LIN
+
+// core for LIN task (Arduino loop() runs on core 1)
+#define LIN_CORE      0
+
+// pause between LIN frames
+#define LIN_PAUSE     100
+
+// skip serial output (for time measurements)
+//#define SKIP_CONSOLE
+
+
+// setup LIN node
+LIN_Master_UART_ESP32   LIN(UART_NUM_2, PIN_LIN_RX, PIN_LIN_TX, "LIN_Task");    // parameter: UART port, Rx, Tx, name
+
+
+// call once
+void setup()
+{
+  // indicate background operation
+  pinMode(PIN_TOGGLE, OUTPUT);
+
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // for output (only) to console
+  Serial.begin(115200);
+  while(!Serial);
+
+  // open LIN interface and start LIN task with 4 jobs and 8 results
+  LIN.begin(19200);
+  if (!LIN.startTask(LIN_CORE, 4, 8))
+    Serial.println("error starting LIN task");
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t       lastLINFrame = 0;
+  static uint8_t        count = 0;
+  uint8_t               Tx[4] = {0x01, 0x02, 0x03, 0x04};
+  LIN_Master::result_t  result;
+
+
+  ///////////////
+  // as fast as possible
+  ///////////////
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+
+  ///////////////
+  // read finished frames from LIN task (don't block)
+  ///////////////
+  while (LIN.waitResult(result, 0))
+  {
+    // indicate status via pin
+    digitalWrite(PIN_ERROR, result.error);
+
+    // print result
+    #if !defined(SKIP_CONSOLE)
+      Serial.print(result.timestamp);
+      Serial.print("us\t");
+      Serial.print(LIN.nameLIN);
+      if (result.type == LIN_Master::MASTER_REQUEST)
+      {
+        Serial.print(" request task: 0x");
+        Serial.println(result.error, HEX);
+      }
+      else
+      {
+        Serial.print(" reponse task: 0x");
+        Serial.println(result.error, HEX);
+        for (uint8_t i=0; (i < result.numData) && (result.error == LIN_Master::NO_ERROR); i++)
+        {
+          Serial.print("\t");
+          Serial.print((int) i);
+          Serial.print("\t0x");
+          Serial.println((int) result.data[i], HEX);
+        }
+      }
+    #endif // SKIP_CONSOLE
+
+  } // while results
+
+
+  ///////////////
+  // SW scheduler for posting LIN frames to LIN task
+  ///////////////
+  if (millis() - lastLINFrame > LIN_PAUSE)
+  {
+    lastLINFrame = millis();
+
+    // post master request frame
+    if (count == 0)
+    {
+      count++;
+      LIN.postMasterRequest(LIN_Master::LIN_V2, 0x1B, 3, Tx);
+    }
+
+    // post slave response frame
+    else
+    {
+      count = 0;
+      LIN.postSlaveResponse(LIN_Master::LIN_V2, 0x05, 8);
+    }
+
+  } // SW scheduler
+
+} // loop()
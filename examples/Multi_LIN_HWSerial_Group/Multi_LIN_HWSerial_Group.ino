@@ -0,0 +1,147 @@
+/*********************
+
+Example code for multiple LIN master nodes serviced by one handler using HardwareSerial
+
+This code runs 3 LIN master nodes in "background" operation using HardwareSerial interfaces. All buses
+are serviced from a single LIN_Group.handler() call, which only calls buses with pending work. Buses 1 and 2
+execute schedule tables started with a time offset, bus 3 sends individual frames via the group
+
+Note: LIN_Group.handler() must be called as often as possible. It also calls the schedule and LIN handlers
+
+Supported (=successfully tested) boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - Arduino Due            https://store.arduino.cc/products/arduino-due
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+#include "LIN_master_Schedule.h"
+#include "LIN_master_Group.h"
+
+
+// pin to demonstrate background operation
+#define PIN_TOGGLE    30
+
+// pause between frames on bus 3
+#define LIN_PAUSE     200
+
+// time offset [us] between schedules of consecutive buses
+#define STAGGER       2500
+
+// skip serial output (for time measurements)
+//#define SKIP_CONSOLE
+
+
+// data of master request frames
+uint8_t  Tx1[4] = {0x01, 0x02, 0x03, 0x04};
+uint8_t  Tx3[2] = {0xAA, 0x55};
+
+// schedule table for buses 1 and 2. Parameter: type, version, ID, number of data, data, slot time [us]
+const LIN_Master_Schedule::slot_t   Table[] = {
+  { LIN_Master::MASTER_REQUEST, LIN_Master::LIN_V2, 0x1B, 4, Tx1,  10000 },
+  { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x05, 8, NULL, 10000 }
+};
+
+
+// setup LIN nodes, schedules and group
+LIN_Master_HardwareSerial   LIN1(Serial1, "LIN1");              // parameter: HW-interface, name
+LIN_Master_HardwareSerial   LIN2(Serial2, "LIN2");              // parameter: HW-interface, name
+LIN_Master_HardwareSerial   LIN3(Serial3, "LIN3");              // parameter: HW-interface, name
+LIN_Master_Schedule         LIN1_Schedule(LIN1);                // parameter: LIN node
+LIN_Master_Schedule         LIN2_Schedule(LIN2);                // parameter: LIN node
+LIN_Master_Group            LIN_Group;
+
+
+// print frame result
+void printFrame(LIN_Master &Node)
+{
+  #if !defined(SKIP_CONSOLE)
+    LIN_Master::frame_t   Type;
+    uint8_t               Id;
+    uint8_t               NumData;
+    uint8_t               Data[8];
+
+    Node.getFrame(Type, Id, NumData, Data);
+    Serial.print(micros());
+    Serial.print("\t");
+    Serial.print(Node.nameLIN);
+    Serial.print(", ID 0x");
+    Serial.print((int) Id, HEX);
+    Serial.print(": 0x");
+    Serial.println(Node.getError(), HEX);
+  #else
+    (void) Node;
+  #endif // SKIP_CONSOLE
+
+} // printFrame()
+
+
+// called when frame of a schedule slot is finished, state and error are reset afterwards
+void slotFinished(LIN_Master &Node, uint8_t Slot)
+{
+  (void) Slot;
+  printFrame(Node);
+
+} // slotFinished()
+
+
+// called when frame on bus without schedule is finished, state and error are reset afterwards
+void frameFinished(LIN_Master &Node, uint8_t Bus)
+{
+  (void) Bus;
+  printFrame(Node);
+
+} // frameFinished()
+
+
+// call once
+void setup()
+{
+  // indicate background operation
+  pinMode(PIN_TOGGLE, OUTPUT);
+
+  // for user interaction via console
+  Serial.begin(115200);
+  while(!Serial);
+
+  // open LIN interfaces
+  LIN1.begin(19200);
+  LIN2.begin(19200);
+  LIN3.begin(9600);
+
+  // setup schedules
+  LIN1_Schedule.attachCallback(slotFinished);
+  LIN1_Schedule.setTable(Table, sizeof(Table)/sizeof(LIN_Master_Schedule::slot_t));
+  LIN2_Schedule.attachCallback(slotFinished);
+  LIN2_Schedule.setTable(Table, sizeof(Table)/sizeof(LIN_Master_Schedule::slot_t));
+
+  // add buses to group and start schedules with offset
+  LIN_Group.add(LIN1, &LIN1_Schedule);
+  LIN_Group.add(LIN2, &LIN2_Schedule);
+  LIN_Group.add(LIN3);
+  LIN_Group.attachCallback(frameFinished);
+  LIN_Group.startSchedules(STAGGER);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t   lastLINFrame = 0;
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // start frame on bus 3 (index 2) if idle
+  if ((millis() - lastLINFrame > LIN_PAUSE) && (LIN3.getState() == LIN_Master::STATE_IDLE))
+  {
+    lastLINFrame = millis();
+    LIN_Group.sendMasterRequest(2, LIN_Master::LIN_V2, 0x1A, 2, Tx3);
+  }
+
+  // service all buses with pending work
+  LIN_Group.handler();
+
+} // loop()
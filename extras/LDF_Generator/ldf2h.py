@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+"""
+  \file     ldf2h.py
+  \brief    Generate LIN_Master signal descriptors and schedule tables from a LIN Description File
+  \details  Reads the Signals, Frames and Schedule_tables sections of an LDF and writes a C++ header with
+            constexpr frame properties, LIN_Master_Signal descriptors, LIN_Master_SignalFrame buffers and
+            LIN_Master_Schedule::slot_t tables, see src/LIN_master_Signal.h.
+            Diagnostic and command entries of schedule tables (e.g. MasterReq, AssignNAD) are skipped.
+
+            Usage: python3 ldf2h.py input.ldf [output.h] [--master NAME]
+  \author   Georg Icking-Konert
+"""
+
+import re
+import sys
+import os
+
+
+def strip_comments(text):
+    """remove C and C++ style comments"""
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+    return re.sub(r'//[^\n]*', '', text)
+
+
+def get_block(text, keyword):
+    """return content of top-level block 'keyword { ... }', or None"""
+    match = re.search(r'\b' + keyword + r'\s*\{', text)
+    if match is None:
+        return None
+    depth = 1
+    pos = match.end()
+    while depth > 0 and pos < len(text):
+        if text[pos] == '{':
+            depth += 1
+        elif text[pos] == '}':
+            depth -= 1
+        pos += 1
+    return text[match.end():pos-1]
+
+
+def get_entries(block):
+    """split a block into (header, body) tuples of 'header { body }' entries"""
+    entries = []
+    pos = 0
+    while True:
+        start = block.find('{', pos)
+        if start < 0:
+            break
+        depth = 1
+        end = start + 1
+        while depth > 0:
+            if block[end] == '{':
+                depth += 1
+            elif block[end] == '}':
+                depth -= 1
+            end += 1
+        entries.append((block[pos:start].strip(), block[start+1:end-1]))
+        pos = end
+    return entries
+
+
+def identifier(name):
+    """convert name to valid C++ identifier"""
+    name = re.sub(r'\W', '_', name)
+    return ('_' + name) if name[0].isdigit() else name
+
+
+def parse_ldf(text):
+    """parse LDF text and return dict with version, baudrate, master, signals, frames, schedules"""
+    text = strip_comments(text)
+    ldf = {'version': 'LIN_V2', 'baudrate': 19200, 'master': None, 'signals': {}, 'frames': [], 'schedules': []}
+
+    # protocol version and speed
+    match = re.search(r'LIN_protocol_version\s*=\s*"(\d+)', text)
+    if match and int(match.group(1)) < 2:
+        ldf['version'] = 'LIN_V1'
+    match = re.search(r'LIN_speed\s*=\s*([\d.]+)\s*kbps', text)
+    if match:
+        ldf['baudrate'] = int(round(float(match.group(1)) * 1000))
+
+    # master node
+    nodes = get_block(text, 'Nodes')
+    if nodes:
+        match = re.search(r'Master\s*:\s*(\w+)', nodes)
+        if match:
+            ldf['master'] = match.group(1)
+
+    # signals. Format: name : size, init, publisher, subscriber, ... ;
+    signals = get_block(text, 'Signals') or ''
+    for match in re.finditer(r'(\w+)\s*:\s*(\d+)\s*,\s*(\{[^}]*\}|[\w.]+)\s*,\s*(\w+)([^;]*);', signals):
+        ldf['signals'][match.group(1)] = {'size': int(match.group(2)), 'publisher': match.group(4)}
+
+    # unconditional frames. Format: name : id, publisher, length { signal, offset ; ... }
+    frames = get_block(text, 'Frames') or ''
+    for header, body in get_entries(frames):
+        match = re.match(r'(\w+)\s*:\s*(\w+)\s*,\s*(\w+)\s*,\s*(\d+)', header)
+        if match is None:
+            continue
+        frame = {'name': match.group(1), 'id': int(match.group(2), 0) & 0x3F, 'publisher': match.group(3),
+                 'length': int(match.group(4)), 'signals': []}
+        for sig in re.finditer(r'(\w+)\s*,\s*(\d+)\s*;', body):
+            frame['signals'].append((sig.group(1), int(sig.group(2))))
+        ldf['frames'].append(frame)
+
+    # schedule tables. Format: table { frame delay x ms ; ... }
+    tables = get_block(text, 'Schedule_tables') or ''
+    for name, body in get_entries(tables):
+        slots = []
+        for slot in re.finditer(r'(\w+)\s*(?:\{[^}]*\})?\s*delay\s*([\d.]+)\s*ms\s*;', body):
+            slots.append((slot.group(1), int(round(float(slot.group(2)) * 1000))))
+        ldf['schedules'].append({'name': name, 'slots': slots})
+
+    return ldf
+
+
+def generate(ldf, namespace, source):
+    """generate C++ header text from parsed LDF"""
+    out = []
+    guard = '_' + namespace.upper() + '_H_'
+    frames = {f['name']: f for f in ldf['frames']}
+
+    out.append('/**')
+    out.append('  \\file     ' + namespace + '.h')
+    out.append('  \\brief    LIN signal descriptors and schedule tables generated from ' + os.path.basename(source))
+    out.append('  \\details  Generated by extras/LDF_Generator/ldf2h.py. Do not edit!')
+    out.append('            Frame buffers and tables have internal linkage, i.e. include this file in one source file only.')
+    out.append('*/')
+    out.append('')
+    out.append('#ifndef ' + guard)
+    out.append('#define ' + guard)
+    out.append('')
+    out.append('#include "LIN_master_Signal.h"')
+    out.append('#include "LIN_master_Schedule.h"')
+    out.append('')
+    out.append('namespace ' + namespace)
+    out.append('{')
+    out.append('  constexpr LIN_Master::version_t  version  = LIN_Master::' + ldf['version'] + ';    //!< LIN protocol version')
+    out.append('  constexpr uint16_t               baudrate = %d;    //!< LIN_speed [Baud]' % ldf['baudrate'])
+
+    # frames with signals and frame buffer
+    for frame in ldf['frames']:
+        request = (frame['publisher'] == ldf['master'])
+        out.append('')
+        out.append('  /// frame %s (%s)' % (frame['name'], 'master request' if request else 'slave response'))
+        out.append('  namespace ' + identifier(frame['name']))
+        out.append('  {')
+        out.append('    constexpr LIN_Master::frame_t  type    = LIN_Master::%s;' % ('MASTER_REQUEST' if request else 'SLAVE_RESPONSE'))
+        out.append('    constexpr uint8_t              id      = 0x%02X;' % frame['id'])
+        out.append('    constexpr uint8_t              numData = %d;' % frame['length'])
+        for name, offset in frame['signals']:
+            size = ldf['signals'].get(name, {'size': 8})['size']
+            if size <= 16:
+                out.append('    typedef LIN_Master_Signal<%d, %d>  %s;    //!< signal %s, %d bit @ bit %d' % (offset, size, identifier(name), name, size, offset))
+            elif (offset % 8 == 0) and (size % 8 == 0):
+                out.append('    typedef LIN_Master_SignalArray<%d, %d>  %s;    //!< array signal %s, %d byte @ byte %d' % (offset//8, size//8, identifier(name), name, size//8, offset//8))
+            else:
+                sys.stderr.write('warning: signal %s is neither scalar nor byte aligned array, skipped\n' % name)
+        out.append('    static LIN_Master_SignalFrame<numData>  frame;    //!< frame data with change tracking')
+        out.append('  }')
+
+    # schedule tables
+    for table in ldf['schedules']:
+        out.append('')
+        out.append('  /// schedule table %s' % table['name'])
+        out.append('  static const LIN_Master_Schedule::slot_t  %s[] = {' % identifier(table['name']))
+        for name, delay in table['slots']:
+            if name not in frames:
+                out.append('    // %s skipped (no unconditional frame)' % name)
+                continue
+            ns = identifier(name)
+            data = ns + '::frame.data' if frames[name]['publisher'] == ldf['master'] else 'NULL'
+            out.append('    { %s::type, version, %s::id, %s::numData, %s, %d, NULL, 0, 0, LIN_Master_Schedule::RETRY_IMMEDIATE, 0 },' % (ns, ns, ns, data, delay))
+        out.append('  };')
+        out.append('  constexpr uint8_t  %s_numSlots = sizeof(%s) / sizeof(LIN_Master_Schedule::slot_t);' % (identifier(table['name']), identifier(table['name'])))
+
+    out.append('')
+    out.append('} // namespace ' + namespace)
+    out.append('')
+    out.append('#endif // ' + guard)
+    out.append('')
+    return '\n'.join(out)
+
+
+def main(argv):
+    args = []
+    master = None
+    i = 1
+    while i < len(argv):
+        if argv[i] == '--master' and i+1 < len(argv):
+            master = argv[i+1]
+            i += 1
+        else:
+            args.append(argv[i])
+        i += 1
+    if len(args) < 1:
+        sys.stderr.write(__doc__)
+        return 1
+    source = args[0]
+    target = args[1] if len(args) > 1 else os.path.splitext(os.path.basename(source))[0] + '.h'
+    namespace = identifier(os.path.splitext(os.path.basename(target))[0])
+
+    with open(source) as f:
+        ldf = parse_ldf(f.read())
+    if master is not None:
+        ldf['master'] = master
+    if ldf['master'] is None:
+        sys.stderr.write('error: no master node found, use --master NAME\n')
+        return 1
+
+    with open(target, 'w') as f:
+        f.write(generate(ldf, namespace, source))
+    print('%s: %d frames, %d schedule tables' % (target, len(ldf['frames']), len(ldf['schedules'])))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,227 @@
+#!/usr/bin/env python3
+"""
+  \file     linbridge.py
+  \brief    Host side of LIN_Master_Bridge
+  \details  Encodes batched commands for LIN_Master_Bridge and decodes its batched frame results. Packets are COBS encoded
+            and terminated by 0x00, see src/LIN_master_Bridge.h for the packet format. Sets a schedule table given on
+            the command line, starts it and prints one line per frame, optionally as CSV. Lost packets are detected
+            via the packet sequence number.
+            Slot format: TYPE:ID:LEN:TIME_US[:DATA][,RETRY] with TYPE = MREQ, SRESP or EVENT, DATA as hex string
+            (master request) or '+' separated IDs of the collision resolution table (event triggered, entries use LEN
+            and TIME_US of the slot), RETRY = Rn (n immediate retries) or Nn (n retries in next slot)
+
+            Usage: python3 linbridge.py [--csv] --port PORT [--baud BAUD] SLOT [SLOT ...]
+            Example: python3 linbridge.py --port /dev/ttyUSB0 MREQ:0x1A:2:5000:AA55 SRESP:0x05:8:10000,R2 EVENT:0x3A:2:10000:0x10+0x11
+  \author   Georg Icking-Konert
+"""
+
+import sys
+import struct
+
+
+CMD_FRAME = 0x01                    # host command: send one-shot frame
+CMD_SCHEDULE = 0x02                 # host command: replace schedule table
+CMD_START = 0x03                    # host command: start schedule
+CMD_STOP = 0x04                     # host command: stop schedule
+REC_FRAME = 0x81                    # bridge record: finished frame
+REC_STATUS = 0x82                   # bridge record: bridge error
+
+FRAME_TYPES = {1: 'MREQ', 2: 'SRESP', 3: 'EVENT'}
+ERRORS = [(0x01, 'STATE'), (0x02, 'ECHO'), (0x04, 'TIMEOUT'), (0x08, 'CHK'), (0x80, 'MISC')]
+BRIDGE_ERRORS = [(0x01, 'FRAMING'), (0x02, 'COMMAND'), (0x04, 'FULL'), (0x08, 'LOST')]
+
+
+def error_text(error, names=ERRORS):
+    """convert error bitmask to text"""
+    if error == 0:
+        return 'OK'
+    return '|'.join(name for mask, name in names if error & mask) or ('0x%02X' % error)
+
+
+def cobs_encode(data):
+    """COBS encode packet payload and append delimiter"""
+    out = bytearray([0])
+    code = 0
+    for byte in data:
+        if byte == 0:
+            out[code] = len(out) - code
+            code = len(out)
+            out.append(0)
+        else:
+            out.append(byte)
+            if len(out) - code == 0xFF:
+                out[code] = 0xFF
+                code = len(out)
+                out.append(0)
+    out[code] = len(out) - code
+    out.append(0)
+    return bytes(out)
+
+
+def cobs_decode(packet):
+    """decode COBS packet without delimiter. Returns None if packet is invalid"""
+    out = bytearray()
+    i = 0
+    while i < len(packet):
+        code = packet[i]
+        if (code == 0) or (i + code > len(packet)):
+            return None
+        out += packet[i+1:i+code]
+        i += code
+        if (code != 0xFF) and (i < len(packet)):
+            out.append(0)
+    return bytes(out)
+
+
+def frame_type(name):
+    """convert frame type name to number"""
+    for num, text in FRAME_TYPES.items():
+        if text == name.upper():
+            return num
+    raise ValueError('unknown frame type %s' % name)
+
+
+def cmd_frame(ftype, fid, num_data, data=b'', version=2):
+    """command for one-shot frame"""
+    cmd = bytes([CMD_FRAME, ftype | (version << 4), fid, num_data])
+    return cmd + (bytes(data[:num_data]).ljust(num_data, b'\0') if ftype == 1 else b'')
+
+
+def slot_header(ftype, fid, num_data, slot_time, retries=0, next_slot=False, version=2):
+    """fixed part of a schedule slot: type, ID, numData, slot time [us] and retry policy"""
+    return bytes([ftype | (version << 4), fid, num_data]) + struct.pack('<I', slot_time) + \
+        bytes([(retries & 0x7F) | (0x80 if next_slot else 0)])
+
+
+def cmd_schedule(slots, version=2):
+    """command for schedule table. slots = list of (type, id, numData, slot time [us], data[, retries[, next_slot]]).
+       data = master request data, or list of slave response slots (id, numData, slot time [us][, retries[, next_slot]])
+       of the collision resolution table of an event triggered slot"""
+    cmd = bytearray([CMD_SCHEDULE, len(slots)])
+    for slot in slots:
+        ftype, fid, num_data, slot_time, data = slot[:5]
+        cmd += slot_header(ftype, fid, num_data, slot_time, *slot[5:7], version=version)
+        if ftype == 1:
+            cmd += bytes(data[:num_data]).ljust(num_data, b'\0')
+        elif ftype == 3:
+            cmd.append(len(data))
+            for entry in data:
+                cmd += slot_header(2, *entry[:5], version=version)
+    return bytes(cmd)
+
+
+def parse_slot(text):
+    """convert slot given on command line to tuple for cmd_schedule()"""
+    text, _, retry = text.partition(',')
+    fields = text.split(':')
+    ftype = frame_type(fields[0])
+    fid, num_data, slot_time = int(fields[1], 0), int(fields[2], 0), int(fields[3], 0)
+    if ftype == 3:
+        data = [(int(x, 0), num_data, slot_time) for x in fields[4].split('+')] if len(fields) > 4 else []
+    else:
+        data = bytes.fromhex(fields[4]) if len(fields) > 4 else b''
+    if retry and retry[0].upper() not in 'RN':
+        raise ValueError('unknown retry policy %s' % retry)
+    return (ftype, fid, num_data, slot_time, data, int(retry[1:] or 0), retry[:1].upper() == 'N')
+
+
+class Decoder:
+    """incremental decoder for bridge byte stream"""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.seq = None               # expected sequence number of next packet
+        self.lost = 0                 # number of lost or invalid packets
+
+    def feed(self, data):
+        """append received bytes and return list of decoded records"""
+        self.buf += data
+        records = []
+        while True:
+            pos = self.buf.find(b'\0')
+            if pos < 0:
+                break
+            payload = cobs_decode(bytes(self.buf[:pos]))
+            del self.buf[:pos+1]
+            if not payload:
+                self.lost += 1 if payload is None else 0
+                continue
+
+            # check sequence number
+            if (self.seq is not None) and (payload[0] != self.seq):
+                self.lost += (payload[0] - self.seq) & 0xFF
+            self.seq = (payload[0] + 1) & 0xFF
+
+            # decode records
+            i = 1
+            while i < len(payload):
+                if (payload[i] == REC_FRAME) and (i + 9 <= len(payload)):
+                    num_data = payload[i+4]
+                    timestamp, = struct.unpack_from('<I', payload, i+5)
+                    records.append({'rec': 'FRAME', 'type': FRAME_TYPES.get(payload[i+1], '?'), 'id': payload[i+2] & 0x3F,
+                        'error': payload[i+3], 'time': timestamp, 'data': bytes(payload[i+9:i+9+num_data])})
+                    i += 9 + num_data
+                elif (payload[i] == REC_STATUS) and (i + 3 <= len(payload)):
+                    records.append({'rec': 'STATUS', 'error': payload[i+1], 'lost': payload[i+2]})
+                    i += 3
+                else:
+                    self.lost += 1
+                    break
+        return records
+
+
+def format_record(rec, csv):
+    """format decoded record as text line"""
+    if rec['rec'] == 'STATUS':
+        return '%sbridge error %s, %d results lost' % ('# ' if csv else '', error_text(rec['error'], BRIDGE_ERRORS), rec['lost'])
+    data = ' '.join('%02X' % b for b in rec['data'])
+    if csv:
+        return '%d,%s,0x%02X,%s,%s' % (rec['time'], rec['type'], rec['id'], data, error_text(rec['error']))
+    return '%10.6fs  %-5s  ID 0x%02X  [%d] %-23s  %s' % (rec['time'] / 1e6, rec['type'], rec['id'], len(rec['data']),
+        data, error_text(rec['error']))
+
+
+def main(argv):
+    csv = False
+    port = None
+    baud = 115200
+    slots = []
+    i = 1
+    while i < len(argv):
+        if argv[i] == '--csv':
+            csv = True
+        elif argv[i] == '--port' and i+1 < len(argv):
+            port = argv[i+1]
+            i += 1
+        elif argv[i] == '--baud' and i+1 < len(argv):
+            baud = int(argv[i+1])
+            i += 1
+        else:
+            slots.append(parse_slot(argv[i]))
+        i += 1
+    if (port is None) or (len(slots) < 1):
+        sys.stderr.write(__doc__)
+        return 1
+
+    import serial
+    decoder = Decoder()
+    if csv:
+        print('time_us,type,id,data,error')
+
+    # set and start schedule in one packet, print frames until Ctrl-C
+    with serial.Serial(port, baud, timeout=0.1) as stream:
+        stream.write(cobs_encode(cmd_schedule(slots) + bytes([CMD_START])))
+        try:
+            while True:
+                for rec in decoder.feed(stream.read(4096)):
+                    print(format_record(rec, csv), flush=True)
+        except KeyboardInterrupt:
+            stream.write(cobs_encode(bytes([CMD_STOP])))
+
+    if decoder.lost > 0:
+        sys.stderr.write('warning: %d packets lost\n' % decoder.lost)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+"""
+  \file     lintrace.py
+  \brief    Decode binary LIN frame trace of LIN_Master::drainTrace()
+  \details  Reads the packed binary trace records written by LIN_Master::drainTrace() from a file or a serial port
+            (requires pyserial) and prints one line per frame, optionally as CSV. The decoder synchronizes on
+            LIN_TRACE_SYNC and the record XOR byte, i.e. it can start reading in the middle of a stream.
+            Record format (multi-byte values little endian), see LIN_Master::_traceFrame():
+              sync (0xA5), length, start [us] (4B), duration [us] (2B), timeout [us] (2B),
+              type | version<<4, PID, error, data (0..8B), checksum, XOR of all previous bytes
+
+            Usage: python3 lintrace.py [--csv] FILE
+                   python3 lintrace.py [--csv] --port PORT [--baud BAUD]
+  \author   Georg Icking-Konert
+"""
+
+import sys
+import struct
+
+
+TRACE_SYNC = 0xA5                   # first byte of trace record
+TRACE_HEADER = 13                   # record length without data, checksum and XOR byte
+
+FRAME_TYPES = {1: 'MREQ', 2: 'SRESP', 3: 'EVENT', 4: 'SPOR'}
+ERRORS = [(0x01, 'STATE'), (0x02, 'ECHO'), (0x04, 'TIMEOUT'), (0x08, 'CHK'), (0x80, 'MISC')]
+
+
+def error_text(error):
+    """convert error bitmask to text"""
+    if error == 0:
+        return 'OK'
+    return '|'.join(name for mask, name in ERRORS if error & mask) or ('0x%02X' % error)
+
+
+def decode_record(record):
+    """decode one verified record into a dict"""
+    start, duration, timeout = struct.unpack_from('<IHH', record, 2)
+    num_data = record[1] - TRACE_HEADER - 2
+    return {'start': start, 'duration': duration, 'timeout': timeout,
+            'type': FRAME_TYPES.get(record[10] & 0x0F, '?'), 'version': record[10] >> 4,
+            'pid': record[11], 'id': record[11] & 0x3F, 'error': record[12],
+            'data': bytes(record[TRACE_HEADER:TRACE_HEADER+num_data]), 'chk': record[TRACE_HEADER+num_data]}
+
+
+class Decoder:
+    """incremental decoder for trace byte stream"""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.skipped = 0              # bytes discarded while synchronizing
+
+    def feed(self, data):
+        """append received bytes and return list of decoded records"""
+        self.buf += data
+        records = []
+        while True:
+            # synchronize on record start
+            pos = self.buf.find(bytes([TRACE_SYNC]))
+            if pos < 0:
+                self.skipped += len(self.buf)
+                self.buf.clear()
+                break
+            if pos > 0:
+                self.skipped += pos
+                del self.buf[:pos]
+
+            # wait for length byte and complete record
+            if len(self.buf) < 2:
+                break
+            length = self.buf[1]
+            if (length < TRACE_HEADER + 2) or (length > TRACE_HEADER + 8 + 2):
+                self.skipped += 1
+                del self.buf[:1]
+                continue
+            if len(self.buf) < length:
+                break
+
+            # verify XOR byte, else resynchronize at next byte
+            chk = 0
+            for byte in self.buf[:length-1]:
+                chk ^= byte
+            if chk != self.buf[length-1]:
+                self.skipped += 1
+                del self.buf[:1]
+                continue
+            records.append(decode_record(self.buf[:length]))
+            del self.buf[:length]
+        return records
+
+
+def format_record(rec, csv):
+    """format decoded record as text line"""
+    data = ' '.join('%02X' % b for b in rec['data'])
+    if csv:
+        return '%d,%d,%d,%s,%d,0x%02X,0x%02X,%s,0x%02X,%s' % (rec['start'], rec['duration'], rec['timeout'], rec['type'],
+            rec['version'], rec['id'], rec['pid'], data, rec['chk'], error_text(rec['error']))
+    return '%10.6fs  %-5s V%d  ID 0x%02X  [%d] %-23s  CHK %02X  %5dus / %5dus  %s' % (rec['start'] / 1e6, rec['type'],
+        rec['version'], rec['id'], len(rec['data']), data, rec['chk'], rec['duration'], rec['timeout'], error_text(rec['error']))
+
+
+def main(argv):
+    csv = False
+    port = None
+    baud = 115200
+    args = []
+    i = 1
+    while i < len(argv):
+        if argv[i] == '--csv':
+            csv = True
+        elif argv[i] == '--port' and i+1 < len(argv):
+            port = argv[i+1]
+            i += 1
+        elif argv[i] == '--baud' and i+1 < len(argv):
+            baud = int(argv[i+1])
+            i += 1
+        else:
+            args.append(argv[i])
+        i += 1
+    if (port is None) and (len(args) < 1):
+        sys.stderr.write(__doc__)
+        return 1
+
+    decoder = Decoder()
+    if csv:
+        print('start_us,duration_us,timeout_us,type,version,id,pid,data,chk,error')
+
+    # read from serial port until Ctrl-C
+    if port is not None:
+        import serial
+        with serial.Serial(port, baud, timeout=0.1) as stream:
+            try:
+                while True:
+                    for rec in decoder.feed(stream.read(4096)):
+                        print(format_record(rec, csv), flush=True)
+            except KeyboardInterrupt:
+                pass
+
+    # read from file
+    else:
+        with open(args[0], 'rb') as stream:
+            for rec in decoder.feed(stream.read()):
+                print(format_record(rec, csv))
+
+    if decoder.skipped > 0:
+        sys.stderr.write('warning: %d bytes skipped while synchronizing\n' % decoder.skipped)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
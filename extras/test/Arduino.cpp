@@ -0,0 +1,44 @@
+/**
+  \file     Arduino.cpp
+  \brief    Minimal Arduino API for building and testing the library on a desktop host
+  \details  Simulated time base and Serial output, see Arduino.h
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "Arduino.h"
+
+
+// simulated time [us] and increment per call of micros() or millis()
+uint64_t          timeShim = 0;
+uint32_t          stepShim = 1;
+
+// serial output to stdout
+HardwareSerial    Serial;
+
+
+// simulated time [us]. Each call advances the time
+uint32_t micros(void)
+{
+  timeShim += stepShim;
+  return (uint32_t) timeShim;
+}
+
+// simulated time [ms]. Each call advances the time
+uint32_t millis(void)
+{
+  timeShim += stepShim;
+  return (uint32_t) (timeShim / 1000);
+}
+
+// wait by advancing the simulated time
+void delay(uint32_t ms)
+{
+  timeShim += ms * 1000;
+}
+
+// wait by advancing the simulated time
+void delayMicroseconds(uint32_t us)
+{
+  timeShim += us;
+}
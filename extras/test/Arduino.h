@@ -0,0 +1,152 @@
+/**
+  \file     Arduino.h
+  \brief    Minimal Arduino API for building and testing the library on a desktop host
+  \details  Provides the subset of the Arduino core used by the hardware independent parts of the library, i.e.
+            frame engine, schedule, queues, bridge and the simulated bus LIN_Master_Sim. Time is simulated: each call
+            of micros() or millis() advances the clock by a configurable step, so timeouts and slot times elapse
+            while tests poll handler(). Serial prints to stdout.
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _ARDUINO_SHIM_H_
+#define _ARDUINO_SHIM_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+#define LOW               0x0
+#define HIGH              0x1
+#define INPUT             0x0
+#define OUTPUT            0x1
+#define INPUT_PULLUP      0x2
+#define DEC               10
+#define HEX               16
+#define SERIAL_8N1        0x06
+
+#define PROGMEM
+#define pgm_read_byte(addr)   (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)   (*(const uint16_t *)(addr))
+
+#define noInterrupts()
+#define interrupts()
+
+typedef bool      boolean;
+typedef uint8_t   byte;
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// simulated time [us] and increment per call of micros() or millis()
+extern uint64_t   timeShim;
+extern uint32_t   stepShim;
+
+/// simulated time base
+uint32_t micros(void);
+uint32_t millis(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+inline void yield(void) { }
+
+/// pins are not used on host
+inline void pinMode(uint8_t, uint8_t) { }
+inline void digitalWrite(uint8_t, uint8_t) { }
+inline int digitalRead(uint8_t) { return HIGH; }
+
+template <class T> inline const T &min(const T &a, const T &b) { return (b < a) ? b : a; }
+template <class T> inline const T &max(const T &a, const T &b) { return (a < b) ? b : a; }
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASSES
+-----------------------------------------------------------------------------*/
+
+/// output of text and bytes
+class Print
+{
+  public:
+    virtual ~Print() { }
+    virtual size_t write(uint8_t Byte) = 0;
+    virtual size_t write(const uint8_t Buf[], size_t Len) { size_t n = 0; while (Len--) n += this->write(*Buf++); return n; }
+    size_t write(const char Str[]) { return this->write((const uint8_t *) Str, strlen(Str)); }
+    virtual int availableForWrite(void) { return 0; }
+    virtual void flush(void) { }
+
+    size_t print(const char Str[]) { return this->write(Str); }
+    size_t print(char Chr) { return this->write((uint8_t) Chr); }
+    size_t print(unsigned long Num, int Base = DEC) { char buf[24]; snprintf(buf, sizeof(buf), (Base == HEX) ? "%lX" : "%lu", Num); return this->write(buf); }
+    size_t print(long Num, int Base = DEC) { char buf[24]; if (Base == HEX) return this->print((unsigned long) Num, HEX); snprintf(buf, sizeof(buf), "%ld", Num); return this->write(buf); }
+    size_t print(unsigned int Num, int Base = DEC) { return this->print((unsigned long) Num, Base); }
+    size_t print(int Num, int Base = DEC) { return this->print((long) Num, Base); }
+    size_t print(unsigned char Num, int Base = DEC) { return this->print((unsigned long) Num, Base); }
+    size_t print(double Num, int Digits = 2) { char buf[32]; snprintf(buf, sizeof(buf), "%.*f", Digits, Num); return this->write(buf); }
+    size_t println(void) { return this->write("\r\n"); }
+    template <class T> size_t println(T Val) { size_t n = this->print(Val); return n + this->println(); }
+    template <class T> size_t println(T Val, int Fmt) { size_t n = this->print(Val, Fmt); return n + this->println(); }
+};
+
+/// input of bytes
+class Stream : public Print
+{
+  public:
+    virtual int available(void) = 0;
+    virtual int read(void) = 0;
+    virtual int peek(void) = 0;
+};
+
+/// serial interface. Default: output to stdout, no input. Loopback: sent bytes are echoed and passed to a hook,
+/// e.g. for an emulated slave which appends its response via receive()
+class HardwareSerial : public Stream
+{
+  public:
+    bool            loopback = false;                 //!< echo sent bytes instead of printing them
+    void            (*hook)(HardwareSerial &Port, uint8_t Byte) = NULL;   //!< loopback: called for each sent byte
+    unsigned long   baudrate = 0;                     //!< current baudrate
+    uint8_t         rx[256];                          //!< loopback: received bytes (ring buffer)
+    uint8_t         head = 0;
+    uint8_t         tail = 0;
+
+    void begin(unsigned long Baudrate, uint8_t Config = SERIAL_8N1) { (void) Config; this->baudrate = Baudrate; }
+    void updateBaudRate(unsigned long Baudrate) { this->baudrate = Baudrate; }
+    void swap(void) { }
+    void end(void) { }
+    operator bool(void) { return true; }
+    int available(void) { return (uint8_t) (this->head - this->tail); }
+    int read(void) { return (this->head != this->tail) ? this->rx[this->tail++] : -1; }
+    int peek(void) { return (this->head != this->tail) ? this->rx[this->tail] : -1; }
+    void receive(uint8_t Byte) { this->rx[this->head++] = Byte; }
+    size_t write(uint8_t Byte)
+    {
+      if (!this->loopback)
+        return (size_t) (putchar(Byte) != EOF);
+      this->receive(Byte);
+      if (this->hook != NULL)
+        this->hook(*this, Byte);
+      return 1;
+    }
+    using Print::write;
+};
+
+extern HardwareSerial   Serial;
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _ARDUINO_SHIM_H_
@@ -0,0 +1,58 @@
+/**
+  \file     test.h
+  \brief    Minimal test helpers for host tests of the LIN master library
+  \details  Each test program counts checks and failed checks and prints a summary. The exit code is the number
+            of failed checks (saturated), i.e. make stops at the first failing program.
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_TEST_H_
+#define _LIN_MASTER_TEST_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include "Arduino.h"
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+/// number of simulated frames for long runs. Reduce e.g. for sanitizer builds
+#if !defined(TEST_NUM_FRAMES)
+  #define TEST_NUM_FRAMES   1000000L
+#endif
+
+/// check a condition, print location and condition on failure
+#define CHECK(cond)     do { testChecks++; if (!(cond)) { testFails++; printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); } } while (0)
+
+/// check two integer values for equality, print both on failure
+#define CHECK_EQ(a, b)  do { long _a = (long) (a), _b = (long) (b); testChecks++; \
+                          if (_a != _b) { testFails++; printf("%s:%d: check failed: %s == %s (%ld != %ld)\n", __FILE__, __LINE__, #a, #b, _a, _b); } } while (0)
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL VARIABLES AND FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+static long   testChecks = 0;       //!< number of checks
+static long   testFails  = 0;       //!< number of failed checks
+
+/// print summary of test program and return exit code
+static inline int testSummary(const char Name[])
+{
+  printf("%s: %ld checks, %ld failed\n", Name, testChecks, testFails);
+  return (testFails > 100) ? 100 : (int) testFails;
+}
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_TEST_H_
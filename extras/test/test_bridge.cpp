@@ -0,0 +1,167 @@
+/**
+  \file     test_bridge.cpp
+  \brief    Host tests of LIN-to-host bridge: schedule download with retries and collision resolution
+  \details  Uses the simulated bus LIN_Master_Sim with emulated slaves, and a RAM stream as host link. The host
+            packets are COBS encoded here, and the frame records returned by the bridge are decoded and checked.
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "test.h"
+#include "LIN_master_Sim.h"
+#include "LIN_master_Bridge.h"
+
+
+// host link via RAM buffers
+class HostLink : public Stream
+{
+  public:
+    uint8_t     rx[256];              // host -> bridge bytes
+    uint16_t    lenRx = 0;
+    uint16_t    posRx = 0;
+    uint8_t     tx[8192];             // bridge -> host bytes
+    uint16_t    lenTx = 0;
+
+    int available() { return lenRx - posRx; }
+    int read() { return (posRx < lenRx) ? rx[posRx++] : -1; }
+    int peek() { return (posRx < lenRx) ? rx[posRx] : -1; }
+    int availableForWrite() { return 64; }
+    size_t write(uint8_t Byte) { if (lenTx < sizeof(tx)) tx[lenTx++] = Byte; return 1; }
+    using Print::write;
+
+    // COBS encode and append a host packet incl. delimiter
+    void send(const uint8_t Payload[], uint8_t Len)
+    {
+      uint16_t  code = this->lenRx++;
+
+      for (uint8_t i=0; i<Len; i++)
+      {
+        if (Payload[i] == 0x00)
+        {
+          this->rx[code] = this->lenRx - code;
+          code = this->lenRx++;
+        }
+        else
+          this->rx[this->lenRx++] = Payload[i];
+      }
+      this->rx[code] = this->lenRx - code;
+      this->rx[this->lenRx++] = 0x00;
+    }
+};
+
+
+// LIN node, emulated slaves and bridge
+static LIN_Master_Sim                   LIN("Test");
+static HostLink                         Host;
+static LIN_Master_Bridge                Bridge(LIN, Host);
+static LIN_Master_Responder::entry_t    Slaves[64];
+
+
+// decode frame records returned by bridge into sequence, e.g. "3AC 10 20T". C = checksum error, T = other error
+static void decode(char Sequence[], uint16_t Size)
+{
+  uint8_t   payload[256];
+  uint16_t  len = 0;
+  uint16_t  num = 0;
+
+  Sequence[0] = '\0';
+  for (uint16_t i=0; i<Host.lenTx; )
+  {
+    // COBS decode one packet
+    len = 0;
+    while ((i < Host.lenTx) && (Host.tx[i] != 0x00))
+    {
+      uint8_t code = Host.tx[i++];
+      for (uint8_t j=1; (j<code) && (i<Host.lenTx); j++)
+        payload[len++] = Host.tx[i++];
+      if ((code != 0xFF) && (i < Host.lenTx) && (Host.tx[i] != 0x00))
+        payload[len++] = 0x00;
+    }
+    i++;
+
+    // frame records. Skip packet sequence number and status records
+    for (uint16_t j=1; j<len; )
+    {
+      if (payload[j] == LIN_BRIDGE_REC_FRAME)
+      {
+        if (num < Size - 8)
+          num += sprintf(Sequence + num, "%s%X%s", (num > 0) ? " " : "", payload[j+2] & 0x3F,
+            (payload[j+3] == LIN_Master::NO_ERROR) ? "" : ((payload[j+3] & LIN_Master::ERROR_CHK) ? "C" : "T"));
+        j += 9 + payload[j+4];
+      }
+      else
+        j += 3;
+    }
+  }
+  Host.lenTx = 0;
+
+} // decode()
+
+
+// event triggered collision and retries of schedule downloaded from host
+static void testSchedule(void)
+{
+  char                  sequence[512];
+  uint8_t               count;
+
+  // schedule with 2 slots, then start:
+  //   slot 0: event triggered 0x3A, 2 bytes, 1ms, resolution via 0x10 and 0x11 (1 retry)
+  //   slot 1: slave response 0x20 (absent slave), 2 bytes, 1ms, 2 immediate retries
+  const uint8_t   cmd[] = { LIN_BRIDGE_CMD_SCHEDULE, 2,
+    0x23, 0x3A, 2, 0xE8, 0x03, 0x00, 0x00, 0x00, 2,
+      0x22, 0x10, 2, 0xE8, 0x03, 0x00, 0x00, 0x00,
+      0x22, 0x11, 2, 0xE8, 0x03, 0x00, 0x00, 0x01,
+    0x22, 0x20, 2, 0xE8, 0x03, 0x00, 0x00, 0x02,
+    LIN_BRIDGE_CMD_START };
+
+  Host.send(cmd, sizeof(cmd));
+  while (Slaves[0x11].count < 3)
+    Bridge.handler();
+  Bridge.flush();
+  for (uint8_t i=0; i<100; i++)
+    Bridge.handler();
+  decode(sequence, sizeof(sequence));
+  CHECK(strncmp(sequence, "3AC 10 11 20T 20T 20T 3AC 10 11 20T 20T 20T", 43) == 0);
+  if (strncmp(sequence, "3AC 10 11 20T 20T 20T 3AC 10 11 20T 20T 20T", 43) != 0)
+    printf("  %s\n", sequence);
+
+  // no collision: no resolution
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x3A, 2, Slaves[0x10].data);
+  Slaves[0x11].count = 0;
+  count = Slaves[0x3A].count;
+  while ((uint8_t) (Slaves[0x3A].count - count) < 3)
+    Bridge.handler();
+  Bridge.flush();
+  for (uint8_t i=0; i<100; i++)
+    Bridge.handler();
+  decode(sequence, sizeof(sequence));
+  CHECK(strstr(sequence, "3A 20T 20T 20T 3A 20T 20T 20T") != NULL);
+  CHECK_EQ(Slaves[0x11].count, 0);
+
+} // testSchedule()
+
+
+// run tests
+int main()
+{
+  uint8_t   data[2];
+
+  // emulated slaves 0x10 and 0x11. Both respond to event triggered frame 0x3A, which is emulated by a response
+  // with classic checksum, i.e. a checksum error as for simultaneous responses. Slave 0x20 is absent
+  memset(Slaves, 0, sizeof(Slaves));
+  LIN.attachTable(Slaves);
+  data[0] = LIN_Master::calculatePID(0x10);
+  data[1] = 0x01;
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V1, 0x3A, 2, data);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 2, data);
+  data[0] = LIN_Master::calculatePID(0x11);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x11, 2, data);
+
+  LIN.setTiming(true);
+  LIN.begin(19200);
+  Bridge.begin(500);
+  testSchedule();
+
+  return testSummary("test_bridge");
+
+} // main()
@@ -0,0 +1,141 @@
+/**
+  \file     test_esp8266.cpp
+  \brief    Host tests of ESP8266 backend LIN_Master_HardwareSerial_ESP8266
+  \details  The backend is built with ARDUINO_ARCH_ESP8266 against the Serial shim in loopback mode, i.e. all sent
+            bytes are echoed. An emulated slave appends its response after a slave response header. Checks the
+            BREAK at half baudrate, and that the BREAK echo read in _sendFrame() is followed by byte-wise reception.
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "test.h"
+#include "LIN_master_HardwareSerial_ESP8266.h"
+
+
+// emulated slave 0x11 and bus state
+static uint8_t    Response[3];              // response of slave 0x11 incl. checksum
+static bool       Respond = true;           // slave 0x11 present
+static bool       Corrupt = false;          // corrupt echo of PID
+static uint8_t    NumHeader = 0;            // number of sent bytes since BREAK
+static uint32_t   NumBreak = 0;             // number of BREAKs
+static uint32_t   NumWrongBaud = 0;         // number of bytes sent with wrong baudrate
+
+// LIN node
+static LIN_Master_HardwareSerial_ESP8266  LIN(false, "Test");
+
+
+// release state machine and clear error after blocking frame
+static void reset(void)
+{
+  LIN.resetStateMachine();
+  LIN.resetError();
+}
+
+
+// called for each byte sent via Serial
+static void slave(HardwareSerial &Port, uint8_t Byte)
+{
+  // BREAK (0x00 at half baudrate)
+  if ((Byte == 0x00) && (Port.baudrate == 19200/2))
+  {
+    NumBreak++;
+    NumHeader = 0;
+    return;
+  }
+  if (Port.baudrate != 19200)
+    NumWrongBaud++;
+
+  // corrupt echo of PID
+  if ((++NumHeader == 2) && Corrupt)
+    Port.rx[(uint8_t) (Port.head - 1)] ^= 0x01;
+
+  // append response after header SYNC+PID
+  if ((NumHeader == 2) && (Byte == LIN_Master::calculatePID(0x11)) && Respond)
+  {
+    for (uint8_t i=0; i<sizeof(Response); i++)
+      Port.receive(Response[i]);
+  }
+}
+
+
+// blocking frames and frame errors
+static void testFrames(void)
+{
+  uint8_t   tx[4] = {0x01, 0x02, 0x03, 0x04};
+  uint8_t   rx[2];
+
+  // master request: BREAK echo, then echo of SYNC+PID+DATA+CHK checked byte-wise
+  CHECK_EQ(LIN.sendMasterRequestBlocking(LIN_Master::LIN_V2, 0x10, 4, tx), LIN_Master::NO_ERROR);
+  reset();
+  CHECK_EQ(NumBreak, 1);
+  CHECK_EQ(Serial.baudrate, 19200);
+
+  // slave response
+  CHECK_EQ(LIN.receiveSlaveResponseBlocking(LIN_Master::LIN_V2, 0x11, 2, rx), LIN_Master::NO_ERROR);
+  reset();
+  CHECK((rx[0] == Response[0]) && (rx[1] == Response[1]));
+
+  // checksum error
+  Response[2] ^= 0x01;
+  CHECK_EQ(LIN.receiveSlaveResponseBlocking(LIN_Master::LIN_V2, 0x11, 2, rx), LIN_Master::ERROR_CHK);
+  reset();
+  Response[2] ^= 0x01;
+
+  // absent slave
+  Respond = false;
+  CHECK_EQ(LIN.receiveSlaveResponseBlocking(LIN_Master::LIN_V2, 0x11, 2, rx), LIN_Master::ERROR_TIMEOUT);
+  reset();
+  Respond = true;
+
+  // echo error
+  Corrupt = true;
+  CHECK(LIN.sendMasterRequestBlocking(LIN_Master::LIN_V2, 0x10, 4, tx) & LIN_Master::ERROR_ECHO);
+  reset();
+  Corrupt = false;
+
+} // testFrames()
+
+
+// long run: frames are finished without error
+static void testRun(void)
+{
+  uint8_t   tx[4] = {0x05, 0x06, 0x07, 0x08};
+  uint8_t   rx[2];
+  uint32_t  numErrors = 0;
+
+  NumBreak = 0;
+  for (uint32_t i=0; i<TEST_NUM_FRAMES/10; i++)
+  {
+    if (i & 0x01)
+    {
+      if (LIN.sendMasterRequestBlocking(LIN_Master::LIN_V2, 0x10, 1 + (i & 0x03), tx) != LIN_Master::NO_ERROR)
+        numErrors++;
+    }
+    else if (LIN.receiveSlaveResponseBlocking(LIN_Master::LIN_V2, 0x11, 2, rx) != LIN_Master::NO_ERROR)
+      numErrors++;
+    reset();
+  }
+  CHECK_EQ(numErrors, 0);
+  CHECK_EQ(NumBreak, TEST_NUM_FRAMES/10);
+  CHECK_EQ(NumWrongBaud, 0);
+
+} // testRun()
+
+
+// run tests
+int main()
+{
+  Response[0] = 0xA5;
+  Response[1] = 0x5A;
+  Response[2] = LIN_Master::calculateChecksum(LIN_Master::LIN_V2, 0x11, 2, Response);
+
+  Serial.loopback = true;
+  Serial.hook     = slave;
+  LIN.begin(19200);
+  testFrames();
+  testRun();
+  Serial.loopback = false;
+
+  return testSummary("test_esp8266");
+
+} // main()
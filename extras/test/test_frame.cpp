@@ -0,0 +1,264 @@
+/**
+  \file     test_frame.cpp
+  \brief    Host tests of LIN frame engine: checksum, frame check and handler() state machine
+  \details  Uses the simulated bus LIN_Master_Sim with emulated slaves. The long run checks that each injected
+            fault is detected as frame error, and that error-free frames return the slave data.
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "test.h"
+#include "LIN_master_Sim.h"
+
+
+// access to protected methods of LIN node
+class LIN_Master_Test : public LIN_Master_Sim
+{
+  public:
+
+    LIN_Master_Test() : LIN_Master_Sim("Test") { }
+
+    // checksum of current frame
+    uint8_t checksum(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[])
+    {
+      this->version = Version;
+      this->id      = Id;
+      return this->_calculateChecksum(NumData, Data);
+    }
+
+    // check frame from given send and receive buffer
+    LIN_Master::error_t check(LIN_Master::frame_t Type, uint8_t LenTx, const uint8_t Tx[], uint8_t LenRx, const uint8_t Rx[])
+    {
+      this->type    = Type;
+      this->version = LIN_Master::LIN_V2;
+      this->id      = Tx[2] & 0x3F;
+      this->lenTx   = LenTx;
+      this->lenRx   = LenRx;
+      memcpy(this->bufTx, Tx, LenTx);
+      memcpy(this->bufRx, Rx, LenRx);
+      return this->_checkFrame();
+    }
+
+};
+
+
+// reference checksum: sum with carry, inverted
+static uint8_t refChecksum(uint8_t Seed, uint8_t NumData, const uint8_t Data[])
+{
+  uint16_t  sum = Seed;
+
+  for (uint8_t i=0; i<NumData; i++)
+  {
+    sum += Data[i];
+    if (sum > 0xFF)
+      sum -= 0xFF;
+  }
+  return (uint8_t) (~sum);
+}
+
+
+// checksum and PID
+static void testChecksum(LIN_Master_Test &LIN)
+{
+  const uint8_t   data[3] = {0x55, 0x93, 0xE5};
+  uint8_t         buf[8];
+  uint32_t        seed = 1;
+
+  // example of LIN 2.x specification: protected ID 0x4A and data 55 93 E5 -> enhanced checksum E6
+  CHECK_EQ(LIN_Master::checksumKernel(0x4A, 3, data), 0xE6);
+  CHECK_EQ(LIN_Master::calculatePID(0x0A), 0xCA);
+  CHECK_EQ(LIN.checksum(LIN_Master::LIN_V2, 0x0A, 3, data), LIN_Master::checksumKernel(0xCA, 3, data));
+  CHECK_EQ(LIN_Master::calculateChecksum(LIN_Master::LIN_V2, 0x0A, 3, data), LIN.checksum(LIN_Master::LIN_V2, 0x0A, 3, data));
+
+  // PID table equals compile-time calculation
+  for (uint8_t id=0; id<64; id++)
+    CHECK_EQ(LIN_Master::calculatePID(id), LIN_Master::protectID(id));
+
+  // random data against reference. Classic checksum for LIN 1.x and diagnostic frames
+  for (uint16_t i=0; i<10000; i++)
+  {
+    uint8_t   id, len;
+    seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+    id  = seed & 0x3F;
+    len = ((seed >> 8) % 8) + 1;
+    for (uint8_t j=0; j<len; j++)
+      buf[j] = (uint8_t) (seed >> (j+11));
+    CHECK_EQ(LIN.checksum(LIN_Master::LIN_V1, id, len, buf), refChecksum(0, len, buf));
+    CHECK_EQ(LIN.checksum(LIN_Master::LIN_V2, id, len, buf),
+      refChecksum(((id == 0x3C) || (id == 0x3D)) ? 0 : LIN_Master::calculatePID(id), len, buf));
+  }
+
+} // testChecksum()
+
+
+// frame check of echo, checksum and event triggered response
+static void testCheckFrame(LIN_Master_Test &LIN)
+{
+  uint8_t   pid = LIN_Master::calculatePID(0x10);
+  uint8_t   tx[12] = {0x00, 0x55, pid};
+  uint8_t   rx[12];
+
+  // master request: echo must match
+  tx[3] = 0x01; tx[4] = 0x02; tx[5] = LIN_Master::calculateChecksum(LIN_Master::LIN_V2, 0x10, 2, tx+3);
+  memcpy(rx, tx, 6);
+  CHECK_EQ(LIN.check(LIN_Master::MASTER_REQUEST, 6, tx, 6, rx), LIN_Master::NO_ERROR);
+  rx[4] ^= 0x10;
+  CHECK_EQ(LIN.check(LIN_Master::MASTER_REQUEST, 6, tx, 6, rx), LIN_Master::ERROR_ECHO);
+
+  // slave response: header echo and checksum
+  memcpy(rx, tx, 3);
+  rx[3] = 0xAA; rx[4] = 0xBB; rx[5] = LIN_Master::calculateChecksum(LIN_Master::LIN_V2, 0x10, 2, rx+3);
+  CHECK_EQ(LIN.check(LIN_Master::SLAVE_RESPONSE, 3, tx, 6, rx), LIN_Master::NO_ERROR);
+  rx[5] ^= 0x01;
+  CHECK_EQ(LIN.check(LIN_Master::SLAVE_RESPONSE, 3, tx, 6, rx), LIN_Master::ERROR_CHK);
+  rx[5] ^= 0x01; rx[2] ^= 0x01;
+  CHECK_EQ(LIN.check(LIN_Master::SLAVE_RESPONSE, 3, tx, 6, rx), LIN_Master::ERROR_ECHO);
+
+  // event triggered: first data byte must be a valid PID, else collision
+  tx[2] = rx[2] = LIN_Master::calculatePID(0x3A);
+  rx[3] = LIN_Master::calculatePID(0x11); rx[4] = 0x01;
+  rx[5] = LIN_Master::calculateChecksum(LIN_Master::LIN_V2, 0x3A, 2, rx+3);
+  CHECK_EQ(LIN.check(LIN_Master::EVENT_TRIGGERED, 3, tx, 6, rx), LIN_Master::NO_ERROR);
+  rx[3] = 0x11 | 0x80;
+  rx[5] = LIN_Master::calculateChecksum(LIN_Master::LIN_V2, 0x3A, 2, rx+3);
+  CHECK_EQ(LIN.check(LIN_Master::EVENT_TRIGGERED, 3, tx, 6, rx), LIN_Master::ERROR_CHK);
+
+} // testCheckFrame()
+
+
+// handler() state machine with wire timing
+static void testStateMachine(LIN_Master_Test &LIN, LIN_Master_Responder::entry_t Slaves[])
+{
+  uint8_t                 data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+  uint8_t                 buf[8];
+  LIN_Master::frame_t     type;
+  uint8_t                 id, num;
+  LIN_Master::state_t     state;
+  bool                    body = false;
+  uint32_t                n;
+
+  LIN.setTiming(true);
+  LIN.begin(19200);
+  CHECK_EQ(LIN.getState(), LIN_Master::STATE_IDLE);
+
+  // master request: BREAK -> BODY -> DONE, received by slave
+  CHECK_EQ(LIN.sendMasterRequest(LIN_Master::LIN_V2, 0x20, 4, data), LIN_Master::STATE_BREAK);
+  for (n=0; (n<100000) && ((state = LIN.handler()) != LIN_Master::STATE_DONE); n++)
+    body |= (state == LIN_Master::STATE_BODY);
+  CHECK(body);
+  CHECK_EQ(LIN.getState(), LIN_Master::STATE_DONE);
+  CHECK_EQ(LIN.getError(), LIN_Master::NO_ERROR);
+  CHECK_EQ(Slaves[0x20].count, 1);
+  CHECK(memcmp(Slaves[0x20].data, data, 4) == 0);
+
+  // new frame while DONE -> rejected with ERROR_STATE
+  LIN.receiveSlaveResponse(LIN_Master::LIN_V2, 0x10, 8);
+  CHECK(LIN.getError() & LIN_Master::ERROR_STATE);
+  LIN.resetStateMachine();
+  LIN.resetError();
+
+  // slave response: data of slave
+  LIN.receiveSlaveResponse(LIN_Master::LIN_V2, 0x10, 8);
+  while (LIN.handler() != LIN_Master::STATE_DONE);
+  CHECK_EQ(LIN.getError(), LIN_Master::NO_ERROR);
+  LIN.getFrame(type, id, num, buf);
+  CHECK_EQ(type, LIN_Master::SLAVE_RESPONSE);
+  CHECK_EQ(num, 8);
+  CHECK(memcmp(buf, Slaves[0x10].data, 8) == 0);
+  LIN.resetStateMachine();
+
+  // absent slave -> timeout via frame timeout
+  LIN.receiveSlaveResponse(LIN_Master::LIN_V2, 0x30, 2);
+  while (LIN.handler() != LIN_Master::STATE_DONE);
+  CHECK_EQ(LIN.getError(), LIN_Master::ERROR_TIMEOUT);
+  LIN.resetStateMachine();
+  LIN.resetError();
+
+  // wrong length configured on master -> timeout (too few bytes)
+  LIN.receiveSlaveResponse(LIN_Master::LIN_V2, 0x11, 4);
+  while (LIN.handler() != LIN_Master::STATE_DONE);
+  CHECK_EQ(LIN.getError(), LIN_Master::ERROR_TIMEOUT);
+  LIN.resetStateMachine();
+  LIN.resetError();
+
+  // blocking functions. Frame remains in DONE until released
+  CHECK_EQ(LIN.sendMasterRequestBlocking(LIN_Master::LIN_V2, 0x20, 4, data+4), LIN_Master::NO_ERROR);
+  CHECK(memcmp(Slaves[0x20].data, data+4, 4) == 0);
+  CHECK_EQ(LIN.getState(), LIN_Master::STATE_DONE);
+  LIN.resetStateMachine();
+  memset(buf, 0, sizeof(buf));
+  CHECK_EQ(LIN.receiveSlaveResponseBlocking(LIN_Master::LIN_V1, 0x11, 2, buf), LIN_Master::NO_ERROR);
+  CHECK(memcmp(buf, Slaves[0x11].data, 2) == 0);
+  LIN.resetStateMachine();
+
+  LIN.end();
+  CHECK_EQ(LIN.getState(), LIN_Master::STATE_OFF);
+
+} // testStateMachine()
+
+
+// long run with fault injection and instant timing. Each injected fault is detected
+static void testFaults(LIN_Master_Test &LIN, LIN_Master_Responder::entry_t Slaves[])
+{
+  uint8_t             data[2] = {0x12, 0x34};
+  uint8_t             buf[8];
+  uint32_t            numErrors = 0;
+  uint32_t            numWrongData = 0;
+
+  LIN.setTiming(false);
+  LIN.begin(19200);
+  LIN.setFaults(LIN_Master_Sim::FAULT_ECHO | LIN_Master_Sim::FAULT_CHK | LIN_Master_Sim::FAULT_TIMEOUT | LIN_Master_Sim::FAULT_SHORT, 655, 12345);
+  for (uint32_t i=0; i<TEST_NUM_FRAMES; i++)
+  {
+    LIN_Master::frame_t   type;
+    uint8_t               id, num;
+
+    switch (i % 3)
+    {
+      case 0:  LIN.receiveSlaveResponse(LIN_Master::LIN_V2, 0x10, 8); break;
+      case 1:  LIN.receiveSlaveResponse(LIN_Master::LIN_V1, 0x11, 2); break;
+      default: LIN.sendMasterRequest(LIN_Master::LIN_V2, 0x20, 2, data); break;
+    }
+    while (LIN.handler() != LIN_Master::STATE_DONE);
+    if (LIN.getError() != LIN_Master::NO_ERROR)
+      numErrors++;
+    else if ((i % 3) != 2)
+    {
+      LIN.getFrame(type, id, num, buf);
+      if (memcmp(buf, Slaves[id & 0x3F].data, num) != 0)
+        numWrongData++;
+    }
+    LIN.resetStateMachine();
+    LIN.resetError();
+  }
+  CHECK(LIN.getNumFaults() > 0);
+  CHECK_EQ(numErrors, LIN.getNumFaults());
+  CHECK_EQ(numWrongData, 0);
+  LIN.setFaults(LIN_Master_Sim::NO_FAULT, 0);
+  LIN.end();
+
+} // testFaults()
+
+
+// run tests
+int main()
+{
+  static LIN_Master_Test                  LIN;
+  static LIN_Master_Responder::entry_t    Slaves[64];
+  uint8_t                                 data[8] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+
+  // emulated slaves: responses 0x10 (LIN 2.x) and 0x11 (LIN 1.x), request 0x20
+  memset(Slaves, 0, sizeof(Slaves));
+  LIN.attachTable(Slaves);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 8, data);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V1, 0x11, 2, data+2);
+  LIN.setFrame(LIN_Master::MASTER_REQUEST, LIN_Master::LIN_V2, 0x20, 4);
+
+  testChecksum(LIN);
+  testCheckFrame(LIN);
+  testStateMachine(LIN, Slaves);
+  testFaults(LIN, Slaves);
+
+  return testSummary("test_frame");
+
+} // main()
@@ -0,0 +1,102 @@
+/**
+  \file     test_group.cpp
+  \brief    Host tests of multi-bus manager LIN_Master_Group
+  \details  Uses two simulated buses LIN_Master_Sim with emulated slaves. Checks the readiness mask, in particular
+            that invalid bus indices are ignored, and that frames on both buses are handled from one handler().
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "test.h"
+#include "LIN_master_Sim.h"
+#include "LIN_master_Group.h"
+
+
+// LIN nodes, emulated slaves and group
+static LIN_Master_Sim                   LIN0("Bus0");
+static LIN_Master_Sim                   LIN1("Bus1");
+static LIN_Master_Responder::entry_t    Slaves0[64];
+static LIN_Master_Responder::entry_t    Slaves1[64];
+static LIN_Master_Group                 Group;
+
+// finished frames per bus
+static uint32_t   NumDone[2];
+static uint32_t   NumErrors;
+
+
+// called when frame on a bus is finished
+static void frameDone(LIN_Master &LIN, uint8_t Bus)
+{
+  NumDone[Bus & 0x01]++;
+  if (LIN.getError() != LIN_Master::NO_ERROR)
+    NumErrors++;
+}
+
+
+// readiness mask: only buses in group can be marked ready
+static void testReady(void)
+{
+  CHECK_EQ(Group.getReady(), 0x00);
+  Group.setReady(2);
+  Group.setReady(LIN_GROUP_MAX);
+  Group.setReady(LIN_GROUP_MAX + 1);
+  Group.setReady(255);
+  CHECK_EQ(Group.getReady(), 0x00);
+
+  // idle buses are removed from mask by handler()
+  Group.setReady(1);
+  CHECK_EQ(Group.getReady(), 0x02);
+  CHECK_EQ(Group.handler(), 0x00);
+
+} // testReady()
+
+
+// frames on both buses
+static void testFrames(void)
+{
+  uint8_t   data[2] = {0x01, 0x02};
+
+  for (uint16_t i=0; i<1000; i++)
+  {
+    CHECK_EQ(Group.receiveSlaveResponse(0, LIN_Master::LIN_V2, 0x10, 2), LIN_Master::STATE_BREAK);
+    CHECK_EQ(Group.sendMasterRequest(1, LIN_Master::LIN_V2, 0x20, 2, data), LIN_Master::STATE_BREAK);
+    for (uint32_t j=0; (j<100000L) && (Group.getReady() != 0x00); j++)
+      Group.handler();
+  }
+  CHECK_EQ(NumDone[0], 1000);
+  CHECK_EQ(NumDone[1], 1000);
+  CHECK_EQ(NumErrors, 0);
+
+  // invalid bus
+  CHECK_EQ(Group.receiveSlaveResponse(2, LIN_Master::LIN_V2, 0x10, 2), LIN_Master::STATE_OFF);
+  CHECK_EQ(Group.getReady(), 0x00);
+
+} // testFrames()
+
+
+// run tests
+int main()
+{
+  uint8_t   data[2] = {0x11, 0x22};
+
+  // emulated slaves: response 0x10 on bus 0, request 0x20 on bus 1
+  memset(Slaves0, 0, sizeof(Slaves0));
+  memset(Slaves1, 0, sizeof(Slaves1));
+  LIN0.attachTable(Slaves0);
+  LIN1.attachTable(Slaves1);
+  LIN0.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 2, data);
+  LIN1.setFrame(LIN_Master::MASTER_REQUEST, LIN_Master::LIN_V2, 0x20, 2);
+  LIN0.setTiming(true);
+  LIN1.setTiming(true);
+  LIN0.begin(19200);
+  LIN1.begin(19200);
+
+  CHECK_EQ(Group.add(LIN0), 0);
+  CHECK_EQ(Group.add(LIN1), 1);
+  Group.attachCallback(frameDone);
+  testReady();
+  testFrames();
+
+  return testSummary("test_group");
+
+} // main()
@@ -0,0 +1,86 @@
+/**
+  \file     test_ldf.cpp
+  \brief    Host test of header generated by extras/LDF_Generator/ldf2h.py from Example.ldf
+  \details  The generated header is compiled with -Wall -Wextra -Werror, i.e. incomplete initializers of slot_t are
+            rejected. Its schedule table is executed on the simulated bus LIN_Master_Sim, and the signals packed into
+            the master request and unpacked from the slave response are checked.
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "test.h"
+#include "LIN_master_Sim.h"
+#include "LIN_master_Schedule.h"
+#include "Example.h"
+
+
+// shortcuts for generated frames
+namespace Cmd    = Example::MotorCmd;
+namespace Status = Example::MotorStatus;
+
+
+// run tests
+int main()
+{
+  static LIN_Master_Sim                   LIN("Test");
+  static LIN_Master_Schedule              Schedule(LIN);
+  static LIN_Master_Responder::entry_t    Slaves[64];
+  static LIN_Master::result_t             Results[8];
+  const uint8_t                           response[8] = {0x61, 0x02, 0x2A, 0x00, 0x12, 0x34, 0x56, 0x78};
+  LIN_Master::result_t                    result;
+  uint16_t                                numStatus = 0;
+
+  // generated tables: unconditional frames only, all fields initialized
+  CHECK_EQ(Example::Normal_numSlots, 2);
+  CHECK_EQ(Example::Diagnostic_numSlots, 1);
+  CHECK_EQ(Example::Normal[0].id, 0x1B);
+  CHECK(Example::Normal[0].data == Cmd::frame.data);
+  CHECK(Example::Normal[1].data == NULL);
+  CHECK_EQ(Example::Normal[1].slotTime, 10000);
+  CHECK(Example::Normal[1].table == NULL);
+  CHECK_EQ(Example::Normal[1].retries, 0);
+  CHECK_EQ(Example::Normal[1].baudrate, 0);
+
+  // emulated motor slave
+  memset(Slaves, 0, sizeof(Slaves));
+  LIN.attachTable(Slaves);
+  LIN.setFrame(LIN_Master::MASTER_REQUEST, Example::version, Cmd::id, Cmd::numData);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, Example::version, Status::id, Status::numData, response);
+
+  // pack command signals
+  Cmd::frame.set<Cmd::MotorOn>(1);
+  Cmd::frame.set<Cmd::MotorDir>(0);
+  Cmd::frame.set<Cmd::MotorSpeed>(0x5A5);
+
+  // run table for a few cycles
+  LIN.setTiming(true);
+  LIN.begin(Example::baudrate);
+  LIN.attachResultQueue(Results, 8);
+  Schedule.setTable(Example::Normal, Example::Normal_numSlots);
+  Schedule.start();
+  while (numStatus < 3)
+  {
+    Schedule.handler();
+    while (LIN.readResult(result))
+    {
+      CHECK_EQ(result.error, LIN_Master::NO_ERROR);
+      if ((result.id & 0x3F) == Status::id)
+      {
+        Status::frame.update(result);
+        numStatus++;
+      }
+    }
+  }
+
+  // command received by slave, status signals unpacked
+  CHECK(Slaves[Cmd::id].count >= 3);
+  CHECK_EQ(Slaves[Cmd::id].data[0], 0x95);
+  CHECK_EQ(Slaves[Cmd::id].data[1], 0x16);
+  CHECK_EQ(Status::frame.get<Status::MotorState>(), 1);
+  CHECK_EQ(Status::frame.get<Status::MotorTemp>(), 0x98);
+  CHECK_EQ(Status::frame.get<Status::MotorCurrent>(), 0x2A);
+  CHECK(memcmp(Status::MotorSerial::get(Status::frame.data), response+4, 4) == 0);
+
+  return testSummary("test_ldf");
+
+} // main()
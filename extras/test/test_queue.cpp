@@ -0,0 +1,193 @@
+/**
+  \file     test_queue.cpp
+  \brief    Host tests of job and result queue, and of blocking frames in sleep mode
+  \details  Uses the simulated bus LIN_Master_Sim with emulated slaves. Checks that a full job queue drops new
+            frames without affecting the ongoing frame, that every frame is either finished or counted as lost,
+            and that a blocking frame rejected in sleep mode leaves the caller's buffer untouched.
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "test.h"
+#include "LIN_master_Sim.h"
+
+
+// number of queue entries. Ring buffers hold one entry less
+#define NUM_JOBS        4
+#define NUM_RESULTS     16
+
+
+// full job queue: new frames are dropped, ongoing and queued frames are finished
+static void testQueueFull(LIN_Master_Sim &LIN, LIN_Master_Responder::entry_t Slaves[])
+{
+  uint8_t                 data[4] = {0xA1, 0xA2, 0xA3, 0xA4};
+  LIN_Master::result_t    result;
+  uint8_t                 n = 0;
+
+  LIN.setTiming(true);
+  LIN.begin(19200);
+
+  // 1 frame on bus, NUM_JOBS-1 queued, 2 dropped
+  CHECK_EQ(LIN.receiveSlaveResponse(LIN_Master::LIN_V2, 0x10, 8), LIN_Master::STATE_BREAK);
+  for (uint8_t i=0; i<NUM_JOBS+1; i++)
+    LIN.receiveSlaveResponse(LIN_Master::LIN_V1, 0x11, 2);
+  CHECK_EQ(LIN.freeJobs(), 0);
+  CHECK_EQ(LIN.getLostJobs(), 2);
+  CHECK_EQ(LIN.getError(), LIN_Master::NO_ERROR);
+
+  // also for master requests while full
+  LIN.sendMasterRequest(LIN_Master::LIN_V2, 0x20, 4, data);
+  CHECK_EQ(LIN.getLostJobs(), 3);
+  CHECK(LIN.getState() != LIN_Master::STATE_IDLE);
+
+  // all frames finish without error, first frame with its data
+  for (uint32_t i=0; (i<1000000L) && ((LIN.getState() != LIN_Master::STATE_IDLE) || (LIN.freeJobs() != NUM_JOBS-1)); i++)
+    LIN.handler();
+  while (LIN.readResult(result))
+  {
+    CHECK_EQ(result.error, LIN_Master::NO_ERROR);
+    CHECK_EQ(result.type, LIN_Master::SLAVE_RESPONSE);
+    if (n == 0)
+    {
+      CHECK_EQ(result.numData, 8);
+      CHECK(memcmp(result.data, Slaves[0x10].data, 8) == 0);
+    }
+    else
+      CHECK(memcmp(result.data, Slaves[0x11].data, 2) == 0);
+    n++;
+  }
+  CHECK_EQ(n, NUM_JOBS);
+  CHECK_EQ(Slaves[0x20].count, 0);
+
+  LIN.resetLostJobs();
+  LIN.end();
+
+} // testQueueFull()
+
+
+// long run with random bursts: each frame is finished or counted as lost
+static void testQueueRun(LIN_Master_Sim &LIN, LIN_Master_Responder::entry_t Slaves[])
+{
+  uint8_t                 data[4] = {0xB1, 0xB2, 0xB3, 0xB4};
+  LIN_Master::result_t    result;
+  uint32_t                seed = 7;
+  uint32_t                numSent = 0;
+  uint32_t                numLost = 0;
+  uint32_t                numDone = 0;
+  uint32_t                numWrongData = 0;
+
+  LIN.setTiming(false);
+  LIN.begin(19200);
+  Slaves[0x20].count = 0;
+  for (uint32_t i=0; i<TEST_NUM_FRAMES; i++)
+  {
+    seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+
+    // burst of 0..7 frames
+    if ((seed & 0x03) == 0)
+    {
+      for (uint8_t j=0; j<((seed >> 4) & 0x07); j++)
+      {
+        if (j & 0x01)
+          LIN.sendMasterRequest(LIN_Master::LIN_V2, 0x20, 4, data);
+        else
+          LIN.receiveSlaveResponse(LIN_Master::LIN_V1, 0x11, 2);
+        numSent++;
+      }
+    }
+
+    // handle frames and read results
+    LIN.handler();
+    while (LIN.readResult(result))
+    {
+      numDone++;
+      if (result.error != LIN_Master::NO_ERROR)
+        numWrongData++;
+      else if ((result.type == LIN_Master::SLAVE_RESPONSE) && (memcmp(result.data, Slaves[0x11].data, 2) != 0))
+        numWrongData++;
+    }
+    numLost += LIN.getLostJobs();
+    LIN.resetLostJobs();
+  }
+
+  // finish remaining frames
+  while ((LIN.getState() != LIN_Master::STATE_IDLE) || (LIN.freeJobs() != NUM_JOBS-1))
+    LIN.handler();
+  while (LIN.readResult(result))
+    numDone++;
+  CHECK(numLost > 0);
+  CHECK_EQ(LIN.getLostResults(), 0);
+  CHECK_EQ(numDone + numLost, numSent);
+  CHECK_EQ(numWrongData, 0);
+  LIN.end();
+
+} // testQueueRun()
+
+
+// blocking frame in sleep mode is rejected and doesn't return data of previous frame
+static void testSleepBlocking(LIN_Master_Sim &LIN, LIN_Master_Responder::entry_t Slaves[])
+{
+  uint8_t   buf[8];
+
+  LIN.setTiming(true);
+  LIN.begin(19200);
+
+  // previous frame with 8 data bytes
+  CHECK_EQ(LIN.receiveSlaveResponseBlocking(LIN_Master::LIN_V2, 0x10, 8, buf), LIN_Master::NO_ERROR);
+  CHECK(memcmp(buf, Slaves[0x10].data, 8) == 0);
+  LIN.resetStateMachine();
+
+  // enter sleep mode
+  CHECK(LIN.goToSleep());
+  for (uint32_t i=0; (i<1000000L) && (LIN.getState() != LIN_Master::STATE_SLEEP); i++)
+    LIN.handler();
+  CHECK_EQ(LIN.getState(), LIN_Master::STATE_SLEEP);
+
+  // rejected frame: ERROR_STATE, buffer untouched
+  memset(buf, 0xEE, sizeof(buf));
+  CHECK(LIN.receiveSlaveResponseBlocking(LIN_Master::LIN_V1, 0x11, 2, buf) & LIN_Master::ERROR_STATE);
+  for (uint8_t i=0; i<sizeof(buf); i++)
+    CHECK_EQ(buf[i], 0xEE);
+  CHECK_EQ(LIN.getState(), LIN_Master::STATE_SLEEP);
+
+  // after wake-up frames are accepted again
+  LIN.resetError();
+  CHECK(LIN.wakeup());
+  for (uint32_t i=0; (i<1000000L) && (LIN.getState() != LIN_Master::STATE_IDLE); i++)
+    LIN.handler();
+  CHECK_EQ(LIN.receiveSlaveResponseBlocking(LIN_Master::LIN_V1, 0x11, 2, buf), LIN_Master::NO_ERROR);
+  CHECK(memcmp(buf, Slaves[0x11].data, 2) == 0);
+  LIN.resetStateMachine();
+  LIN.end();
+
+} // testSleepBlocking()
+
+
+// run tests
+int main()
+{
+  static LIN_Master_Sim                   LIN("Test");
+  static LIN_Master_Responder::entry_t    Slaves[64];
+  static LIN_Master::job_t                Jobs[NUM_JOBS];
+  static LIN_Master::result_t             Results[NUM_RESULTS];
+  uint8_t                                 data[8] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+
+  // emulated slaves: responses 0x10 (8 bytes) and 0x11 (2 bytes), request 0x20
+  memset(Slaves, 0, sizeof(Slaves));
+  LIN.attachTable(Slaves);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 8, data);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V1, 0x11, 2, data+6);
+  LIN.setFrame(LIN_Master::MASTER_REQUEST, LIN_Master::LIN_V2, 0x20, 4);
+
+  // without queues
+  testSleepBlocking(LIN, Slaves);
+
+  // with job and result queue
+  LIN.attachJobQueue(Jobs, NUM_JOBS);
+  LIN.attachResultQueue(Results, NUM_RESULTS);
+  testQueueFull(LIN, Slaves);
+  testQueueRun(LIN, Slaves);
+
+  return testSummary("test_queue");
+
+} // main()
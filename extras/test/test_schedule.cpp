@@ -0,0 +1,348 @@
+/**
+  \file     test_schedule.cpp
+  \brief    Host tests of schedule table handler: retries and event triggered collision resolution
+  \details  Uses the simulated bus LIN_Master_Sim with emulated slaves. Each test runs without queues (results via
+            schedule callback), with a result queue, and with result and job queue attached to the LIN node.
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "test.h"
+#include "LIN_master_Sim.h"
+#include "LIN_master_Schedule.h"
+
+
+// number of queue entries
+#define NUM_JOBS        4
+#define NUM_RESULTS     16
+
+// queue setup of LIN node
+#define QUEUE_NONE      0
+#define QUEUE_RESULT    1
+#define QUEUE_JOB       2
+
+
+// simulated LIN node with frame counter and forced timeouts
+class LIN_Master_Test : public LIN_Master_Sim
+{
+  public:
+
+    uint32_t    starts[64];           // number of started frames per ID
+    uint8_t     fails[64];            // number of next frames per ID to fail with timeout
+
+    LIN_Master_Test() : LIN_Master_Sim("Test") { this->clear(); }
+
+    void clear(void)
+    {
+      memset(this->starts, 0, sizeof(this->starts));
+      memset(this->fails, 0, sizeof(this->fails));
+    }
+
+  protected:
+
+    LIN_Master::state_t _sendBreak(void)
+    {
+      this->starts[this->id & 0x3F]++;
+      return LIN_Master_Sim::_sendBreak();
+    }
+
+    LIN_Master::state_t _receiveFrame(void)
+    {
+      LIN_Master_Sim::_receiveFrame();
+      if ((this->state == LIN_Master::STATE_DONE) && (this->fails[this->id & 0x3F] > 0))
+      {
+        this->fails[this->id & 0x3F]--;
+        this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_TIMEOUT);
+      }
+      return this->state;
+    }
+
+};
+
+
+// LIN node, emulated slaves and queues
+static LIN_Master_Test                  LIN;
+static LIN_Master_Schedule              Schedule(LIN);
+static LIN_Master_Responder::entry_t    Slaves[64];
+static LIN_Master::job_t                Jobs[NUM_JOBS];
+static LIN_Master::result_t             Results[NUM_RESULTS];
+
+// sequence of finished frames, e.g. "10E 10 3AC"
+static char                             Sequence[256];
+static uint16_t                         NumSequence;
+static uint32_t                         NumFrames;
+static uint32_t                         NumErrorState;
+static uint8_t                          IdLast;
+static LIN_Master::error_t              ErrorLast;
+
+
+// append finished frame to sequence. E = error, C = checksum error (collision)
+static void record(uint8_t Id, LIN_Master::error_t Error)
+{
+  NumFrames++;
+  IdLast    = Id & 0x3F;
+  ErrorLast = Error;
+  if (Error & LIN_Master::ERROR_STATE)
+    NumErrorState++;
+  if (NumSequence < sizeof(Sequence) - 8)
+    NumSequence += sprintf(Sequence + NumSequence, "%s%X%s", (NumSequence > 0) ? " " : "", Id & 0x3F,
+      (Error & LIN_Master::ERROR_CHK) ? "C" : ((Error != LIN_Master::NO_ERROR) ? "E" : ""));
+}
+
+
+// schedule callback without queues
+static void callback(LIN_Master &Node, uint8_t Slot)
+{
+  LIN_Master::frame_t   type;
+  uint8_t               id, num, data[8];
+
+  (void) Slot;
+  Node.getFrame(type, id, num, data);
+  record(id, Node.getError());
+}
+
+
+// setup LIN node with queues, and start schedule table
+static void setup(uint8_t Queues, const LIN_Master_Schedule::slot_t Table[], uint8_t NumSlots)
+{
+  Schedule.stop();
+  LIN.end();
+  LIN.attachResultQueue((Queues >= QUEUE_RESULT) ? Results : NULL, NUM_RESULTS);
+  LIN.attachJobQueue((Queues >= QUEUE_JOB) ? Jobs : NULL, NUM_JOBS);
+  LIN.setTiming(true);
+  LIN.begin(19200);
+  LIN.clear();
+  Schedule.attachCallback((Queues == QUEUE_NONE) ? callback : NULL);
+  Schedule.setTable(Table, NumSlots);
+  Sequence[0] = '\0';
+  NumSequence = 0;
+  NumFrames = 0;
+  NumErrorState = 0;
+  Schedule.start();
+}
+
+
+// run schedule until a number of frames are finished
+static void run(uint32_t NumMax)
+{
+  LIN_Master::result_t  result;
+
+  for (uint32_t i=0; (i<50000000L) && (NumFrames < NumMax); i++)
+  {
+    Schedule.handler();
+    while (LIN.readResult(result))
+      record(result.id, result.error);
+  }
+}
+
+
+// retries: immediate and in next slot
+static void testRetry(uint8_t Queues)
+{
+  static uint8_t                        data[2] = {0x01, 0x02};
+  const LIN_Master_Schedule::slot_t     table[] = {
+    { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 2, NULL, 10000, NULL, 0, 2, LIN_Master_Schedule::RETRY_IMMEDIATE, 0 },
+    { LIN_Master::MASTER_REQUEST, LIN_Master::LIN_V2, 0x20, 2, data, 10000, NULL, 0, 1, LIN_Master_Schedule::RETRY_NEXT_SLOT, 0 },
+    { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x11, 2, NULL, 10000, NULL, 0, 0, LIN_Master_Schedule::RETRY_IMMEDIATE, 0 }
+  };
+
+  setup(Queues, table, 3);
+  LIN.fails[0x10] = 2;
+  LIN.fails[0x20] = 1;
+  LIN.fails[0x11] = 1;
+  if (Queues == QUEUE_NONE)
+  {
+    // callback only reports final result after retries
+    run(12);
+    CHECK(strcmp(Sequence, "10 20 11E 10 20 11 10 20 11 10 20 11") == 0);
+    CHECK_EQ(LIN.starts[0x10], 6);
+    CHECK_EQ(LIN.starts[0x20], 5);
+    CHECK_EQ(LIN.starts[0x11], 4);
+  }
+  else
+  {
+    // queues report each attempt
+    run(12);
+    CHECK(strcmp(Sequence, "10E 10E 10 20E 20 11E 10 20 11 10 20 11") == 0);
+    CHECK_EQ(LIN.starts[0x10], 5);
+    CHECK_EQ(LIN.starts[0x20], 4);
+    CHECK_EQ(LIN.starts[0x11], 3);
+  }
+  CHECK_EQ(NumErrorState, 0);
+
+  // absent slave: retries exhausted in each cycle
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 0);
+  setup(Queues, table, 3);
+  run(9);
+  if (Queues == QUEUE_NONE)
+    CHECK(strcmp(Sequence, "10E 20 11 10E 20 11 10E 20 11") == 0);
+  else
+    CHECK(strcmp(Sequence, "10E 10E 10E 20 11 10E 10E 10E 20") == 0);
+  CHECK_EQ(LIN.starts[0x10], (Queues == QUEUE_NONE) ? 9 : 6);
+  CHECK_EQ(NumErrorState, 0);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 2);
+
+} // testRetry()
+
+
+// event triggered frame: collision is resolved via associated slave responses
+static void testCollision(uint8_t Queues)
+{
+  const LIN_Master_Schedule::slot_t     doors[] = {
+    { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 2, NULL, 10000, NULL, 0, 0, LIN_Master_Schedule::RETRY_IMMEDIATE, 0 },
+    { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x11, 2, NULL, 10000, NULL, 0, 0, LIN_Master_Schedule::RETRY_IMMEDIATE, 0 }
+  };
+  const LIN_Master_Schedule::slot_t     table[] = {
+    { LIN_Master::EVENT_TRIGGERED, LIN_Master::LIN_V2, 0x3A, 2, NULL, 10000, doors, 2, 0, LIN_Master_Schedule::RETRY_IMMEDIATE, 0 },
+    { LIN_Master::SLAVE_RESPONSE,  LIN_Master::LIN_V2, 0x12, 2, NULL, 10000, NULL, 0, 0, LIN_Master_Schedule::RETRY_IMMEDIATE, 0 }
+  };
+  uint8_t   data[2];
+
+  // collision is emulated by a response with classic checksum
+  data[0] = LIN_Master::calculatePID(0x10);
+  data[1] = 0x01;
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V1, 0x3A, 2, data);
+  setup(Queues, table, 2);
+  run(8);
+  CHECK(strcmp(Sequence, "3AC 10 11 12 3AC 10 11 12") == 0);
+  CHECK_EQ(NumErrorState, 0);
+
+  // single response: no resolution
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x3A, 2, data);
+  setup(Queues, table, 2);
+  run(4);
+  CHECK(strcmp(Sequence, "3A 12 3A 12") == 0);
+  CHECK_EQ(NumErrorState, 0);
+
+} // testCollision()
+
+
+// absent slave with adaptive timeouts: backoff skips LIN_BACKOFF_SKIP slots, independent of retries
+static void testBackoff(uint8_t Queues)
+{
+  static LIN_Master::response_t         responses[64];
+  const LIN_Master_Schedule::slot_t     table[] = {
+    { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 2, NULL, 10000, NULL, 0, LIN_BACKOFF_TIMEOUTS, LIN_Master_Schedule::RETRY_IMMEDIATE, 0 },
+    { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x11, 2, NULL, 10000, NULL, 0, 0, LIN_Master_Schedule::RETRY_IMMEDIATE, 0 }
+  };
+  LIN_Master::result_t  result;
+  uint32_t              cycle = 0;
+  uint32_t              numStarts = 0;
+  uint32_t              numWrong = 0;
+
+  // slave 0x10 absent. Cycle 1: backoff starts on last timeout, further retry is suppressed. Then per period
+  // LIN_BACKOFF_SKIP skipped slots and one attempt, which restarts the backoff
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 0);
+  setup(Queues, table, 2);
+  LIN.attachResponseTable(responses);
+  while (cycle < 3 * (LIN_BACKOFF_SKIP + 1) + 1)
+  {
+    Schedule.handler();
+    while (LIN.readResult(result))
+      record(result.id, result.error);
+
+    // slot 0x11 marks end of cycle. Slot 0x10 is only started in cycles 1, 1+(SKIP+1), ...
+    if (LIN.starts[0x11] != cycle)
+    {
+      cycle = LIN.starts[0x11];
+      if ((cycle - 1) % (LIN_BACKOFF_SKIP + 1) == 0)
+        numStarts += (cycle == 1) ? LIN_BACKOFF_TIMEOUTS : 1;
+      if (LIN.starts[0x10] != numStarts)
+        numWrong++;
+    }
+  }
+  CHECK_EQ(numWrong, 0);
+  CHECK_EQ(LIN.starts[0x10], LIN_BACKOFF_TIMEOUTS + 3);
+  CHECK_EQ(NumErrorState, 0);
+  LIN.attachResponseTable(NULL);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 2);
+
+} // testBackoff()
+
+
+// long run with random timeouts: retried slot is repeated until success or retries exhausted
+static void testRun(uint8_t Queues)
+{
+  const LIN_Master_Schedule::slot_t     table[] = {
+    { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 2, NULL, 0, NULL, 0, 2, LIN_Master_Schedule::RETRY_IMMEDIATE, 0 },
+    { LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x11, 2, NULL, 0, NULL, 0, 0, LIN_Master_Schedule::RETRY_IMMEDIATE, 0 }
+  };
+  LIN_Master::result_t  result;
+  uint32_t              numMax = TEST_NUM_FRAMES;
+  uint32_t              numWrong = 0;
+  uint8_t               idLast = 0x11;
+  uint8_t               attempt = 0;
+  bool                  errorLast = false;
+
+  setup(Queues, table, 2);
+  LIN.setTiming(false);
+  LIN.begin(19200);
+  LIN.setFaults(LIN_Master_Sim::FAULT_TIMEOUT, 8192, 4711);
+  while (NumFrames < numMax)
+  {
+    uint32_t              numFrames = NumFrames;
+    uint8_t               id;
+    LIN_Master::error_t   error;
+
+    // wait for next finished frame
+    Schedule.handler();
+    if (Queues != QUEUE_NONE)
+    {
+      if (LIN.readResult(result))
+        record(result.id, result.error);
+    }
+    if (NumFrames == numFrames)
+      continue;
+    id    = IdLast;
+    error = ErrorLast;
+
+    // slot 0x10: after an error the same frame follows, up to 2 retries. Otherwise next slot follows.
+    // Without queues only the final result after retries is reported
+    if ((Queues != QUEUE_NONE) && (idLast == 0x10) && errorLast && (attempt < 2))
+    {
+      if (id != 0x10)
+        numWrong++;
+      attempt++;
+    }
+    else
+    {
+      if (id != ((idLast == 0x10) ? 0x11 : 0x10))
+        numWrong++;
+      attempt = 0;
+    }
+    idLast    = id;
+    errorLast = (error != LIN_Master::NO_ERROR);
+  }
+  CHECK(LIN.getNumFaults() > 0);
+  LIN.setFaults(LIN_Master_Sim::NO_FAULT, 0);
+  CHECK_EQ(numWrong, 0);
+  CHECK_EQ(NumErrorState, 0);
+  CHECK(LIN.starts[0x10] + LIN.starts[0x11] >= numMax);
+
+} // testRun()
+
+
+// run tests
+int main()
+{
+  uint8_t   data[8] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+
+  // emulated slaves: responses 0x10..0x12, request 0x20
+  memset(Slaves, 0, sizeof(Slaves));
+  LIN.attachTable(Slaves);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x10, 2, data);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x11, 2, data+2);
+  LIN.setFrame(LIN_Master::SLAVE_RESPONSE, LIN_Master::LIN_V2, 0x12, 2, data+4);
+  LIN.setFrame(LIN_Master::MASTER_REQUEST, LIN_Master::LIN_V2, 0x20, 2);
+
+  for (uint8_t queues=QUEUE_NONE; queues<=QUEUE_JOB; queues++)
+  {
+    testRetry(queues);
+    testCollision(queues);
+    testBackoff(queues);
+    testRun(queues);
+  }
+
+  return testSummary("test_schedule");
+
+} // main()
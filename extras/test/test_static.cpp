@@ -0,0 +1,182 @@
+/**
+  \file     test_static.cpp
+  \brief    Host tests of compile-time configured LIN master LIN_Master_Static
+  \details  Uses LIN_Master_Static_HardwareSerial with a serial class, which echoes all sent bytes and appends the
+            response of an emulated slave after a slave response header. Checks frames, errors and the job queue,
+            in particular that a full queue drops new frames without affecting the ongoing frame.
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "test.h"
+#include "LIN_master_Static.h"
+
+
+// serial interface with echo and emulated slave for ID 0x11
+class EchoSerial
+{
+  public:
+    uint8_t     rx[256];              // received bytes (ring buffer)
+    uint8_t     head = 0;
+    uint8_t     tail = 0;
+    uint8_t     response[3];          // response of slave 0x11 incl. checksum
+    bool        respond = true;       // slave 0x11 present
+    bool        corrupt = false;      // corrupt echo of PID
+
+    void begin(unsigned long Baudrate) { (void) Baudrate; }
+    void end(void) { }
+    void flush(void) { }
+    operator bool() { return true; }
+    int available(void) { return (uint8_t) (head - tail); }
+    int read(void) { return (head != tail) ? rx[tail++] : -1; }
+    size_t write(uint8_t Byte) { rx[head++] = Byte; return 1; }
+    size_t write(const uint8_t Data[], size_t Num)
+    {
+      for (size_t i=0; i<Num; i++)
+        rx[head++] = ((i == 1) && corrupt) ? (Data[i] ^ 0x01) : Data[i];
+      if ((Num == 2) && (Data[1] == LIN_Master::calculatePID(0x11)) && respond)
+      {
+        for (uint8_t i=0; i<sizeof(response); i++)
+          rx[head++] = response[i];
+      }
+      return Num;
+    }
+};
+
+
+// LIN nodes: with statistics and job queue, and minimal
+typedef LIN_Master_Static_HardwareSerial<4, LIN_FEATURE_STATS, 4, EchoSerial>   LIN_Node;
+static EchoSerial                                         Interface;
+static LIN_Node                                           LIN(Interface);
+static LIN_Master_Static_HardwareSerial<2, 0, 0, EchoSerial>  Tiny(Interface);
+
+// finished frames
+static uint32_t   NumDone;
+static uint32_t   NumErrors;
+
+
+// called when frame is finished
+static void frameDone(LIN_Node &Node)
+{
+  NumDone++;
+  if (Node.getError() != LIN_Master::NO_ERROR)
+    NumErrors++;
+}
+
+
+// blocking frames and frame errors
+static void testFrames(void)
+{
+  uint8_t   tx[2] = {0x01, 0x02};
+  uint8_t   rx[4];
+
+  CHECK_EQ(LIN.sendMasterRequestBlocking(LIN_Master::LIN_V2, 0x10, 2, tx), LIN_Master::NO_ERROR);
+  CHECK_EQ(LIN.receiveSlaveResponseBlocking(LIN_Master::LIN_V2, 0x11, 2, rx), LIN_Master::NO_ERROR);
+  CHECK((rx[0] == Interface.response[0]) && (rx[1] == Interface.response[1]));
+
+  Interface.response[2] ^= 0x01;
+  CHECK_EQ(LIN.receiveSlaveResponseBlocking(LIN_Master::LIN_V2, 0x11, 2, rx), LIN_Master::ERROR_CHK);
+  Interface.response[2] ^= 0x01;
+
+  Interface.respond = false;
+  CHECK_EQ(LIN.receiveSlaveResponseBlocking(LIN_Master::LIN_V2, 0x11, 2, rx), LIN_Master::ERROR_TIMEOUT);
+  Interface.respond = true;
+
+  Interface.corrupt = true;
+  CHECK_EQ(LIN.sendMasterRequestBlocking(LIN_Master::LIN_V2, 0x10, 2, tx), LIN_Master::ERROR_ECHO);
+  Interface.corrupt = false;
+
+  // minimal node: too long frame is rejected
+  Tiny.begin(9600);
+  CHECK_EQ(Tiny.sendMasterRequestBlocking(LIN_Master::LIN_V1, 0x05, 2, tx), LIN_Master::NO_ERROR);
+  CHECK_EQ(Tiny.sendMasterRequestBlocking(LIN_Master::LIN_V1, 0x05, 3, tx), LIN_Master::ERROR_STATE);
+
+} // testFrames()
+
+
+// full job queue: new frames are dropped, ongoing and queued frames are finished
+static void testQueueFull(void)
+{
+  uint8_t   tx[2] = {0x03, 0x04};
+
+  NumDone   = 0;
+  NumErrors = 0;
+  LIN.resetLostJobs();
+  CHECK_EQ(LIN.freeJobs(), 3);
+
+  // 1 frame on bus, 3 queued, 2 dropped
+  CHECK_EQ(LIN.receiveSlaveResponse(LIN_Master::LIN_V2, 0x11, 2), LIN_Master::STATE_BREAK);
+  LIN.sendMasterRequest(LIN_Master::LIN_V2, 0x01, 2, tx);
+  LIN.sendMasterRequest(LIN_Master::LIN_V2, 0x02, 2, tx);
+  LIN.receiveSlaveResponse(LIN_Master::LIN_V2, 0x11, 2);
+  CHECK_EQ(LIN.freeJobs(), 0);
+  LIN.sendMasterRequest(LIN_Master::LIN_V2, 0x03, 2, tx);
+  LIN.receiveSlaveResponse(LIN_Master::LIN_V2, 0x11, 2);
+  CHECK_EQ(LIN.getLostJobs(), 2);
+  CHECK_EQ(LIN.getState(), LIN_Master::STATE_BREAK);
+  CHECK_EQ(NumDone, 0);
+
+  // all frames finish without error
+  for (uint16_t i=0; (i<1000) && (NumDone < 4); i++)
+    LIN.handler();
+  CHECK_EQ(NumDone, 4);
+  CHECK_EQ(NumErrors, 0);
+  CHECK_EQ(LIN.getState(), LIN_Master::STATE_IDLE);
+
+} // testQueueFull()
+
+
+// long run with random bursts: each frame is finished or counted as lost
+static void testQueueRun(void)
+{
+  uint8_t   tx[2] = {0x05, 0x06};
+  uint32_t  seed = 11;
+  uint32_t  numSent = 0;
+  uint32_t  numLost = 0;
+
+  NumDone   = 0;
+  NumErrors = 0;
+  LIN.resetLostJobs();
+  for (uint32_t i=0; i<TEST_NUM_FRAMES; i++)
+  {
+    seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+    if ((seed & 0x03) == 0)
+    {
+      for (uint8_t j=0; j<((seed >> 4) & 0x07); j++)
+      {
+        if (j & 0x01)
+          LIN.sendMasterRequest(LIN_Master::LIN_V2, 0x01, 2, tx);
+        else
+          LIN.receiveSlaveResponse(LIN_Master::LIN_V2, 0x11, 2);
+        numSent++;
+      }
+    }
+    LIN.handler();
+    numLost += LIN.getLostJobs();
+    LIN.resetLostJobs();
+  }
+  while ((LIN.getState() != LIN_Master::STATE_IDLE) || (LIN.freeJobs() != 3))
+    LIN.handler();
+  CHECK(numLost > 0);
+  CHECK_EQ(NumDone + numLost, numSent);
+  CHECK_EQ(NumErrors, 0);
+
+} // testQueueRun()
+
+
+// run tests
+int main()
+{
+  Interface.response[0] = 0xA5;
+  Interface.response[1] = 0x5A;
+  Interface.response[2] = LIN_Master::calculateChecksum(LIN_Master::LIN_V2, 0x11, 2, Interface.response);
+
+  LIN.begin(19200);
+  testFrames();
+  LIN.attachCallback(frameDone);
+  testQueueFull();
+  testQueueRun();
+
+  return testSummary("test_static");
+
+} // main()
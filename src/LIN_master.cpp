@@ -11,72 +11,33 @@
 
 
 /**************************
- * PROTECTED METHODS
+ * PROTECTED VARIABLES
 **************************/
 
-/**
-  \brief      Calculate protected frame ID
-  \details    Calculate protected frame ID as described in LIN2.0 spec "2.3.1.3 Protected identifier field"
-  \return     Protected frame ID
-*/
-uint8_t LIN_Master::_calculatePID(void)
-{
-  uint8_t  pid;       // protected frame ID
-  uint8_t  tmp;       // temporary variable for calculating parity bits
-
-  // copy (unprotected) ID
-  pid = this->id;
-
-  // protect ID  with parity bits
-  pid  = (uint8_t) (pid & 0x3F);                                            // clear upper bits 6 & 7
-  tmp  = (uint8_t) ((pid ^ (pid>>1) ^ (pid>>2) ^ (pid>>4)) & 0x01);         // pid[6] = PI0 = ID0^ID1^ID2^ID4
-  pid |= (uint8_t) (tmp << 6);
-  tmp  = (uint8_t) (~((pid>>1) ^ (pid>>3) ^ (pid>>4) ^ (pid>>5)) & 0x01);   // pid[7] = PI1 = ~(ID1^ID3^ID4^ID5)
-  pid |= (uint8_t) (tmp << 7);
-
-  // return protected ID
-  return pid;
-
-} // LIN_Master::_calculatePID()
-
-
-
-/**
-  \brief      Calculate LIN frame checksum
-  \details    Calculate LIN frame checksum as described in LIN1.x / LIN2.x specs
-  \param[in]  NumData   number of data bytes in frame
-  \param[in]  Data      frame data bytes
-  \return     calculated checksum, depending on protocol version
-*/
-uint8_t LIN_Master::_calculateChecksum(uint8_t NumData, uint8_t Data[])
+/// protected frame IDs (incl. parity bits) as described in LIN2.0 spec "2.3.1.3 Protected identifier field"
+const uint8_t LIN_Master::tablePID[64] PROGMEM =
 {
-  uint8_t  pid;       // protected frame ID
-  uint16_t chk=0x00;
-
-  // calculate protected frame ID
-  pid = this->_calculatePID();
+  0x80, 0xC1, 0x42, 0x03, 0xC4, 0x85, 0x06, 0x47,    // ID 0x00..0x07
+  0x08, 0x49, 0xCA, 0x8B, 0x4C, 0x0D, 0x8E, 0xCF,    // ID 0x08..0x0F
+  0x50, 0x11, 0x92, 0xD3, 0x14, 0x55, 0xD6, 0x97,    // ID 0x10..0x17
+  0xD8, 0x99, 0x1A, 0x5B, 0x9C, 0xDD, 0x5E, 0x1F,    // ID 0x18..0x1F
+  0x20, 0x61, 0xE2, 0xA3, 0x64, 0x25, 0xA6, 0xE7,    // ID 0x20..0x27
+  0xA8, 0xE9, 0x6A, 0x2B, 0xEC, 0xAD, 0x2E, 0x6F,    // ID 0x28..0x2F
+  0xF0, 0xB1, 0x32, 0x73, 0xB4, 0xF5, 0x76, 0x37,    // ID 0x30..0x37
+  0x78, 0x39, 0xBA, 0xFB, 0x3C, 0x7D, 0xFE, 0xBF     // ID 0x38..0x3F
+};
 
-  // LIN2.x uses extended checksum which includes protected ID, i.e. including parity bits
-  // LIN1.x uses classical checksum only over data bytes
-  // Diagnostic frames with ID 0x3C and 0x3D/0x7D always use classical checksum (see LIN spec "2.3.1.5 Checkum")
-  if (!((this->version == LIN_V1) || (pid == 0x3C) || (pid == 0x7D)))    // if version 2  & no diagnostic frames (0x3C=60 (PID=0x3C) or 0x3D=61 (PID=0x7D))
-    chk = (uint16_t) pid;
-
-  // loop over data bytes
-  for (uint8_t i = 0; i < NumData; i++)
-  {
-    chk += (uint16_t) (Data[i]);
-    if (chk>255)
-      chk -= 255;
-  }
-  chk = (uint8_t)(0xFF - ((uint8_t) chk));   // bitwise invert
 
-  // return frame checksum
-  return (uint8_t) chk;
+// compact profile: check RAM usage of base class (AVR: 2B pointers and enums). Derived classes add their interface data
+#if defined(LIN_MASTER_COMPACT) && defined(__AVR__) && !defined(LIN_MASTER_STATS)
+  static_assert(sizeof(LIN_Master) <= LIN_MASTER_RAM_COMPACT, "LIN_Master exceeds RAM of compact profile, see LIN_MASTER_RAM_COMPACT");
+#endif
 
-} // LIN_Master::_calculateChecksum()
 
 
+/**************************
+ * PROTECTED METHODS
+**************************/
 
 /**
   \brief      Check received LIN frame
@@ -110,8 +71,12 @@ LIN_Master::error_t LIN_Master::_checkFrame(void)
     if (this->bufTx[i] != this->bufRx[i])
       return LIN_Master::ERROR_ECHO;
 
-  // check frame checksum
-  if (this->bufRx[lenRx-1] != _calculateChecksum(this->lenRx-4, this->bufRx+3))
+  // check frame checksum. For master request checksum is already covered by echo check
+  if ((this->type != LIN_Master::MASTER_REQUEST) && (this->bufRx[lenRx-1] != _calculateChecksum(this->lenRx-4, this->bufRx+3)))
+    return LIN_Master::ERROR_CHK;
+
+  // event triggered frame: first data byte is PID of the responding unconditional frame. Invalid PID -> collision
+  if ((this->type == LIN_Master::EVENT_TRIGGERED) && (this->bufRx[3] != LIN_Master::calculatePID(this->bufRx[3])))
     return LIN_Master::ERROR_CHK;
 
   // return result of check
@@ -121,6 +86,411 @@ LIN_Master::error_t LIN_Master::_checkFrame(void)
 
 
 
+/**
+  \brief      Set timeout of slave response frame from learned response time
+  \details    Set timeout of current slave response frame to 125% of the learned max. frame duration, bounded
+              by nominal frame duration + 1 byte and the fixed timeout (150% nominal). For an absent slave,
+              i.e. after LIN_BACKOFF_TIMEOUTS consecutive timeouts, the lower bound is used for early detection
+*/
+void LIN_Master::_adaptTimeout(void)
+{
+  LIN_Master::response_t  *pEntry = this->tableResponse + (this->id & 0x3F);
+  uint32_t                timeMin = (uint32_t) (this->lenRx + 2) * this->timePerByte;
+  uint32_t                timeAdapt;
+
+  // absent slave -> min. timeout
+  if (pEntry->numTimeout >= LIN_BACKOFF_TIMEOUTS)
+    timeAdapt = timeMin;
+
+  // response time not yet learned -> keep fixed timeout
+  else if (pEntry->timeFrame == 0)
+    return;
+
+  // 125% of learned response time
+  else
+    timeAdapt = LIN_Master_Timebase::usToTicks((uint32_t) pEntry->timeFrame + (pEntry->timeFrame >> 2));
+
+  // limit to bounds
+  if (timeAdapt < timeMin)
+    timeAdapt = timeMin;
+  if (timeAdapt < this->timeMax)
+    this->timeMax = (LIN_Master::ticks_t) timeAdapt;
+
+} // LIN_Master::_adaptTimeout()
+
+
+
+/**
+  \brief      Learn response time of finished slave response frame
+  \details    Learn max. duration of error-free frames per ID. The learned value follows increases instantly and
+              decreases slowly (1/16 per frame). Timeouts are counted and start a backoff, see skipFrame()
+*/
+void LIN_Master::_learnResponse(void)
+{
+  LIN_Master::response_t  *pEntry = this->tableResponse + (this->id & 0x3F);
+  uint32_t                dt;
+
+  // error-free frame -> update learned duration and end backoff
+  if (this->error == LIN_Master::NO_ERROR)
+  {
+    dt = LIN_Master_Timebase::ticksToUs(this->_elapsed());
+    if (dt > 0xFFFF)
+      dt = 0xFFFF;
+    if ((pEntry->timeFrame == 0) || (dt > pEntry->timeFrame))
+      pEntry->timeFrame = (uint16_t) dt;
+    else
+      pEntry->timeFrame -= (pEntry->timeFrame - (uint16_t) dt) >> 4;
+    pEntry->numTimeout = 0;
+    pEntry->numSkip    = 0;
+  }
+
+  // timeout -> count and start backoff (again)
+  else if (this->error & LIN_Master::ERROR_TIMEOUT)
+  {
+    if (pEntry->numTimeout < 255)
+      pEntry->numTimeout++;
+    if (pEntry->numTimeout >= LIN_BACKOFF_TIMEOUTS)
+      pEntry->numSkip = LIN_BACKOFF_SKIP;
+  }
+
+} // LIN_Master::_learnResponse()
+
+
+
+/**
+  \brief      Getter for cache entry of an ID
+  \details    Getter for last-value cache entry of an ID via linear search, see attachChangeCache()
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \return     cache entry, or NULL if ID is not subscribed
+*/
+LIN_Master::cache_t *LIN_Master::_findCache(uint8_t Id)
+{
+  // search subscribed IDs
+  Id &= 0x3F;
+  for (uint8_t i=0; i<this->sizeCache; i++)
+  {
+    if (this->tableCache[i].id == Id)
+      return this->tableCache + i;
+  }
+
+  // ID not subscribed
+  return NULL;
+
+} // LIN_Master::_findCache()
+
+
+
+/**
+  \brief      Update last-value cache with finished slave response
+  \details    Compare error-free slave response with cached data of its ID. On change, store new data and
+              accumulate changed bits in the dirty mask. A subscriber is called directly, afterwards the change
+              is cleared. Without subscriber the change is kept until readChanges(). The first frame of an ID and
+              a changed length count as change of all bits. For event triggered frames the data is cached under
+              the ID of the responding unconditional frame (first data byte)
+*/
+void LIN_Master::_updateCache(void)
+{
+  LIN_Master::cache_t   *pEntry;
+  uint8_t               numData = this->lenRx - 4;
+  const uint8_t         *data = this->bufRx + 3;
+  uint8_t               sum = 0;
+
+  // find subscribed ID. Event triggered frame -> ID of responding frame
+  pEntry = this->_findCache((this->type == LIN_Master::EVENT_TRIGGERED) ? data[0] : this->id);
+  if (pEntry == NULL)
+    return;
+
+  // first frame or changed length -> all bits changed
+  if (pEntry->numData != numData)
+  {
+    memset(pEntry->diff, 0xFF, numData);
+    memcpy(pEntry->data, data, numData);
+    pEntry->numData = numData;
+    sum = 0xFF;
+  }
+
+  // compare with cached data and accumulate changed bits
+  else
+  {
+    for (uint8_t i=0; i<numData; i++)
+    {
+      uint8_t   diff = pEntry->data[i] ^ data[i];
+      pEntry->diff[i] |= diff;
+      pEntry->data[i]  = data[i];
+      sum |= diff;
+    }
+  }
+
+  // data unchanged -> no notification
+  if (sum == 0)
+    return;
+  pEntry->numChanges++;
+  pEntry->changed = true;
+
+  // notify subscriber, then clear change
+  if (pEntry->callback != NULL)
+  {
+    pEntry->callback(*this, *pEntry);
+    memset(pEntry->diff, 0x00, sizeof(pEntry->diff));
+    pEntry->changed = false;
+  }
+
+} // LIN_Master::_updateCache()
+
+
+
+/**
+  \brief      Copy current frame into result record
+  \details    Copy current frame into result record incl. error and timestamp
+  \param[out] Result    frame record
+*/
+void LIN_Master::_getResult(LIN_Master::result_t &Result)
+{
+  // copy frame properties
+  Result.type      = this->type;
+  Result.id        = this->id;
+  Result.numData   = this->lenRx - 4;                         // excl. BREAK, SYNC, ID, CHK
+  memcpy(Result.data, this->bufRx+3, Result.numData);
+  Result.error     = this->error;
+  Result.timestamp = micros();
+
+} // LIN_Master::_getResult()
+
+
+
+/**
+  \brief      Append binary record of current frame to trace buffer
+  \details    Append packed binary record of finished frame to trace ring buffer. Record format (multi-byte values little endian):
+              LIN_TRACE_SYNC, record length [B], frame start [us] (4B), frame duration [us] (2B), timeout [us] (2B),
+              type | version<<4, PID, error, data bytes, checksum byte, XOR of all previous record bytes.
+              Durations are saturated at 65535us. If the record doesn't fit, it is discarded and counted as lost.
+              For a host decoder see extras/LIN_Trace/lintrace.py
+*/
+void LIN_Master::_traceFrame(void)
+{
+  uint8_t   record[LIN_TRACE_HEADER + 8 + 2];
+  uint8_t   numData = this->lenRx - 4;
+  uint8_t   len = LIN_TRACE_HEADER + numData + 2;
+  uint32_t  dt = LIN_Master_Timebase::ticksToUs(this->_elapsed());
+  uint32_t  timeFrame = micros() - dt;                        // frame start [us], independent of time base
+  uint32_t  timeout = LIN_Master_Timebase::ticksToUs(this->timeMax);
+  uint16_t  head = this->headTrace;
+  uint16_t  tail = this->tailTrace;                           // only written by application
+  uint16_t  space;
+  uint8_t   chk = 0;
+
+  // check free space. One byte is reserved to distinguish full from empty buffer
+  space = (tail > head) ? (tail - head - 1) : (this->sizeTrace - 1 - head + tail);
+  if (len > space)
+  {
+    if (this->lostTrace < 255)
+      this->lostTrace++;
+    return;
+  }
+
+  // assemble record
+  if (dt > 0xFFFF)
+    dt = 0xFFFF;
+  record[0]  = LIN_TRACE_SYNC;
+  record[1]  = len;
+  record[2]  = (uint8_t) (timeFrame);
+  record[3]  = (uint8_t) (timeFrame >> 8);
+  record[4]  = (uint8_t) (timeFrame >> 16);
+  record[5]  = (uint8_t) (timeFrame >> 24);
+  record[6]  = (uint8_t) (dt);
+  record[7]  = (uint8_t) (dt >> 8);
+  record[8]  = (timeout > 0xFFFF) ? 0xFF : (uint8_t) (timeout);
+  record[9]  = (timeout > 0xFFFF) ? 0xFF : (uint8_t) (timeout >> 8);
+  record[10] = (uint8_t) this->type | ((uint8_t) this->version << 4);
+  record[11] = this->bufTx[2];                                // sent PID
+  record[12] = (uint8_t) this->error;
+  memcpy(record + LIN_TRACE_HEADER, this->bufRx + 3, numData + 1);
+  for (uint8_t i=0; i<len-1; i++)
+    chk ^= record[i];
+  record[len-1] = chk;
+
+  // copy record into ring buffer
+  for (uint8_t i=0; i<len; i++)
+  {
+    this->bufTrace[head] = record[i];
+    if (++head >= this->sizeTrace)
+      head = 0;
+  }
+
+  // publish record
+  LIN_MEMORY_BARRIER();                                       // write record before publishing it
+  this->headTrace = head;
+
+} // LIN_Master::_traceFrame()
+
+
+
+#if defined(LIN_MASTER_STATS)
+
+/**
+  \brief      Update statistics at end of BREAK
+  \details    Update statistics at end of BREAK, i.e. at transition STATE_BREAK -> STATE_BODY. Duration includes
+              handler() polling latency
+*/
+void LIN_Master::_statsBreak(void)
+{
+  uint32_t  dt;
+
+  // store end of BREAK for response time
+  this->timeBody = (LIN_Master::ticks_t) LIN_Master_Timebase::getTicks();
+  dt = LIN_Master_Timebase::ticksToUs((LIN_Master::ticks_t) (this->timeBody - this->timeStart));
+
+  // update BREAK statistics
+  this->stats.numBreak++;
+  this->stats.timeBreakSum += dt;
+  if (dt < this->stats.timeBreakMin)
+    this->stats.timeBreakMin = dt;
+  if (dt > this->stats.timeBreakMax)
+    this->stats.timeBreakMax = dt;
+
+} // LIN_Master::_statsBreak()
+
+
+
+/**
+  \brief      Update statistics at end of frame
+  \details    Update frame and error statistics at end of frame. Response time is only updated for error-free frames
+*/
+void LIN_Master::_statsFrame(void)
+{
+  uint32_t  timeNow = LIN_Master_Timebase::getTicks();
+  uint32_t  dt;
+
+  // update frame statistics
+  this->stats.numFrames++;
+  this->stats.timeBusy += LIN_Master_Timebase::ticksToUs((LIN_Master::ticks_t) (timeNow - this->timeStart));
+
+  // update error statistics
+  if (this->error != LIN_Master::NO_ERROR)
+  {
+    this->stats.numErrors++;
+    if (this->error & LIN_Master::ERROR_ECHO)
+      this->stats.numErrorEcho++;
+    if (this->error & LIN_Master::ERROR_TIMEOUT)
+      this->stats.numErrorTimeout++;
+    if (this->error & LIN_Master::ERROR_CHK)
+      this->stats.numErrorChk++;
+    if (this->error & (LIN_Master::ERROR_STATE | LIN_Master::ERROR_MISC))
+      this->stats.numErrorOther++;
+  }
+
+  // error-free frame -> update response time, i.e. end of BREAK to end of frame
+  else
+  {
+    dt = LIN_Master_Timebase::ticksToUs((LIN_Master::ticks_t) (timeNow - this->timeBody));
+    this->stats.numResponse++;
+    this->stats.timeResponseSum += dt;
+    if (dt < this->stats.timeResponseMin)
+      this->stats.timeResponseMin = dt;
+    if (dt > this->stats.timeResponseMax)
+      this->stats.timeResponseMax = dt;
+  }
+
+} // LIN_Master::_statsFrame()
+
+#endif // LIN_MASTER_STATS
+
+
+
+/**
+  \brief      Frame finished, notify user
+  \details    Frame finished, i.e. STATE_DONE was reached. Store result in queue and call user callbacks (if attached).
+              The callbacks may read the frame, reset the state machine and start the next frame.
+              If a result queue is attached, state machine is reset afterwards, i.e. the next frame
+              can be started directly.
+*/
+void LIN_Master::_frameDone(void)
+{
+  LIN_Master::result_t  result;
+  uint8_t               head;
+
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master::_frameDone()");
+  #endif
+
+  // update statistics before callbacks may start next frame
+  #if defined(LIN_MASTER_STATS)
+    this->_statsFrame();
+  #endif
+
+  // for bus idle timeout
+  this->timeActivity = millis();
+
+  // learn slave response time for adaptive timeout
+  if ((this->tableResponse != NULL) && (this->type == LIN_Master::SLAVE_RESPONSE))
+    this->_learnResponse();
+
+  // store binary trace record
+  if (this->bufTrace != NULL)
+    this->_traceFrame();
+
+  // publish completed frame for zero-copy access. Write frame before publishing it
+  this->typeDone  = this->type;
+  this->idDone    = this->id;
+  this->lenDone   = this->lenRx;
+  this->errorDone = this->error;
+  this->idxDone   = this->idxRx;
+  LIN_MEMORY_BARRIER();
+  this->seqDone++;
+
+  // update last-value cache and notify subscribers on change
+  if ((this->tableCache != NULL) && (this->error == LIN_Master::NO_ERROR) && (this->type != LIN_Master::MASTER_REQUEST))
+    this->_updateCache();
+
+  // store result in queue and/or pass to frame callback
+  if ((this->queueResult != NULL) || (this->callbackFrame != NULL))
+  {
+    this->_getResult(result);
+
+    // store in queue. On overflow discard newest result
+    if (this->queueResult != NULL)
+    {
+      head = this->headResult + 1;
+      if (head >= this->sizeResult)
+        head = 0;
+      if (head != this->tailResult)
+      {
+        this->queueResult[this->headResult] = result;
+        LIN_MEMORY_BARRIER();                                 // write record before publishing it
+        this->headResult = head;
+      }
+      else if (this->lostResults < 255)
+        this->lostResults++;
+    }
+
+    // call frame callback
+    if (this->callbackFrame != NULL)
+      this->callbackFrame(result);
+
+  } // result required
+
+  // call user callback
+  if (this->callback != NULL)
+    this->callback(*this);
+
+  // if result or job queue is used and no new frame was started by callback -> release state machine.
+  // Error is cleared when next frame is started, e.g. for blocking functions
+  if (((this->queueResult != NULL) || (this->queueJob != NULL)) && (this->state == LIN_Master::STATE_DONE))
+    this->state = LIN_Master::STATE_IDLE;
+
+  // go-to-sleep command finished and no new frame started by callback -> enter sleep mode
+  if (this->sleepPending)
+  {
+    this->sleepPending = false;
+    if ((this->state == LIN_Master::STATE_DONE) || (this->state == LIN_Master::STATE_IDLE))
+      this->state = LIN_Master::STATE_SLEEP;
+  }
+
+} // LIN_Master::_frameDone()
+
+
+
 /**
   \brief      Send LIN break
   \details    Send LIN break (=16bit low). Here dummy!
@@ -195,74 +565,111 @@ LIN_Master::state_t LIN_Master::_receiveFrame(void)
 
 
 
-/**************************
- * PUBLIC METHODS
-**************************/
+/**
+  \brief      Send wake-up pulse
+  \details    Send wake-up pulse (250us..5ms low). Here dummy!
+*/
+void LIN_Master::_sendWakeup(void)
+{
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master::_sendWakeup()");
+  #endif
+
+} // LIN_Master::_sendWakeup()
+
+
 
 /**
-  \brief      LIN master node constructor
-  \details    LIN master node constructor. Initialize class variables to default values.
-              For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
-  \param[in]  NameLIN     LIN node name 
+  \brief      Check for wake-up pulse from a slave
+  \details    Check for wake-up pulse from a slave while in sleep mode. Here dummy!
+  \return     true if a wake-up pulse was received
 */
-LIN_Master::LIN_Master(const char NameLIN[])
+bool LIN_Master::_receiveWakeup(void)
 {
-  // store parameters in class variables
-  memcpy(this->nameLIN, NameLIN, BUFLEN_NAME);                // node name e.g. for debug
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master::_receiveWakeup()");
+  #endif
 
-  // initialize master node properties
-  this->error = LIN_Master::NO_ERROR;                         // last LIN error. Is latched
-  this->state = LIN_Master::STATE_OFF;                        // status of LIN state machine
+  // no wake-up pulse detected
+  return false;
 
-} // LIN_Master::LIN_Master()
+} // LIN_Master::_receiveWakeup()
 
 
 
 /**
-  \brief      Open serial interface
-  \details    Open serial interface with specified baudrate. Here dummy!
-  \param[in]  Baudrate    communication speed [Baud]
+  \brief      Apply changed baudrate to interface
+  \details    Apply changed baudrate to interface without re-opening it, see setBaudrate(). Here dummy, as most
+              interfaces switch baudrate for BREAK and restore this->baudrate in each frame anyway!
 */
-void LIN_Master::begin(uint16_t Baudrate)
+void LIN_Master::_setBaudrate(void)
 {
-  // store parameters in class variables
-  this->baudrate   = Baudrate;                                // communication baudrate [Baud]
-
-  // initialize master node properties
-  this->error = LIN_Master::NO_ERROR;                         // last LIN error. Is latched
-  this->state = LIN_Master::STATE_IDLE;                       // status of LIN state machine
-  this->timePerByte = 10000000L / (uint32_t) this->baudrate;  // time [us] per byte (for performance)
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master::_setBaudrate()");
+  #endif
 
-} // LIN_Master::begin()
+} // LIN_Master::_setBaudrate()
 
 
 
 /**
-  \brief      Close serial interface
-  \details    Close serial interface. Here dummy!
+  \brief      Getter for time per byte at a baudrate
+  \details    Getter for time per byte (10 bit) at a baudrate. The last LIN_BAUDRATE_CACHE used baudrates are cached,
+              i.e. switching between them requires no division
+  \param[in]  Baudrate    communication speed [Baud]
+  \return     time [ticks] per byte
 */
-void LIN_Master::end()
+LIN_Master::ticks_t LIN_Master::_getTimePerByte(uint16_t Baudrate)
 {
-  // initialize master node properties
-  this->state = LIN_Master::STATE_OFF;                        // status of LIN state machine
+  uint8_t   idx;
 
-} // LIN_Master::end()
+  // baudrate already cached
+  for (idx=0; idx<LIN_BAUDRATE_CACHE; idx++)
+  {
+    if (this->cacheBaudrate[idx] == Baudrate)
+      return this->cacheTimePerByte[idx];
+  }
+
+  // calculate and replace oldest entry
+  idx = this->idxCache;
+  this->cacheBaudrate[idx]    = Baudrate;
+  this->cacheTimePerByte[idx] = (LIN_Master::ticks_t) LIN_Master_Timebase::usToTicks(10000000L / (uint32_t) Baudrate);
+  if (++(this->idxCache) >= LIN_BAUDRATE_CACHE)
+    this->idxCache = 0;
+  return this->cacheTimePerByte[idx];
+
+} // LIN_Master::_getTimePerByte()
 
 
 
 /**
-  \brief      Start sending a LIN master request frame in background (if supported)
-  \details    Start sending a LIN master request frame in background (if supported). Background handling is handling by handler().
-              For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \brief      Start a LIN master request frame
+  \details    Start a LIN master request frame in background (if supported), bypassing the job queue.
   \param[in]  Version   LIN protocol version
   \param[in]  Id        frame idendifier (protected or unprotected)
   \param[in]  NumData   number of data bytes (0..8)
   \param[in]  Data      data bytes
+  \param[in]  Callback  optional function called when this frame is finished
   \return     LIN state machine state
 */
-LIN_Master::state_t LIN_Master::sendMasterRequest(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, uint8_t Data[])
+LIN_Master::state_t LIN_Master::_sendMasterRequest(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[], LIN_Master::callbackFrame_t Callback)
 {
+  // bus in sleep mode -> reject frame without leaving sleep mode
+  if ((this->state == LIN_Master::STATE_SLEEP) || (this->state == LIN_Master::STATE_WAKEUP))
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_STATE);
+    return this->state;
+  }
+
+  // with result or job queue, error is reported per frame -> clear latched error
+  if ((this->queueResult != NULL) || (this->queueJob != NULL))
+    this->error = LIN_Master::NO_ERROR;
+
   // construct Tx frame
+  this->callbackFrame = Callback;
   this->type     = LIN_Master::MASTER_REQUEST;
   this->version  = Version;
   this->id       = Id;
@@ -274,63 +681,55 @@ LIN_Master::state_t LIN_Master::sendMasterRequest(LIN_Master::version_t Version,
   this->bufTx[this->lenTx-1] = _calculateChecksum(NumData, Data);   // CHK
   this->lenRx    = this->lenTx;                                     // just receive LIN echo
 
-  // init receive buffer
+  // init receive buffer. Don't overwrite last completed frame
+  this->_selectBufRx();
   memset(this->bufRx, 0, 12);
+  this->numRx = 0;
 
   // set break timeout (= 150% nominal) and start timeout
-  this->timeStart = micros();
-  this->timeMax   = (((this->lenRx + 1) * this->timePerByte) * 3 ) >> 1;
+  this->timeStart = (LIN_Master::ticks_t) LIN_Master_Timebase::getTicks();
+  this->timeMax   = this->_frameTimeout(this->lenRx);
 
   // start LIN frame by sending a Sync Break
   this->_sendBreak();
 
+  // frame aborted (e.g. bus busy) -> notify user
+  if (this->state == LIN_Master::STATE_DONE)
+    this->_frameDone();
+
   // return state machine state
   return this->state;
 
-} // LIN_Master::sendMasterRequest()
+} // LIN_Master::_sendMasterRequest()
 
 
 
 /**
-  \brief      Send a blocking LIN master request frame (no background operation)
-  \details    Send a blocking LIN master request frame (no background operation).
-              For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \brief      Start a LIN slave response frame
+  \details    Start a LIN slave response frame in background (if supported), bypassing the job queue.
   \param[in]  Version   LIN protocol version
   \param[in]  Id        frame idendifier (protected or unprotected)
   \param[in]  NumData   number of data bytes (0..8)
-  \param[in]  Data      data bytes
-  \return     LIN error
+  \param[in]  Callback  optional function called when this frame is finished
+  \return     LIN state machine state
 */
-LIN_Master::error_t LIN_Master::sendMasterRequestBlocking(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, uint8_t Data[])
+LIN_Master::state_t LIN_Master::_receiveSlaveResponse(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, LIN_Master::callbackFrame_t Callback,
+  LIN_Master::frame_t Type)
 {
-  // start master request frame
-  this->sendMasterRequest(Version, Id, NumData, Data);
-  
-  // wait until frame is completed
-  do
-    this->handler();
-  while (this->state != LIN_Master::STATE_DONE);
-
-  // return LIN error
-  return this->error;
-
-} // LIN_Master::sendMasterRequestBlocking()
-
+  // bus in sleep mode -> reject frame without leaving sleep mode
+  if ((this->state == LIN_Master::STATE_SLEEP) || (this->state == LIN_Master::STATE_WAKEUP))
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_STATE);
+    return this->state;
+  }
 
+  // with result or job queue, error is reported per frame -> clear latched error
+  if ((this->queueResult != NULL) || (this->queueJob != NULL))
+    this->error = LIN_Master::NO_ERROR;
 
-/**
-  \brief      Send/receive a blocking LIN slave response frame (no background operation)
-  \details    Send/receive a blocking LIN slave response frame (no background operation).
-              For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
-  \param[in]  Version   LIN protocol version
-  \param[in]  Id        frame idendifier (protected or unprotected)
-  \param[in]  NumData   number of data bytes (0..8)
-  \return     LIN state machine state
-*/
-LIN_Master::state_t LIN_Master::receiveSlaveResponse(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData)
-{
   // construct Tx frame
-  this->type     = LIN_Master::SLAVE_RESPONSE;
+  this->callbackFrame = Callback;
+  this->type     = Type;                                            // slave response or event triggered
   this->version  = Version;
   this->id       = Id;
   this->lenTx    = 3;                                               // Frame header length
@@ -339,69 +738,1217 @@ LIN_Master::state_t LIN_Master::receiveSlaveResponse(LIN_Master::version_t Versi
   this->bufTx[2] = this->_calculatePID();                           // PID
   this->lenRx    = NumData + 4;                                     // receive LIN header echo + DATA[] + CHK
 
-  // init receive buffer
+  // init receive buffer. Don't overwrite last completed frame
+  this->_selectBufRx();
   memset(this->bufRx, 0, 12);
+  this->numRx = 0;
 
-  // set break timeout (= 150% nominal) and start timeout
-  this->timeMax   = (((this->lenRx + 1) * this->timePerByte) * 3 ) >> 1;
-  this->timeStart = micros();
+  // set break timeout (= 150% nominal, or learned response time) and start timeout
+  this->timeMax   = this->_frameTimeout(this->lenRx);
+  if (this->tableResponse != NULL)
+    this->_adaptTimeout();
+  this->timeStart = (LIN_Master::ticks_t) LIN_Master_Timebase::getTicks();
 
   // start LIN frame by sending BREAK
   this->_sendBreak();
 
+  // frame aborted (e.g. bus busy) -> notify user
+  if (this->state == LIN_Master::STATE_DONE)
+    this->_frameDone();
+
   // return state machine state
   return this->state;
 
-} // LIN_Master::sendMasterRequestBlocking()
+} // LIN_Master::_receiveSlaveResponse()
 
 
 
 /**
-  \brief      Send/receive a blocking LIN slave response frame (no background operation)
-  \details    Send/receive a blocking LIN slave response frame (no background operation).
-              For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
-  \param[in]  Version   LIN protocol version
-  \param[in]  Id        frame idendifier (protected or unprotected)
-  \param[in]  NumData   number of data bytes (0..8)
-  \param[out] Data      data bytes
+  \brief      Start oldest frame from job queue
+  \details    Start oldest frame from job queue (if any). Called by handler() when bus is idle
+*/
+void LIN_Master::_startJob(void)
+{
+  LIN_Master::job_t   *pJob;
+  uint8_t             tail;
+
+  // start queued frames until one is ongoing (start may fail immediately)
+  while ((this->state == LIN_Master::STATE_IDLE) && (this->tailJob != this->headJob))
+  {
+    // get oldest job
+    tail = this->tailJob;
+    LIN_MEMORY_BARRIER();                                     // read head before job
+    pJob = this->queueJob + tail;
+
+    // start frame. Job data is copied to send buffer
+    if (pJob->type == LIN_Master::MASTER_REQUEST)
+      this->_sendMasterRequest(pJob->version, pJob->id, pJob->numData, pJob->data, pJob->callback);
+    else
+      this->_receiveSlaveResponse(pJob->version, pJob->id, pJob->numData, pJob->callback, pJob->type);
+
+    // release job
+    LIN_MEMORY_BARRIER();                                     // read job before releasing it
+    if (++tail >= this->sizeJob)
+      tail = 0;
+    this->tailJob = tail;
+  }
+
+} // LIN_Master::_startJob()
+
+
+
+/**
+  \brief      Append frame to job queue if bus is busy
+  \details    With a job queue attached, a frame is only started directly if the bus is idle and no older jobs are
+              pending. Otherwise it is appended to the queue. If the queue is full, the frame is dropped and counted,
+              i.e. an ongoing frame is never overwritten
+  \param[in]  Type      frame type
+  \param[in]  Version   LIN protocol version
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \param[in]  NumData   number of data bytes (0..8)
+  \param[in]  Data      data bytes for master request (is copied), NULL for slave response
+  \param[in]  Callback  optional function called when this frame is finished
+  \return     true if frame was queued or dropped, false if frame can be started directly
+*/
+bool LIN_Master::_deferFrame(LIN_Master::frame_t Type, LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[], LIN_Master::callbackFrame_t Callback)
+{
+  // no job queue, or bus idle and no older frames pending -> start directly
+  if ((this->queueJob == NULL) || ((this->state == LIN_Master::STATE_IDLE) && (this->headJob == this->tailJob)))
+    return false;
+
+  // append to job queue. Queue full -> drop frame, don't touch ongoing frame
+  if ((!this->_queueFrame(Type, Version, Id, NumData, Data, Callback)) && (this->lostJobs < 255))
+    this->lostJobs++;
+  return true;
+
+} // LIN_Master::_deferFrame()
+
+
+
+/**
+  \brief      Append frame to job queue
+  \details    Append frame to job queue. Is started by handler() when bus is idle
+  \param[in]  Type      frame type
+  \param[in]  Version   LIN protocol version
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \param[in]  NumData   number of data bytes (0..8)
+  \param[in]  Data      data bytes for master request (is copied), NULL for slave response
+  \param[in]  Callback  optional function called when this frame is finished
+  \return     true if frame was queued, false if queue is full or not attached
+*/
+bool LIN_Master::_queueFrame(LIN_Master::frame_t Type, LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[], LIN_Master::callbackFrame_t Callback)
+{
+  LIN_Master::job_t   *pJob;
+  uint8_t             head;
+
+  // no queue attached
+  if (this->queueJob == NULL)
+    return false;
+
+  // queue full
+  head = this->headJob + 1;
+  if (head >= this->sizeJob)
+    head = 0;
+  if (head == this->tailJob)
+    return false;
+
+  // store job
+  pJob = this->queueJob + this->headJob;
+  pJob->type     = Type;
+  pJob->version  = Version;
+  pJob->id       = Id;
+  pJob->numData  = (NumData > 8) ? 8 : NumData;
+  pJob->callback = Callback;
+  if (Data != NULL)
+    memcpy(pJob->data, Data, pJob->numData);
+
+  // publish job for handler()
+  LIN_MEMORY_BARRIER();                                       // write job before publishing it
+  this->headJob = head;
+
+  return true;
+
+} // LIN_Master::_queueFrame()
+
+
+
+/**
+  \brief      Finish ongoing and queued frames
+  \details    Call handler() until the ongoing frame and all frames in job queue are finished. Used by blocking functions
+*/
+void LIN_Master::_flushJobs(void)
+{
+  while ((this->state == LIN_Master::STATE_BREAK) || (this->state == LIN_Master::STATE_BODY) || (this->state == LIN_Master::STATE_WAKEUP) ||
+        ((this->state == LIN_Master::STATE_IDLE) && (this->queueJob != NULL) && (this->headJob != this->tailJob)))
+    this->handler();
+
+} // LIN_Master::_flushJobs()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Calculate LIN frame checksum from start value
+  \details    Calculate LIN frame checksum as described in LIN1.x / LIN2.x specs. Carries are summed up
+              and folded once at the end, which is equivalent to the per-byte carry wrap of the spec
+  \param[in]  Seed      checksum start value, see checksumSeed()
+  \param[in]  NumData   number of data bytes in frame (0..8)
+  \param[in]  Data      frame data bytes
+  \return     calculated checksum
+*/
+uint8_t LIN_Master::checksumKernel(uint8_t Seed, uint8_t NumData, const uint8_t Data[])
+{
+  uint16_t chk = Seed;
+
+  // sum over data bytes. Max. 9*255 -> no 16-bit overflow
+  while (NumData--)
+    chk += *(Data++);
+
+  // fold carries (twice, as first fold may produce a new carry) and bitwise invert
+  chk = (chk & 0xFF) + (chk >> 8);
+  chk = (chk & 0xFF) + (chk >> 8);
+  return (uint8_t) (~chk);
+
+} // LIN_Master::checksumKernel()
+
+
+
+/**
+  \brief      Calculate LIN frame checksum
+  \details    Calculate LIN frame checksum as described in LIN1.x / LIN2.x specs
+              LIN2.x uses extended checksum which includes protected ID, i.e. including parity bits
+              LIN1.x uses classical checksum only over data bytes
+              Diagnostic frames with ID 0x3C and 0x3D/0x7D always use classical checksum (see LIN spec "2.3.1.5 Checkum")
+  \param[in]  Version   LIN protocol version
+  \param[in]  Id        frame identifier (protected or unprotected)
+  \param[in]  NumData   number of data bytes in frame (0..8)
+  \param[in]  Data      frame data bytes
+  \return     calculated checksum, depending on protocol version
+*/
+uint8_t LIN_Master::calculateChecksum(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[])
+{
+  uint8_t  seed = 0x00;
+
+  // LIN2.x data frame -> enhanced checksum
+  if (!((Version == LIN_Master::LIN_V1) || ((Id & 0x3F) == 0x3C) || ((Id & 0x3F) == 0x3D)))
+    seed = LIN_Master::calculatePID(Id);
+
+  // return frame checksum
+  return LIN_Master::checksumKernel(seed, NumData, Data);
+
+} // LIN_Master::calculateChecksum()
+
+
+
+/**
+  \brief      LIN master node constructor
+  \details    LIN master node constructor. Initialize class variables to default values.
+              For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \param[in]  NameLIN     LIN node name 
+*/
+LIN_Master::LIN_Master(const char NameLIN[])
+{
+  // store parameters in class variables
+  #if defined(LIN_MASTER_COMPACT)
+    this->nameLIN = NameLIN;                                  // node name e.g. for debug, not copied
+  #else
+    strncpy(this->nameLIN, NameLIN, BUFLEN_NAME-1);           // node name e.g. for debug
+    this->nameLIN[BUFLEN_NAME-1] = '\0';
+  #endif
+
+  // initialize master node properties
+  this->error = LIN_Master::NO_ERROR;                         // last LIN error. Is latched
+  this->state = LIN_Master::STATE_OFF;                        // status of LIN state machine
+  this->callback = NULL;                                      // no user callback for finished frames
+  this->callbackFrame = NULL;                                 // no user callback for current frame
+  this->queueResult = NULL;                                   // no result queue
+  this->sizeResult  = 0;
+  this->headResult  = 0;
+  this->tailResult  = 0;
+  this->lostResults = 0;
+  this->queueJob    = NULL;                                   // no job queue
+  this->sizeJob     = 0;
+  this->headJob     = 0;
+  this->tailJob     = 0;
+  this->lostJobs    = 0;
+  this->baudrateNominal = 0;                                  // set in begin()
+  memset(this->cacheBaudrate, 0, sizeof(this->cacheBaudrate)); // no precomputed baudrates
+  memset(this->cacheTimePerByte, 0, sizeof(this->cacheTimePerByte));
+  this->idxCache    = 0;
+  this->tableResponse = NULL;                                 // fixed timeout
+  this->tableCache    = NULL;                                 // no change detection
+  this->sizeCache     = 0;
+  this->sleepPending  = false;                                // power management
+  this->delayWakeup   = LIN_WAKEUP_DELAY;
+  this->timeoutIdle   = 0;
+  this->timeActivity  = 0;
+  this->timeWakeup    = 0;
+  this->bufTrace    = NULL;                                   // no trace
+  this->sizeTrace   = 0;
+  this->headTrace   = 0;
+  this->tailTrace   = 0;
+  this->lostTrace   = 0;
+  memset(this->bufFrame, 0, sizeof(this->bufFrame));          // double-buffered receive buffer
+  this->idxRx       = 0;
+  this->bufRx       = this->bufFrame[0];
+  this->numRx       = 0;
+  this->idxDone     = LIN_BUFRX_NUM - 1;
+  this->seqDone     = 0;
+  this->typeDone    = LIN_Master::MASTER_REQUEST;
+  this->idDone      = 0;
+  this->lenDone     = 4;
+  this->errorDone   = LIN_Master::NO_ERROR;
+  #if defined(LIN_MASTER_STATS)
+    this->resetStats();                                       // clear statistics
+    this->timeBody  = 0;
+  #endif
+
+} // LIN_Master::LIN_Master()
+
+
+
+/**
+  \brief      Open serial interface
+  \details    Open serial interface with specified baudrate. Here dummy!
+  \param[in]  Baudrate    communication speed [Baud]
+*/
+void LIN_Master::begin(uint16_t Baudrate)
+{
+  // store parameters in class variables
+  this->baudrate   = Baudrate;                                // communication baudrate [Baud]
+  this->baudrateNominal = Baudrate;                           // restored by setBaudrate(0)
+
+  // start time base for frame timing
+  LIN_Master_Timebase::begin();
+
+  // initialize master node properties
+  this->error = LIN_Master::NO_ERROR;                         // last LIN error. Is latched
+  this->state = LIN_Master::STATE_IDLE;                       // status of LIN state machine
+  this->timePerByte = this->_getTimePerByte(this->baudrate);  // time [ticks] per byte (for performance)
+  this->sleepPending = false;                                 // bus is awake
+  this->timeActivity = millis();                              // start bus idle timeout
+
+} // LIN_Master::begin()
+
+
+
+/**
+  \brief      Close serial interface
+  \details    Close serial interface. Here dummy!
+*/
+void LIN_Master::end()
+{
+  // initialize master node properties
+  this->state = LIN_Master::STATE_OFF;                        // status of LIN state machine
+
+} // LIN_Master::end()
+
+
+
+/**
+  \brief      Set baudrate for next frames
+  \details    Set baudrate for next frames without re-opening the interface, e.g. for slaves with different baudrates
+              on one bus. Timing of the last LIN_BAUDRATE_CACHE baudrates is precomputed, i.e. switching per frame is fast.
+              The baudrate can't be changed while a frame is ongoing
+  \param[in]  Baudrate    communication speed [Baud] (0 = baudrate of begin())
+  \return     true if baudrate is set, false if interface is closed or a frame is ongoing
+*/
+bool LIN_Master::setBaudrate(uint16_t Baudrate)
+{
+  // use nominal baudrate
+  if (Baudrate == 0)
+    Baudrate = this->baudrateNominal;
+
+  // no change -> nothing to do
+  if (Baudrate == this->baudrate)
+    return true;
+
+  // interface closed or frame ongoing -> can't change
+  if ((this->state == LIN_Master::STATE_OFF) || (this->state == LIN_Master::STATE_BREAK) || (this->state == LIN_Master::STATE_BODY))
+    return false;
+
+  // set baudrate and timing, and apply to interface
+  this->baudrate    = Baudrate;
+  this->timePerByte = this->_getTimePerByte(Baudrate);
+  this->_setBaudrate();
+
+  return true;
+
+} // LIN_Master::setBaudrate()
+
+
+
+/**
+  \brief      Find baudrate of a slave
+  \details    Find baudrate of a slave by polling a slave response frame at candidate baudrates (blocking), e.g. for
+              bringing up an unknown harness. The first baudrate with an error-free response (echo and checksum) is
+              kept active and returned. If no slave responds, the previous baudrate is restored.
+              The state machine is reset before each frame and after the probe
+  \param[in]  Version   LIN protocol version
+  \param[in]  Id        frame idendifier of slave response (protected or unprotected)
+  \param[in]  NumData   number of data bytes (1..8)
+  \param[in]  Rates     candidate baudrates [Baud] in order of probing (NULL = 19200, 10417, 9600, 4800, 2400)
+  \param[in]  NumRates  number of candidate baudrates
+  \return     found baudrate [Baud], or 0 if no slave responded
+*/
+uint16_t LIN_Master::probeBaudrate(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint16_t Rates[], uint8_t NumRates)
+{
+  static const uint16_t   ratesDefault[] PROGMEM = {19200, 10417, 9600, 4800, 2400};
+  uint16_t                baudrateOld = this->baudrate;
+  uint8_t                 data[8];
+
+  // interface closed or bus in sleep mode -> can't probe
+  if ((this->state == LIN_Master::STATE_OFF) || (this->state == LIN_Master::STATE_SLEEP))
+    return 0;
+
+  // use common LIN baudrates (in PROGMEM)
+  if (Rates == NULL)
+    NumRates = sizeof(ratesDefault) / sizeof(uint16_t);
+
+  // poll slave response at candidate baudrates
+  for (uint8_t i=0; i<NumRates; i++)
+  {
+    uint16_t  rate = (Rates == NULL) ? pgm_read_word(&(ratesDefault[i])) : Rates[i];
+    this->_flushJobs();
+    this->resetStateMachine();
+    this->resetError();
+    if (!this->setBaudrate(rate))
+      break;
+    if (this->receiveSlaveResponseBlocking(Version, Id, NumData, data) == LIN_Master::NO_ERROR)
+    {
+      this->resetStateMachine();
+      return rate;
+    }
+  }
+
+  // no response -> restore previous baudrate
+  this->resetStateMachine();
+  this->resetError();
+  this->setBaudrate(baudrateOld);
+  return 0;
+
+} // LIN_Master::probeBaudrate()
+
+
+
+#if defined(LIN_MASTER_STATS)
+
+/**
+  \brief      Getter for copy of frame statistics
+  \details    Getter for consistent copy of frame timing and error statistics. Averages are e.g. timeBreakSum/numBreak
+  \param[out] Stats     copy of statistics
+*/
+void LIN_Master::getStats(LIN_Master::stats_t &Stats)
+{
+  // for data consistency temporarily disable ISRs
+  noInterrupts();
+  Stats = this->stats;
+  interrupts();
+
+} // LIN_Master::getStats()
+
+
+
+/**
+  \brief      Reset frame statistics
+  \details    Reset frame timing and error statistics and start new measurement period for bus load
+*/
+void LIN_Master::resetStats(void)
+{
+  // for data consistency temporarily disable ISRs
+  noInterrupts();
+  memset(&(this->stats), 0, sizeof(this->stats));
+  this->stats.timeBreakMin    = 0xFFFFFFFF;
+  this->stats.timeResponseMin = 0xFFFFFFFF;
+  this->stats.timeReset       = micros();
+  interrupts();
+
+} // LIN_Master::resetStats()
+
+
+
+/**
+  \brief      Getter for bus utilization
+  \details    Getter for bus utilization since resetStats(), i.e. ratio of frame durations to elapsed time.
+              Call resetStats() at least every ~70min to avoid overflow of micros()
+  \return     bus utilization [0.1%]
+*/
+uint16_t LIN_Master::getBusLoad(void)
+{
+  uint32_t  timeElapsed = (micros() - this->stats.timeReset) / 1000;    // [ms]
+
+  // avoid division by zero
+  if (timeElapsed == 0)
+    return 0;
+
+  // bus busy time [us] / elapsed time [ms] -> [0.1%]
+  return (uint16_t) (this->stats.timeBusy / timeElapsed);
+
+} // LIN_Master::getBusLoad()
+
+#endif // LIN_MASTER_STATS
+
+
+
+/**
+  \brief      Attach buffer for queue of finished frames
+  \details    Attach buffer for lock-free queue of finished frames. handler() writes, application reads via readResult().
+              If a queue is attached, state machine is reset after each frame and error is cleared when the next
+              frame is started, i.e. frames can be started back-to-back.
+              One buffer entry is reserved, i.e. queue holds up to Size-1 results
+  \param[in]  Buffer    buffer for frame records. Must remain valid while attached. NULL = detach queue
+  \param[in]  Size      number of records in buffer (2..255)
+*/
+void LIN_Master::attachResultQueue(LIN_Master::result_t Buffer[], uint8_t Size)
+{
+  // queue must not be modified by handler() meanwhile
+  noInterrupts();
+  this->queueResult = (Size >= 2) ? Buffer : NULL;
+  this->sizeResult  = Size;
+  this->headResult  = 0;
+  this->tailResult  = 0;
+  this->lostResults = 0;
+  interrupts();
+
+} // LIN_Master::attachResultQueue()
+
+
+
+/**
+  \brief      Getter for number of queued results
+  \details    Getter for number of results in queue which have not yet been read
+  \return     number of queued results
+*/
+uint8_t LIN_Master::availableResults(void)
+{
+  uint8_t   head = this->headResult;
+  uint8_t   tail = this->tailResult;
+
+  // no queue attached
+  if (this->queueResult == NULL)
+    return 0;
+
+  // return number of results
+  if (head >= tail)
+    return head - tail;
+  return this->sizeResult - tail + head;
+
+} // LIN_Master::availableResults()
+
+
+
+/**
+  \brief      Read oldest result from queue
+  \details    Read oldest result from queue. Interrupts are not disabled
+  \param[out] Result    frame record
+  \return     true if a result was read, false if queue is empty
+*/
+bool LIN_Master::readResult(LIN_Master::result_t &Result)
+{
+  return (this->readResults(&Result, 1) == 1);
+
+} // LIN_Master::readResult()
+
+
+
+/**
+  \brief      Read up to Max results from queue
+  \details    Read up to Max results from queue in a batch. Interrupts are not disabled
+  \param[out] Results   buffer for frame records
+  \param[in]  Max       max. number of records to read
+  \return     number of read results
+*/
+uint8_t LIN_Master::readResults(LIN_Master::result_t Results[], uint8_t Max)
+{
+  uint8_t   head = this->headResult;                          // only written by handler()
+  uint8_t   tail = this->tailResult;
+  uint8_t   num = 0;
+
+  // no queue attached
+  if (this->queueResult == NULL)
+    return 0;
+
+  // copy records until queue is empty
+  LIN_MEMORY_BARRIER();                                       // read head before records
+  while ((tail != head) && (num < Max))
+  {
+    Results[num++] = this->queueResult[tail];
+    if (++tail >= this->sizeResult)
+      tail = 0;
+  }
+
+  // release read records
+  LIN_MEMORY_BARRIER();                                       // read records before releasing them
+  this->tailResult = tail;
+
+  // return number of read records
+  return num;
+
+} // LIN_Master::readResults()
+
+
+
+/**
+  \brief      Attach buffer for queue of frames to send
+  \details    Attach buffer for lock-free job queue. Application appends frames, handler() starts them back-to-back.
+              If a job queue is attached, sendMasterRequest() and receiveSlaveResponse() append frames while the bus
+              is busy, and the state machine is reset after each frame. Use callbacks or a result queue to get the results.
+              One buffer entry is reserved, i.e. queue holds up to Size-1 frames
+  \param[in]  Buffer    buffer for frame jobs. Must remain valid while attached. NULL = detach queue
+  \param[in]  Size      number of jobs in buffer (2..255)
+*/
+void LIN_Master::attachJobQueue(LIN_Master::job_t Buffer[], uint8_t Size)
+{
+  // queue must not be modified by handler() meanwhile
+  noInterrupts();
+  this->queueJob = (Size >= 2) ? Buffer : NULL;
+  this->sizeJob  = Size;
+  this->headJob  = 0;
+  this->tailJob  = 0;
+  this->lostJobs = 0;
+  interrupts();
+
+} // LIN_Master::attachJobQueue()
+
+
+
+/**
+  \brief      Getter for number of free job queue entries
+  \details    Getter for number of frames which can still be appended to the job queue
+  \return     number of free entries
+*/
+uint8_t LIN_Master::freeJobs(void)
+{
+  uint8_t   head = this->headJob;
+  uint8_t   tail = this->tailJob;
+
+  // no queue attached
+  if (this->queueJob == NULL)
+    return 0;
+
+  // return number of free entries
+  if (head >= tail)
+    return this->sizeJob - 1 - head + tail;
+  return tail - head - 1;
+
+} // LIN_Master::freeJobs()
+
+
+
+/**
+  \brief      Attach table for adaptive slave response timeouts
+  \details    Attach table for learning slave response times per frame ID. Timeouts of slave response frames are then
+              derived from the learned times, and absent slaves are detected early and skipped for a backoff period,
+              see skipFrame(). Table is cleared on attach
+  \param[in]  Table     table with 64 entries for IDs 0x00..0x3F. Must remain valid while attached. NULL = detach
+*/
+void LIN_Master::attachResponseTable(LIN_Master::response_t Table[64])
+{
+  // clear learned times
+  if (Table != NULL)
+    memset(Table, 0, 64 * sizeof(LIN_Master::response_t));
+
+  // table must not be modified by handler() meanwhile
+  noInterrupts();
+  this->tableResponse = Table;
+  interrupts();
+
+} // LIN_Master::attachResponseTable()
+
+
+
+/**
+  \brief      Check if slave response frame should be skipped due to backoff
+  \details    Check if slave response frame should be skipped, because the slave has not responded LIN_BACKOFF_TIMEOUTS
+              times in a row. Each call during backoff counts one skipped frame. After LIN_BACKOFF_SKIP skipped frames
+              the next frame is sent again (with min. timeout); if it times out, the backoff restarts
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \return     true if frame should be skipped
+*/
+bool LIN_Master::skipFrame(uint8_t Id)
+{
+  LIN_Master::response_t  *pEntry;
+
+  // no adaptive timeout
+  if (this->tableResponse == NULL)
+    return false;
+
+  // backoff ongoing -> count skipped frame
+  pEntry = this->tableResponse + (Id & 0x3F);
+  if (pEntry->numSkip > 0)
+  {
+    pEntry->numSkip--;
+    return true;
+  }
+
+  // send frame
+  return false;
+
+} // LIN_Master::skipFrame()
+
+
+
+/**
+  \brief      Check if slave response ID is in backoff
+  \details    Check if slave response ID is in backoff, i.e. if its next frame would be skipped. Unlike skipFrame()
+              this doesn't count a skipped frame, e.g. to check if a failed frame should be retried
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \return     true if ID is in backoff
+*/
+bool LIN_Master::isBackoff(uint8_t Id)
+{
+  // no adaptive timeout
+  if (this->tableResponse == NULL)
+    return false;
+
+  // check remaining frames to skip
+  return (this->tableResponse[Id & 0x3F].numSkip > 0);
+
+} // LIN_Master::isBackoff()
+
+
+
+/**
+  \brief      Attach table for last-value cache of slave responses
+  \details    Attach table for last-value cache with change detection. Each entry caches the last error-free slave
+              response of one ID, which is added via subscribe(). Subscribers are only notified if the data has
+              changed, and the dirty mask shows the changed bits, e.g. for LIN_Master_Signal::isChanged().
+              Table is cleared on attach
+  \param[in]  Table     table with one entry per subscribed ID. Must remain valid while attached. NULL = detach
+  \param[in]  Size      number of table entries
+*/
+void LIN_Master::attachChangeCache(LIN_Master::cache_t Table[], uint8_t Size)
+{
+  // mark all entries unused
+  if (Table != NULL)
+  {
+    memset(Table, 0, Size * sizeof(LIN_Master::cache_t));
+    for (uint8_t i=0; i<Size; i++)
+      Table[i].id = 0xFF;
+  }
+
+  // table must not be used by handler() meanwhile
+  noInterrupts();
+  this->tableCache = Table;
+  this->sizeCache  = (Table != NULL) ? Size : 0;
+  interrupts();
+
+} // LIN_Master::attachChangeCache()
+
+
+
+/**
+  \brief      Subscribe to changes of a slave response ID
+  \details    Add an ID to the last-value cache (or update its subscriber). The callback is called from handler()
+              when an error-free slave response of this ID differs from the cached data. Without callback, changes
+              are polled via isChanged() and readChanges()
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \param[in]  Callback  subscriber called on change (NULL = poll)
+  \return     true if subscribed, false if no table is attached or table is full
+*/
+bool LIN_Master::subscribe(uint8_t Id, LIN_Master::callbackChange_t Callback)
+{
+  LIN_Master::cache_t   *pEntry;
+
+  // ID already subscribed, else use free entry
+  pEntry = this->_findCache(Id);
+  for (uint8_t i=0; (pEntry == NULL) && (i<this->sizeCache); i++)
+  {
+    if (this->tableCache[i].id == 0xFF)
+      pEntry = this->tableCache + i;
+  }
+  if (pEntry == NULL)
+    return false;
+
+  // set subscriber. Entry must not be used by handler() meanwhile
+  noInterrupts();
+  pEntry->callback = Callback;
+  pEntry->id       = Id & 0x3F;
+  interrupts();
+  return true;
+
+} // LIN_Master::subscribe()
+
+
+
+/**
+  \brief      Check if cached data of an ID has changed
+  \details    Check if cached data of an ID has changed since last notification or readChanges()
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \return     true if data has changed, false if unchanged or ID not subscribed
+*/
+bool LIN_Master::isChanged(uint8_t Id)
+{
+  LIN_Master::cache_t   *pEntry = this->_findCache(Id);
+
+  // return change flag
+  return ((pEntry != NULL) && (pEntry->changed));
+
+} // LIN_Master::isChanged()
+
+
+
+/**
+  \brief      Read cached data and dirty mask of an ID
+  \details    Copy cached data and dirty mask of an ID and clear change flag and mask, e.g. for forwarding only deltas
+              to a gateway. Interrupts are disabled for consistency
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \param[out] Data      buffer for cached data (8B)
+  \param[out] Diff      buffer for changed bits (8B, NULL = not required)
+  \param[out] NumData   number of cached data bytes (NULL = not required)
+  \return     true if data has changed since last notification or readChanges()
+*/
+bool LIN_Master::readChanges(uint8_t Id, uint8_t Data[], uint8_t Diff[], uint8_t *NumData)
+{
+  LIN_Master::cache_t   *pEntry = this->_findCache(Id);
+  bool                  changed;
+
+  // ID not subscribed
+  if (pEntry == NULL)
+    return false;
+
+  // copy entry and clear change
+  noInterrupts();
+  changed = pEntry->changed;
+  memcpy(Data, pEntry->data, pEntry->numData);
+  if (Diff != NULL)
+    memcpy(Diff, pEntry->diff, pEntry->numData);
+  if (NumData != NULL)
+    *NumData = pEntry->numData;
+  memset(pEntry->diff, 0x00, sizeof(pEntry->diff));
+  pEntry->changed = false;
+  interrupts();
+  return changed;
+
+} // LIN_Master::readChanges()
+
+
+
+/**
+  \brief      Send go-to-sleep command in background, then enter sleep mode
+  \details    Send go-to-sleep command (diagnostic master request 0x3C with data 0x00, 0xFF..) in background. When
+              the frame is finished, handler() enters STATE_SLEEP instead of STATE_DONE. In sleep mode the serial
+              interface stays open for detecting wake-up pulses, i.e. no begin() is required to resume.
+              Frames started in sleep mode are rejected with ERROR_STATE or, with a job queue, queued until wake-up
+  \return     true if go-to-sleep command was started, false if bus is busy or frames are queued
+*/
+bool LIN_Master::goToSleep(void)
+{
+  uint8_t   data[8] = {0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+  // bus busy or frames pending -> don't sleep
+  if ((this->state != LIN_Master::STATE_IDLE) || (this->headJob != this->tailJob))
+    return false;
+
+  // send go-to-sleep command. Sleep mode is entered by _frameDone()
+  this->sleepPending = true;
+  this->_sendMasterRequest(LIN_Master::LIN_V2, 0x3C, 8, data);
+  return true;
+
+} // LIN_Master::goToSleep()
+
+
+
+/**
+  \brief      Send wake-up pulse and resume after wake-up delay
+  \details    Send wake-up pulse (if supported by interface) and enter STATE_WAKEUP. After the wake-up delay,
+              see setWakeupDelay(), handler() returns to STATE_IDLE and queued frames are started back-to-back.
+              Blocking functions wait for the end of the wake-up delay. A wake-up pulse received from a slave
+              is detected by handler() in sleep mode, with the same delay
+  \return     true if bus was in sleep mode
+*/
+bool LIN_Master::wakeup(void)
+{
+  // bus not in sleep mode -> nothing to do
+  if (this->state != LIN_Master::STATE_SLEEP)
+    return false;
+
+  // send wake-up pulse and wait for slaves
+  this->_sendWakeup();
+  this->timeWakeup = millis();
+  this->state      = LIN_Master::STATE_WAKEUP;
+  return true;
+
+} // LIN_Master::wakeup()
+
+
+
+/**
+  \brief      Attach ring buffer for binary frame trace
+  \details    Attach byte ring buffer for a packed binary trace of all finished frames, see _traceFrame() for the record
+              format. Recording a frame takes a few microseconds, i.e. timing is not affected as with LIN_DEBUG_LEVEL 2.
+              The application streams the trace via drainTrace(), e.g. to a secondary serial port.
+              One buffer byte is reserved, and a record takes 15..23 bytes
+  \param[in]  Buffer    byte buffer for trace records. Must remain valid while attached. NULL = detach trace
+  \param[in]  Size      size of buffer [B] (>=24)
+*/
+void LIN_Master::attachTrace(uint8_t Buffer[], uint16_t Size)
+{
+  // trace must not be modified by handler() meanwhile
+  noInterrupts();
+  this->bufTrace  = (Size >= LIN_TRACE_HEADER + 8 + 3) ? Buffer : NULL;
+  this->sizeTrace = Size;
+  this->headTrace = 0;
+  this->tailTrace = 0;
+  this->lostTrace = 0;
+  interrupts();
+
+} // LIN_Master::attachTrace()
+
+
+
+/**
+  \brief      Getter for number of trace bytes not yet drained
+  \details    Getter for number of bytes in trace buffer which have not yet been drained
+  \return     number of trace bytes
+*/
+uint16_t LIN_Master::availableTrace(void)
+{
+  uint16_t  head;
+  uint16_t  tail = this->tailTrace;
+
+  // no trace attached
+  if (this->bufTrace == NULL)
+    return 0;
+
+  // 16-bit index may not be read atomically
+  noInterrupts();
+  head = this->headTrace;
+  interrupts();
+
+  // return number of bytes
+  if (head >= tail)
+    return head - tail;
+  return this->sizeTrace - tail + head;
+
+} // LIN_Master::availableTrace()
+
+
+
+/**
+  \brief      Write trace bytes to a stream
+  \details    Write up to Max trace bytes to a stream in bulk, i.e. with max. 2 write() calls. Records may be split
+              between calls, as the host decoder synchronizes on the byte stream. To avoid blocking, pass the free
+              space of the stream as Max, e.g. Serial.availableForWrite()
+  \param[in]  Port      stream to write to, e.g. Serial
+  \param[in]  Max       max. number of bytes to write
+  \return     number of written bytes
+*/
+uint16_t LIN_Master::drainTrace(Print &Port, uint16_t Max)
+{
+  uint16_t  head;
+  uint16_t  tail = this->tailTrace;                           // only written by application
+  uint16_t  len;
+  uint16_t  num = 0;
+
+  // no trace attached
+  if (this->bufTrace == NULL)
+    return 0;
+
+  // 16-bit index may not be read atomically
+  noInterrupts();
+  head = this->headTrace;
+  interrupts();
+  LIN_MEMORY_BARRIER();                                       // read head before records
+
+  // write contiguous blocks until buffer is empty (max. 2 due to wrap-around)
+  while ((tail != head) && (num < Max))
+  {
+    len = (head > tail) ? (head - tail) : (this->sizeTrace - tail);
+    if (len > Max - num)
+      len = Max - num;
+    len = Port.write(this->bufTrace + tail, len);
+    if (len == 0)
+      break;
+    num  += len;
+    tail += len;
+    if (tail >= this->sizeTrace)
+      tail = 0;
+  }
+
+  // release written bytes
+  LIN_MEMORY_BARRIER();                                       // read records before releasing them
+  noInterrupts();
+  this->tailTrace = tail;
+  interrupts();
+
+  // return number of written bytes
+  return num;
+
+} // LIN_Master::drainTrace()
+
+
+
+/**
+  \brief      Getter for zero-copy view of last completed frame
+  \details    Getter for view of last completed frame without copying data and without disabling interrupts.
+              The next frame is received into the other receive buffer, so View.data stays unchanged until a newer
+              frame is completed and another one started. After reading View.data, call checkFrameView() to check
+              that no newer frame was completed meanwhile (else read again). With LIN_MASTER_COMPACT only one receive
+              buffer is used, i.e. the view becomes invalid as soon as the next frame is started.
+  \param[out] View      view of last completed frame
+  \return     true if view is consistent, false if a frame was completed while reading
+*/
+bool LIN_Master::getFrameView(LIN_Master::view_t &View)
+{
+  // get sequence number before reading frame
+  View.seq = this->seqDone;
+  LIN_MEMORY_BARRIER();
+
+  // get view of completed frame
+  View.data    = this->bufFrame[this->idxDone] + 3;             // excl. BREAK, SYNC, ID
+  View.type    = this->typeDone;
+  View.id      = this->idDone;
+  View.numData = this->lenDone - 4;                             // excl. BREAK, SYNC, ID, CHK
+  View.error   = this->errorDone;
+
+  // check that no frame was completed meanwhile
+  return this->checkFrameView(View);
+
+} // LIN_Master::getFrameView()
+
+
+
+/**
+  \brief      Start sending a LIN master request frame in background (if supported)
+  \details    Start sending a LIN master request frame in background (if supported). Background handling is handling by handler().
+              If a job queue is attached and the bus is busy, the frame is appended to the queue.
+              If the queue is full, the frame is dropped without affecting the ongoing frame, see getLostJobs().
+              For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \param[in]  Version   LIN protocol version
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \param[in]  NumData   number of data bytes (0..8)
+  \param[in]  Data      data bytes
+  \param[in]  Callback  optional function called when this frame is finished
+  \return     LIN state machine state
+*/
+LIN_Master::state_t LIN_Master::sendMasterRequest(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, uint8_t Data[], LIN_Master::callbackFrame_t Callback)
+{
+  // bus busy or older frames pending -> append to job queue (if attached). Full queue -> frame is dropped
+  if (this->_deferFrame(LIN_Master::MASTER_REQUEST, Version, Id, NumData, Data, Callback))
+    return this->state;
+
+  // start frame directly
+  return this->_sendMasterRequest(Version, Id, NumData, Data, Callback);
+
+} // LIN_Master::sendMasterRequest()
+
+
+
+/**
+  \brief      Send a blocking LIN master request frame (no background operation)
+  \details    Send a blocking LIN master request frame (no background operation).
+              For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \param[in]  Version   LIN protocol version
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \param[in]  NumData   number of data bytes (0..8)
+  \param[in]  Data      data bytes
+  \return     LIN error
+*/
+LIN_Master::error_t LIN_Master::sendMasterRequestBlocking(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, uint8_t Data[])
+{
+  // finish ongoing and queued frames first
+  this->_flushJobs();
+
+  // start master request frame
+  this->_sendMasterRequest(Version, Id, NumData, Data);
+  
+  // wait until frame is completed. Note: an attached callback may already have reset the state machine
+  do
+    this->handler();
+  while ((this->state == LIN_Master::STATE_BREAK) || (this->state == LIN_Master::STATE_BODY));
+
+  // return LIN error
+  return this->error;
+
+} // LIN_Master::sendMasterRequestBlocking()
+
+
+
+/**
+  \brief      Start a LIN slave response frame in background (if supported)
+  \details    Start a LIN slave response frame in background (if supported). Background handling is handling by handler().
+              If a job queue is attached and the bus is busy, the frame is appended to the queue.
+              If the queue is full, the frame is dropped without affecting the ongoing frame, see getLostJobs().
+              For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \param[in]  Version   LIN protocol version
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \param[in]  NumData   number of data bytes (0..8)
+  \param[in]  Callback  optional function called when this frame is finished
+  \return     LIN state machine state
+*/
+LIN_Master::state_t LIN_Master::receiveSlaveResponse(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, LIN_Master::callbackFrame_t Callback)
+{
+  // bus busy or older frames pending -> append to job queue (if attached). Full queue -> frame is dropped
+  if (this->_deferFrame(LIN_Master::SLAVE_RESPONSE, Version, Id, NumData, NULL, Callback))
+    return this->state;
+
+  // start frame directly
+  return this->_receiveSlaveResponse(Version, Id, NumData, Callback);
+
+} // LIN_Master::receiveSlaveResponse()
+
+
+
+/**
+  \brief      Send/receive a blocking LIN slave response frame (no background operation)
+  \details    Send/receive a blocking LIN slave response frame (no background operation).
+              For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \param[in]  Version   LIN protocol version
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \param[in]  NumData   number of data bytes (0..8)
+  \param[out] Data      data bytes. Not changed if frame was rejected, e.g. in sleep mode
   \return     LIN error
 */
 LIN_Master::error_t LIN_Master::receiveSlaveResponseBlocking(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, uint8_t *Data)
 {
+  uint8_t   seq;
+  uint8_t   len;
+
+  // finish ongoing and queued frames first
+  this->_flushJobs();
+
   // start slave response frame
-  this->receiveSlaveResponse(Version, Id, NumData);
+  seq = this->seqDone;
+  this->_receiveSlaveResponse(Version, Id, NumData);
   
-  // wait until frame is completed
+  // wait until frame is completed. Note: an attached callback may already have reset the state machine
   do
     this->handler();
-  while (this->state != LIN_Master::STATE_DONE);
+  while ((this->state == LIN_Master::STATE_BREAK) || (this->state == LIN_Master::STATE_BODY));
 
-  // copy received data
-  this->getFrame(type, id, NumData, Data);
+  // frame rejected without being sent (e.g. sleep mode) -> last completed frame belongs to another request
+  if (this->seqDone == seq)
+    return (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_STATE);
+
+  // copy received data, at most NumData bytes. No ISR masking required, as no other frame is ongoing
+  len = this->lenDone - 4;
+  if (len > NumData)
+    len = NumData;
+  memcpy(Data, this->bufFrame[this->idxDone]+3, len);
 
   // return LIN error
   return this->error;
 
-} // LIN_Master::sendMasterRequestBlocking()
+} // LIN_Master::receiveSlaveResponseBlocking()
+
+
+
+/**
+  \brief      Start a LIN event triggered frame in background (if supported)
+  \details    Start a LIN 2.x event triggered frame in background (if supported). Any slave with updated signals may respond,
+              with the PID of its unconditional frame in the first data byte. ERROR_TIMEOUT indicates that no slave responded,
+              ERROR_CHK indicates a collision of several slaves, which is resolved by polling the unconditional frames,
+              see LIN_Master_Schedule. If a job queue is attached and the bus is busy, the frame is appended to the queue.
+              If the queue is full, the frame is dropped without affecting the ongoing frame, see getLostJobs().
+  \param[in]  Version   LIN protocol version
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \param[in]  NumData   number of data bytes incl. PID of responding frame (1..8)
+  \param[in]  Callback  optional function called when this frame is finished
+  \return     LIN state machine state
+*/
+LIN_Master::state_t LIN_Master::receiveEventTriggered(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, LIN_Master::callbackFrame_t Callback)
+{
+  // bus busy or older frames pending -> append to job queue (if attached). Full queue -> frame is dropped
+  if (this->_deferFrame(LIN_Master::EVENT_TRIGGERED, Version, Id, NumData, NULL, Callback))
+    return this->state;
+
+  // start frame directly
+  return this->_receiveSlaveResponse(Version, Id, NumData, Callback, LIN_Master::EVENT_TRIGGERED);
+
+} // LIN_Master::receiveEventTriggered()
+
+
+
+/**
+  \brief      Repeat last frame in background (if supported)
+  \details    Repeat last started frame in background (if supported) with same type, ID and data, bypassing the job queue.
+              Use e.g. after ERROR_TIMEOUT or ERROR_CHK without handling the frame in application code. The latched
+              error is cleared and the retry is counted in the statistics (if LIN_MASTER_STATS is set)
+  \return     LIN state machine state
+*/
+LIN_Master::state_t LIN_Master::retryFrame(void)
+{
+  uint8_t   data[8];
+
+  // frame ongoing or bus in sleep mode -> can't repeat
+  if ((this->state != LIN_Master::STATE_IDLE) && (this->state != LIN_Master::STATE_DONE))
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_STATE);
+    return this->state;
+  }
+
+  // count retry
+  #if defined(LIN_MASTER_STATS)
+    this->stats.numRetries++;
+  #endif
+
+  // release state machine and clear error of failed frame
+  this->state = LIN_Master::STATE_IDLE;
+  this->error = LIN_Master::NO_ERROR;
+
+  // master request -> re-send data from Tx buffer (copy, as Tx buffer is re-built)
+  if (this->type == LIN_Master::MASTER_REQUEST)
+  {
+    memcpy(data, this->bufTx+3, this->lenTx-4);
+    return this->_sendMasterRequest(this->version, this->id, this->lenTx-4, data, this->callbackFrame);
+  }
+
+  // slave response or event triggered frame -> send header again
+  return this->_receiveSlaveResponse(this->version, this->id, this->lenRx-4, this->callbackFrame, this->type);
+
+} // LIN_Master::retryFrame()
 
 
 
 /**
   \brief      Handle LIN background operation (call until STATE_DONE is returned)
-  \details    Handle LIN background operation (call until STATE_DONE is returned).
+  \details    Handle LIN background operation (call until STATE_DONE is returned). When the frame is finished, the attached callback is called.
+              For event driven operation call from serialEvent() or a UART receive hook, see attachCallback()
               For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
   \return     LIN state machine state
 */
 LIN_Master::state_t LIN_Master::handler(void)
 {
+  LIN_Master::state_t   stateOld = this->state;     // for detecting end of frame
+  #if defined(LIN_MASTER_STATS)
+    uint32_t            timeEntry = LIN_Master_Timebase::getTicks();   // for duration of handler()
+  #endif
+
   // act according to current state
   switch (this->state)
   {
-    // idle or done -> don't do anything
+    // idle -> check bus idle timeout (only if no frame is queued)
     case LIN_Master::STATE_IDLE:
+      if ((this->timeoutIdle != 0) && (this->headJob == this->tailJob) && (millis() - this->timeActivity >= this->timeoutIdle))
+        this->state = LIN_Master::STATE_SLEEP;
+      break;
+
+    // done -> don't do anything
     case LIN_Master::STATE_DONE:
       break;
 
+    // sleep mode -> check for wake-up pulse from slave
+    case LIN_Master::STATE_SLEEP:
+      if (this->_receiveWakeup())
+      {
+        this->timeWakeup = millis();
+        this->state      = LIN_Master::STATE_WAKEUP;
+      }
+      break;
+
+    // after wake-up -> wait until slaves are ready
+    case LIN_Master::STATE_WAKEUP:
+      if (millis() - this->timeWakeup >= this->delayWakeup)
+      {
+        this->timeActivity = millis();
+        this->state        = LIN_Master::STATE_IDLE;
+      }
+      break;
+
     // when sync break done, send rest of frame
     case LIN_Master::STATE_BREAK:
       this->_sendFrame();
@@ -418,6 +1965,29 @@ LIN_Master::state_t LIN_Master::handler(void)
       this->state = LIN_Master::STATE_DONE;
 
   } // switch (state)
+
+  // BREAK finished in this call -> update statistics
+  #if defined(LIN_MASTER_STATS)
+    if ((stateOld == LIN_Master::STATE_BREAK) && (this->state == LIN_Master::STATE_BODY))
+      this->_statsBreak();
+  #endif
+
+  // frame finished in this call -> notify user
+  if ((this->state == LIN_Master::STATE_DONE) && (stateOld != LIN_Master::STATE_DONE))
+    this->_frameDone();
+
+  // bus idle -> directly start next queued frame (if any)
+  if ((this->queueJob != NULL) && (this->state == LIN_Master::STATE_IDLE))
+    this->_startJob();
+
+  // update duration of handler() incl. callbacks
+  #if defined(LIN_MASTER_STATS)
+    uint32_t dt = LIN_Master_Timebase::ticksToUs(LIN_Master_Timebase::getTicks() - timeEntry);
+    this->stats.numHandler++;
+    this->stats.timeHandlerSum += dt;
+    if (dt > this->stats.timeHandlerMax)
+      this->stats.timeHandlerMax = dt;
+  #endif
   
   // return state machine state
   return this->state;
@@ -20,7 +20,38 @@
 #define BUFLEN_NAME        30           //!< max. length of node name
 
 //#define LIN_DEBUG_SERIAL   Serial       //!< Serial interface used for debug output
-//#define LIN_DEBUG_LEVEL    2            //!< Debug level (0=no output, 1=error msg, 2=sent/received bytes)
+//#define LIN_DEBUG_LEVEL    2            //!< Debug level (0=no output, 1=error msg, 2=sent/received bytes). For low-overhead frame logging see attachTrace()
+
+//#define LIN_MASTER_STATS                //!< collect frame timing and error statistics, see getStats()
+
+//#define LIN_MASTER_TIMEBASE_HW          //!< use hardware counter instead of micros() for frame timing, see LIN_master_Timebase.h
+
+//#define LIN_MASTER_COMPACT              //!< RAM-minimal profile e.g. for ATtiny: name not copied, single receive buffer, 16bit frame timing
+#define LIN_MASTER_RAM_COMPACT  109       //!< RAM [B] of LIN_Master base class in compact profile on AVR (w/o statistics, 175B without compact profile). Checked at compile time
+
+#define LIN_BACKOFF_TIMEOUTS  3           //!< consecutive timeouts of a slave response ID until backoff, see attachResponseTable()
+#define LIN_BACKOFF_SKIP      16          //!< number of skipped slave response frames during backoff, see skipFrame()
+
+#define LIN_WAKEUP_DELAY      100         //!< default delay [ms] after wake-up pulse until first frame, see wakeup()
+#define LIN_WAKEUP_PULSE      1000        //!< duration [us] of wake-up pulse via GPIO (250..5000us)
+#define LIN_IDLE_TIMEOUT      4000        //!< bus idle time [ms] after which LIN 2.x slaves enter sleep mode, see setIdleTimeout()
+
+// Tx and Rx buffers are separate also in the compact profile: block-wise backends (SoftwareSerial_Timer, USART_SAM,
+// UART_ESP32) store the echo in bufRx and compare it with bufTx after the frame. HardwareSerial incl. ESP8266 and ESP32
+// check the echo byte-wise via _storeByte()
+#if defined(LIN_MASTER_COMPACT)
+  #define LIN_BAUDRATE_CACHE  1           //!< number of baudrates with precomputed timing for per-frame switching, see setBaudrate()
+  #define LIN_BUFRX_NUM       1           //!< number of receive buffers. Single buffer: frame view is only valid until next frame start
+#else
+  #define LIN_BAUDRATE_CACHE  4           //!< number of baudrates with precomputed timing for per-frame switching, see setBaudrate()
+  #define LIN_BUFRX_NUM       2           //!< number of receive buffers. Double buffer: last completed frame stays readable during next frame
+#endif
+
+#define LIN_TRACE_SYNC        0xA5        //!< first byte of binary trace record, see attachTrace()
+#define LIN_TRACE_HEADER      13          //!< length of trace record without data, checksum and XOR byte
+
+/// compiler memory barrier for lock-free queues shared between ISR/task and application
+#define LIN_MEMORY_BARRIER()   __asm__ __volatile__ ("" ::: "memory")
 
 
 /*-----------------------------------------------------------------------------
@@ -28,6 +59,7 @@
 -----------------------------------------------------------------------------*/
 
 #include <Arduino.h>
+#include "LIN_master_Timebase.h"
 
 
 /*-----------------------------------------------------------------------------
@@ -44,6 +76,14 @@ class LIN_Master
   // PUBLIC TYPEDEFS
   public:
 
+    /// frame timing [ticks], see LIN_Master_Timebase. Compact profile: 16bit, i.e. frame timeout is limited to 65535 ticks
+    #if defined(LIN_MASTER_COMPACT)
+      typedef uint16_t    ticks_t;
+    #else
+      typedef uint32_t    ticks_t;
+    #endif
+
+
     /// LIN protocol version 
     typedef enum
     {
@@ -56,7 +96,9 @@ class LIN_Master
     typedef enum
     {
         MASTER_REQUEST = 1,                       //!< LIN master request frame
-        SLAVE_RESPONSE = 2                        //!< LIN slave response frame
+        SLAVE_RESPONSE = 2,                       //!< LIN slave response frame
+        EVENT_TRIGGERED = 3,                      //!< LIN 2.x event triggered frame. ERROR_TIMEOUT = no event, ERROR_CHK = collision
+        SPORADIC       = 4                        //!< LIN 2.x sporadic frame (schedule slot only, sent as master request)
     } frame_t;
 
 
@@ -68,6 +110,8 @@ class LIN_Master
         STATE_BREAK   = 2,                        //!< sync break is being transmitted
         STATE_BODY    = 3,                        //!< rest of frame is being sent/received
         STATE_DONE    = 4,                        //!< frame completed
+        STATE_SLEEP   = 5,                        //!< bus in sleep mode. Frames are rejected or queued, see wakeup()
+        STATE_WAKEUP  = 6,                        //!< wake-up pulse sent or received, waiting for slaves to become ready
     } state_t;
 
 
@@ -83,16 +127,120 @@ class LIN_Master
     } error_t;
 
 
+    /// callback for finished frame. Called from handler() when STATE_DONE is reached
+    typedef void (*callback_t)(LIN_Master &LIN);
+
+
+    /// record of a finished frame, e.g. for result queue
+    typedef struct
+    {
+      LIN_Master::frame_t   type;                 //!< frame type
+      uint8_t               id;                   //!< frame identifier (protected or unprotected)
+      uint8_t               numData;              //!< number of data bytes
+      uint8_t               data[8];              //!< data bytes
+      LIN_Master::error_t   error;                //!< frame error
+      uint32_t              timestamp;            //!< micros() when frame was finished
+    } result_t;
+
+
+    /// callback for a single frame. Is passed when starting the frame
+    typedef void (*callbackFrame_t)(const LIN_Master::result_t &Result);
+
+
+    /// queued frame, e.g. for job queue
+    typedef struct
+    {
+      LIN_Master::frame_t   type;                 //!< frame type
+      LIN_Master::version_t version;              //!< LIN protocol version
+      uint8_t               id;                   //!< frame identifier (protected or unprotected)
+      uint8_t               numData;              //!< number of data bytes
+      uint8_t               data[8];              //!< data bytes for master request
+      LIN_Master::callbackFrame_t callback;       //!< optional function called when frame is finished
+    } job_t;
+
+
+    /// learned response timing of a slave response ID, see attachResponseTable()
+    typedef struct
+    {
+      uint16_t              timeFrame;            //!< learned max. frame duration [us] (0 = not yet learned)
+      uint8_t               numTimeout;           //!< number of consecutive timeouts (saturated at 255)
+      uint8_t               numSkip;              //!< remaining frames to skip in backoff, see skipFrame()
+    } response_t;
+
+
+    /// forward declaration of cache entry for subscriber type
+    struct cache_s;
+
+
+    /// subscriber for changed slave response data. Called from handler(), see subscribe()
+    typedef void (*callbackChange_t)(LIN_Master &LIN, const struct cache_s &Entry);
+
+
+    /// last-value cache entry of a slave response ID for change detection, see attachChangeCache()
+    typedef struct cache_s
+    {
+      uint8_t               id;                   //!< frame identifier 0x00..0x3F (0xFF = unused entry)
+      uint8_t               numData;              //!< number of data bytes of last error-free frame (0 = not yet received)
+      uint8_t               data[8];              //!< last received data
+      uint8_t               diff[8];              //!< bits changed since last notification or readChanges() (dirty mask)
+      volatile bool         changed;              //!< data changed since last notification or readChanges()
+      uint8_t               numChanges;           //!< number of detected changes (overflows), e.g. for detecting missed changes
+      LIN_Master::callbackChange_t callback;      //!< subscriber called on change (NULL = poll via readChanges())
+    } cache_t;
+
+
+    /// zero-copy view of last completed frame, see getFrameView()
+    typedef struct
+    {
+      const uint8_t         *data;                //!< data bytes in receive buffer. Valid while checkFrameView() is true
+      LIN_Master::frame_t   type;                 //!< frame type
+      uint8_t               id;                   //!< frame identifier (protected or unprotected)
+      uint8_t               numData;              //!< number of data bytes
+      LIN_Master::error_t   error;                //!< frame error
+      uint8_t               seq;                  //!< sequence number of frame, see getFrameSeq()
+    } view_t;
+
+
+    /// frame timing and error statistics (only with LIN_MASTER_STATS). Times in [us], sums wrap after ~71min
+    typedef struct
+    {
+      uint32_t              numFrames;            //!< number of finished frames
+      uint32_t              numErrors;            //!< number of frames with error
+      uint32_t              numErrorEcho;         //!< number of frames with ERROR_ECHO
+      uint32_t              numErrorTimeout;      //!< number of frames with ERROR_TIMEOUT
+      uint32_t              numErrorChk;          //!< number of frames with ERROR_CHK
+      uint32_t              numErrorOther;        //!< number of frames with ERROR_STATE or ERROR_MISC
+      uint32_t              numRetries;           //!< number of repeated frames, see retryFrame()
+      uint32_t              numBreak;             //!< number of finished BREAKs
+      uint32_t              timeBreakMin;         //!< min. time from frame start to end of BREAK
+      uint32_t              timeBreakMax;         //!< max. time from frame start to end of BREAK
+      uint32_t              timeBreakSum;         //!< sum of times from frame start to end of BREAK
+      uint32_t              numResponse;          //!< number of error-free frames
+      uint32_t              timeResponseMin;      //!< min. time from end of BREAK to end of frame (error-free frames)
+      uint32_t              timeResponseMax;      //!< max. time from end of BREAK to end of frame (error-free frames)
+      uint32_t              timeResponseSum;      //!< sum of times from end of BREAK to end of frame (error-free frames)
+      uint32_t              numHandler;           //!< number of handler() calls
+      uint32_t              timeHandlerMax;       //!< max. duration of handler() incl. callbacks
+      uint32_t              timeHandlerSum;       //!< sum of durations of handler() incl. callbacks
+      uint32_t              timeBusy;             //!< sum of frame durations, i.e. bus busy time
+      uint32_t              timeReset;            //!< micros() at last resetStats()
+    } stats_t;
+
+
   // PROTECTED VARIABLES
   protected:
 
     // node properties
     uint16_t              baudrate;               //!< communication baudrate [Baud]
+    uint16_t              baudrateNominal;        //!< baudrate [Baud] set in begin(), see setBaudrate()
+    uint16_t              cacheBaudrate[LIN_BAUDRATE_CACHE];    //!< baudrates [Baud] with precomputed timing (0 = unused)
+    LIN_Master::ticks_t   cacheTimePerByte[LIN_BAUDRATE_CACHE]; //!< time [ticks] per byte for above baudrates
+    uint8_t               idxCache;               //!< next cache entry to replace
     LIN_Master::state_t   state;                  //!< status of LIN state machine
     LIN_Master::error_t   error;                  //!< error state. Is latched until cleared
-    uint32_t              timePerByte;            //!< time [us] per byte at specified baudrate
-    uint32_t              timeStart;              //!< starting time [us] for frame timeout
-    uint32_t              timeMax;                //!< max. frame duration [us]
+    LIN_Master::ticks_t   timePerByte;            //!< time [ticks] per byte at specified baudrate, see LIN_Master_Timebase
+    LIN_Master::ticks_t   timeStart;              //!< starting time [ticks] for frame timeout (compact profile: lower 16bit)
+    LIN_Master::ticks_t   timeMax;                //!< max. frame duration [ticks]
 
     // frame properties
     LIN_Master::version_t version;                //!< LIN protocol version
@@ -101,27 +249,174 @@ class LIN_Master
     uint8_t               lenTx;                  //!< send buffer length (max. 12)
     uint8_t               bufTx[12];              //!< send buffer incl. BREAK, SYNC, DATA and CHK (max. 12B)
     uint8_t               lenRx;                  //!< receive buffer length (max. 12)
-    uint8_t               bufRx[12];              //!< receive buffer incl. BREAK, SYNC, DATA and CHK (max. 12B)
+    uint8_t               *bufRx;                 //!< receive buffer of current frame incl. BREAK, SYNC, DATA and CHK (max. 12B)
+    uint8_t               numRx;                  //!< number of bytes already stored in bufRx, see _storeByte()
+
+    // double-buffered receive buffer (single producer: handler(), single consumer: application)
+    uint8_t               bufFrame[LIN_BUFRX_NUM][12];  //!< receive buffers. Current frame is received in bufFrame[idxRx]
+    uint8_t               idxRx;                  //!< index of receive buffer of current frame
+    volatile uint8_t      idxDone;                //!< index of receive buffer of last completed frame
+    volatile uint8_t      seqDone;                //!< sequence number of last completed frame
+    LIN_Master::frame_t   typeDone;               //!< type of last completed frame
+    uint8_t               idDone;                 //!< identifier of last completed frame
+    uint8_t               lenDone;                //!< receive length of last completed frame
+    LIN_Master::error_t   errorDone;              //!< error of last completed frame
+
+    // event handling
+    LIN_Master::callback_t callback;              //!< user function called when frame is finished (NULL = none)
+    LIN_Master::callbackFrame_t callbackFrame;    //!< user function for current frame only (NULL = none)
+
+    // result queue (single producer: handler(), single consumer: application)
+    LIN_Master::result_t  *queueResult;           //!< buffer for finished frames (NULL = no queue)
+    uint8_t               sizeResult;             //!< size of result buffer
+    volatile uint8_t      headResult;             //!< index of next record to write
+    volatile uint8_t      tailResult;             //!< index of next record to read
+    uint8_t               lostResults;            //!< number of lost records due to full queue (saturated)
+
+    // job queue (single producer: application, single consumer: handler())
+    LIN_Master::job_t     *queueJob;              //!< buffer for frames to send (NULL = no queue)
+    uint8_t               sizeJob;                //!< size of job buffer
+    volatile uint8_t      headJob;                //!< index of next job to write
+    volatile uint8_t      tailJob;                //!< index of next job to start
+    uint8_t               lostJobs;               //!< number of frames dropped due to full job queue (saturated)
+
+    // adaptive timeout
+    LIN_Master::response_t *tableResponse;        //!< learned response timing per ID 0x00..0x3F (NULL = fixed timeout)
+
+    // change detection
+    LIN_Master::cache_t   *tableCache;            //!< last-value cache of subscribed slave response IDs (NULL = no change detection)
+    uint8_t               sizeCache;              //!< number of cache entries
+
+    // power management
+    bool                  sleepPending;           //!< enter sleep mode after go-to-sleep command
+    uint16_t              delayWakeup;            //!< delay [ms] after wake-up until first frame
+    uint16_t              timeoutIdle;            //!< bus idle time [ms] until sleep mode (0 = disabled)
+    uint32_t              timeActivity;           //!< millis() at last bus activity
+    uint32_t              timeWakeup;             //!< millis() at wake-up
+
+    // binary frame trace (single producer: handler(), single consumer: application)
+    uint8_t               *bufTrace;              //!< ring buffer for trace records (NULL = no trace)
+    uint16_t              sizeTrace;              //!< size of trace buffer [B]
+    volatile uint16_t     headTrace;              //!< index of next byte to write
+    volatile uint16_t     tailTrace;              //!< index of next byte to drain
+    uint8_t               lostTrace;              //!< number of lost records due to full buffer (saturated)
+
+    // frame statistics
+    #if defined(LIN_MASTER_STATS)
+      LIN_Master::stats_t stats;                  //!< timing and error statistics
+      LIN_Master::ticks_t timeBody;               //!< time [ticks] at end of BREAK
+    #endif
 
 
   // PUBLIC VARIABLES
   public:
 
-    char                  nameLIN[BUFLEN_NAME];   //!< LIN node name, e.g. for debug
+    #if defined(LIN_MASTER_COMPACT)
+      const char          *nameLIN;               //!< LIN node name, e.g. for debug. Compact profile: name passed to constructor, not copied
+    #else
+      char                nameLIN[BUFLEN_NAME];   //!< LIN node name, e.g. for debug. Is truncated to BUFLEN_NAME-1 characters
+    #endif
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    static const uint8_t  tablePID[64];           //!< protected IDs for ID 0x00..0x3F (in PROGMEM)
 
 
   // PROTECTED METHODS
   protected:
   
-    /// @brief Calculate protected frame ID
-    uint8_t _calculatePID(void);
+    /// @brief Calculate protected frame ID of current frame
+    inline uint8_t _calculatePID(void) { return LIN_Master::calculatePID(this->id); }
 
-    /// @brief Calculate LIN frame checksum
-    uint8_t _calculateChecksum(uint8_t NumData, uint8_t Data[]);
+    /// @brief Calculate LIN frame checksum of current frame
+    inline uint8_t _calculateChecksum(uint8_t NumData, const uint8_t Data[])
+      { return LIN_Master::calculateChecksum(this->version, this->id, NumData, Data); }
 
     /// @brief Check received LIN frame
     LIN_Master::error_t _checkFrame(void);
 
+    /// @brief Store received byte and check its echo. On mismatch abort frame with ERROR_ECHO and return false
+    inline bool _storeByte(uint8_t Byte)
+    {
+      this->bufRx[this->numRx] = Byte;
+      if ((this->numRx < this->lenTx) && (Byte != this->bufTx[this->numRx]))
+      {
+        this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_ECHO);
+        this->state = LIN_Master::STATE_DONE;
+        return false;
+      }
+      this->numRx++;
+      return true;
+    }
+
+    /// @brief Frame finished, notify user
+    void _frameDone(void);
+
+    /// @brief Select receive buffer for new frame, keeping last completed frame readable (if double-buffered)
+    inline void _selectBufRx(void) { this->idxRx = (this->idxDone + 1) % LIN_BUFRX_NUM; this->bufRx = this->bufFrame[this->idxRx]; }
+
+    /// @brief Getter for time [ticks] since start of frame
+    inline LIN_Master::ticks_t _elapsed(void) { return (LIN_Master::ticks_t) (LIN_Master_Timebase::getTicks() - this->timeStart); }
+
+    /// @brief Check if frame timeout has elapsed
+    inline bool _checkTimeout(void) { return (this->_elapsed() > this->timeMax); }
+
+    /// @brief Getter for timeout [ticks] of frame with Len bytes incl. BREAK (= 150% nominal, saturated)
+    inline LIN_Master::ticks_t _frameTimeout(uint8_t Len)
+    {
+      uint32_t  timeout = (((uint32_t) (Len + 1) * this->timePerByte) * 3) >> 1;
+      return (timeout > (LIN_Master::ticks_t) ~0UL) ? (LIN_Master::ticks_t) ~0UL : (LIN_Master::ticks_t) timeout;
+    }
+
+    /// @brief Set timeout of slave response frame from learned response time
+    void _adaptTimeout(void);
+
+    /// @brief Learn response time of finished slave response frame
+    void _learnResponse(void);
+
+    /// @brief Getter for cache entry of an ID (NULL = not subscribed)
+    LIN_Master::cache_t *_findCache(uint8_t Id);
+
+    /// @brief Update last-value cache with finished slave response and notify subscriber on change
+    void _updateCache(void);
+
+    /// @brief Copy current frame into result record
+    void _getResult(LIN_Master::result_t &Result);
+
+    /// @brief Append binary record of current frame to trace buffer
+    void _traceFrame(void);
+
+    #if defined(LIN_MASTER_STATS)
+
+      /// @brief Update statistics at end of BREAK
+      void _statsBreak(void);
+
+      /// @brief Update statistics at end of frame
+      void _statsFrame(void);
+
+    #endif // LIN_MASTER_STATS
+
+    /// @brief Start a LIN master request frame, bypassing the job queue
+    LIN_Master::state_t _sendMasterRequest(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[], LIN_Master::callbackFrame_t Callback = NULL);
+
+    /// @brief Start a LIN slave response frame, bypassing the job queue
+    LIN_Master::state_t _receiveSlaveResponse(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, LIN_Master::callbackFrame_t Callback = NULL,
+      LIN_Master::frame_t Type = LIN_Master::SLAVE_RESPONSE);
+
+    /// @brief Start oldest frame from job queue
+    void _startJob(void);
+
+    /// @brief Append frame to job queue if bus is busy or older jobs are pending (drop if full)
+    bool _deferFrame(LIN_Master::frame_t Type, LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[], LIN_Master::callbackFrame_t Callback);
+
+    /// @brief Append frame to job queue
+    bool _queueFrame(LIN_Master::frame_t Type, LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[], LIN_Master::callbackFrame_t Callback);
+
+    /// @brief Finish ongoing and queued frames
+    void _flushJobs(void);
+
     /// @brief Send LIN break
     virtual LIN_Master::state_t _sendBreak(void);
 
@@ -131,9 +426,50 @@ class LIN_Master
     /// @brief Receive LIN frame
     virtual LIN_Master::state_t _receiveFrame(void);
 
+    /// @brief Send wake-up pulse
+    virtual void _sendWakeup(void);
+
+    /// @brief Check for wake-up pulse from a slave
+    virtual bool _receiveWakeup(void);
+
+    /// @brief Apply changed baudrate to interface without re-opening it
+    virtual void _setBaudrate(void);
+
+    /// @brief Getter for (precomputed) time per byte at a baudrate
+    LIN_Master::ticks_t _getTimePerByte(uint16_t Baudrate);
+
 
   // PUBLIC METHODS
   public:
+
+    /// @brief Calculate protected frame ID at compile time (for run time use calculatePID())
+    static constexpr uint8_t protectID(uint8_t Id)
+    {
+      return (uint8_t) ((Id & 0x3F) |
+        (((Id ^ (Id>>1) ^ (Id>>2) ^ (Id>>4)) & 0x01) << 6) |        // PI0 = ID0^ID1^ID2^ID4
+        ((~((Id>>1) ^ (Id>>3) ^ (Id>>4) ^ (Id>>5)) & 0x01) << 7));   // PI1 = ~(ID1^ID3^ID4^ID5)
+    }
+
+    /// @brief Calculate protected frame ID via lookup table
+    static inline uint8_t calculatePID(uint8_t Id) { return pgm_read_byte(&(LIN_Master::tablePID[Id & 0x3F])); }
+
+    /// @brief Getter for checksum start value, i.e. PID for LIN2.x enhanced checksum, else 0 (LIN1.x and diagnostic frames 0x3C/0x3D)
+    static constexpr uint8_t checksumSeed(LIN_Master::version_t Version, uint8_t Id)
+    {
+      return ((Version == LIN_Master::LIN_V1) || ((Id & 0x3F) == 0x3C) || ((Id & 0x3F) == 0x3D)) ? 0x00 : LIN_Master::protectID(Id);
+    }
+
+    /// @brief Calculate LIN frame checksum from start value (see checksumSeed())
+    static uint8_t checksumKernel(uint8_t Seed, uint8_t NumData, const uint8_t Data[]);
+
+    /// @brief Calculate LIN frame checksum for protocol version and ID known at compile time
+    template <LIN_Master::version_t Version, uint8_t Id>
+    static inline uint8_t calculateChecksum(uint8_t NumData, const uint8_t Data[])
+      { return LIN_Master::checksumKernel(LIN_Master::checksumSeed(Version, Id), NumData, Data); }
+
+    /// @brief Calculate LIN frame checksum
+    static uint8_t calculateChecksum(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[]);
+
   
     /// @brief LIN master node constructor
     LIN_Master(const char NameLIN[]);
@@ -144,6 +480,18 @@ class LIN_Master
     
     /// @brief Close serial interface
     virtual void end(void);
+
+    /// @brief Set baudrate for next frames without re-opening interface (0 = baudrate of begin())
+    bool setBaudrate(uint16_t Baudrate);
+
+    /// @brief Getter for current baudrate [Baud]
+    inline uint16_t getBaudrate(void) { return this->baudrate; }
+
+    /// @brief Getter for nominal baudrate [Baud] set in begin(), i.e. used for frames with baudrate 0
+    inline uint16_t getNominalBaudrate(void) { return this->baudrateNominal; }
+
+    /// @brief Find baudrate of a slave by polling a slave response frame at candidate baudrates (blocking)
+    uint16_t probeBaudrate(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint16_t Rates[] = NULL, uint8_t NumRates = 0);
     
     
     /// @brief Reset LIN state machine
@@ -158,6 +506,123 @@ class LIN_Master
     
     /// @brief Getter for LIN state machine error
     inline LIN_Master::error_t getError(void) { return this->error; }
+
+
+    /// @brief Attach callback for finished frames (NULL = detach)
+    inline void attachCallback(LIN_Master::callback_t Callback) { this->callback = Callback; }
+
+
+    /// @brief Attach buffer for queue of finished frames (NULL = detach)
+    void attachResultQueue(LIN_Master::result_t Buffer[], uint8_t Size);
+
+    /// @brief Getter for number of queued results
+    uint8_t availableResults(void);
+
+    /// @brief Read oldest result from queue
+    bool readResult(LIN_Master::result_t &Result);
+
+    /// @brief Read up to Max results from queue
+    uint8_t readResults(LIN_Master::result_t Results[], uint8_t Max);
+
+    /// @brief Getter for number of lost results due to full queue (saturated at 255)
+    inline uint8_t getLostResults(void) { return this->lostResults; }
+
+    /// @brief Clear number of lost results
+    inline void resetLostResults(void) { this->lostResults = 0; }
+
+
+    /// @brief Attach buffer for queue of frames to send (NULL = detach)
+    void attachJobQueue(LIN_Master::job_t Buffer[], uint8_t Size);
+
+    /// @brief Getter for number of free job queue entries
+    uint8_t freeJobs(void);
+
+    /// @brief Getter for number of frames dropped due to full job queue (saturated at 255)
+    inline uint8_t getLostJobs(void) { return this->lostJobs; }
+
+    /// @brief Clear number of dropped frames
+    inline void resetLostJobs(void) { this->lostJobs = 0; }
+
+    /// @brief Append a master request frame to job queue
+    inline bool queueMasterRequest(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[], LIN_Master::callbackFrame_t Callback = NULL)
+      { return this->_queueFrame(LIN_Master::MASTER_REQUEST, Version, Id, NumData, Data, Callback); }
+
+    /// @brief Append a slave response frame to job queue
+    inline bool queueSlaveResponse(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, LIN_Master::callbackFrame_t Callback = NULL)
+      { return this->_queueFrame(LIN_Master::SLAVE_RESPONSE, Version, Id, NumData, NULL, Callback); }
+
+    /// @brief Append an event triggered frame to job queue
+    inline bool queueEventTriggered(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, LIN_Master::callbackFrame_t Callback = NULL)
+      { return this->_queueFrame(LIN_Master::EVENT_TRIGGERED, Version, Id, NumData, NULL, Callback); }
+
+
+    /// @brief Attach table for adaptive slave response timeouts (NULL = detach)
+    void attachResponseTable(LIN_Master::response_t Table[64]);
+
+    /// @brief Check if slave response frame should be skipped due to backoff (counts skipped frames)
+    bool skipFrame(uint8_t Id);
+
+    /// @brief Check if slave response ID is in backoff (doesn't count skipped frames)
+    bool isBackoff(uint8_t Id);
+
+
+    /// @brief Attach table for last-value cache of slave responses with change detection (NULL = detach)
+    void attachChangeCache(LIN_Master::cache_t Table[], uint8_t Size);
+
+    /// @brief Subscribe to changes of a slave response ID. Callback NULL = poll via readChanges()
+    bool subscribe(uint8_t Id, LIN_Master::callbackChange_t Callback = NULL);
+
+    /// @brief Check if cached data of an ID has changed since last notification or readChanges()
+    bool isChanged(uint8_t Id);
+
+    /// @brief Copy cached data and dirty mask of an ID, and clear change flag. Returns true if data has changed
+    bool readChanges(uint8_t Id, uint8_t Data[], uint8_t Diff[] = NULL, uint8_t *NumData = NULL);
+
+
+    /// @brief Send go-to-sleep command in background, then enter sleep mode
+    bool goToSleep(void);
+
+    /// @brief Send wake-up pulse and resume after wake-up delay
+    bool wakeup(void);
+
+    /// @brief Set delay [ms] after wake-up until first frame
+    inline void setWakeupDelay(uint16_t Delay) { this->delayWakeup = Delay; }
+
+    /// @brief Set bus idle time [ms] after which sleep mode is entered (0 = disabled)
+    inline void setIdleTimeout(uint16_t Timeout) { this->timeoutIdle = Timeout; }
+
+    /// @brief Getter for time [ms] since last bus activity
+    inline uint32_t getIdleTime(void) { return millis() - this->timeActivity; }
+
+
+    /// @brief Attach ring buffer for binary trace of finished frames (NULL = detach)
+    void attachTrace(uint8_t Buffer[], uint16_t Size);
+
+    /// @brief Getter for number of trace bytes not yet drained
+    uint16_t availableTrace(void);
+
+    /// @brief Write up to Max trace bytes to a stream, e.g. Serial. Returns number of written bytes
+    uint16_t drainTrace(Print &Port, uint16_t Max = 0xFFFF);
+
+    /// @brief Getter for number of lost trace records due to full buffer (saturated at 255)
+    inline uint8_t getLostTrace(void) { return this->lostTrace; }
+
+    /// @brief Clear number of lost trace records
+    inline void resetLostTrace(void) { this->lostTrace = 0; }
+
+
+    #if defined(LIN_MASTER_STATS)
+
+      /// @brief Getter for copy of frame statistics
+      void getStats(LIN_Master::stats_t &Stats);
+
+      /// @brief Reset frame statistics
+      void resetStats(void);
+
+      /// @brief Getter for bus utilization since resetStats() [0.1%]
+      uint16_t getBusLoad(void);
+
+    #endif // LIN_MASTER_STATS
     
     
     /// @brief Getter for LIN frame
@@ -171,19 +636,41 @@ class LIN_Master
       interrupts();                 // re-enable ISRs
     }
 
+
+
+    /// @brief Getter for sequence number of last completed frame, e.g. for detecting new frames
+    inline uint8_t getFrameSeq(void) { return this->seqDone; }
+
+    /// @brief Getter for zero-copy view of last completed frame (no copy, no ISR masking)
+    bool getFrameView(LIN_Master::view_t &View);
+
+    /// @brief Check if view is still valid, i.e. no newer frame was completed meanwhile
+    #if (LIN_BUFRX_NUM > 1)
+      inline bool checkFrameView(const LIN_Master::view_t &View) { LIN_MEMORY_BARRIER(); return (this->seqDone == View.seq); }
+    #else
+      inline bool checkFrameView(const LIN_Master::view_t &View)
+        { LIN_MEMORY_BARRIER(); return ((this->seqDone == View.seq) && (this->state != LIN_Master::STATE_BREAK) && (this->state != LIN_Master::STATE_BODY)); }
+    #endif
+
     
     /// @brief Start sending a LIN master request frame in background (if supported)
-    LIN_Master::state_t sendMasterRequest(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, uint8_t Data[]);
+    LIN_Master::state_t sendMasterRequest(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, uint8_t Data[], LIN_Master::callbackFrame_t Callback = NULL);
     
     /// @brief Send a blocking LIN master request frame (no background operation)
     LIN_Master::error_t sendMasterRequestBlocking(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, uint8_t Data[]);
 
     /// @brief Start sending a LIN slave response frame in background (if supported)
-    LIN_Master::state_t receiveSlaveResponse(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData);
+    LIN_Master::state_t receiveSlaveResponse(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, LIN_Master::callbackFrame_t Callback = NULL);
     
     /// @brief Send a blocking LIN slave response frame (no background operation)
     LIN_Master::error_t receiveSlaveResponseBlocking(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, uint8_t *Data);
 
+    /// @brief Start a LIN event triggered frame in background (if supported). First data byte is PID of responding frame
+    LIN_Master::state_t receiveEventTriggered(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, LIN_Master::callbackFrame_t Callback = NULL);
+
+    /// @brief Repeat last frame in background (if supported), e.g. after ERROR_TIMEOUT or ERROR_CHK
+    LIN_Master::state_t retryFrame(void);
+
     /// @brief Handle LIN background operation (call until STATE_DONE is returned)
     LIN_Master::state_t handler(void);
 
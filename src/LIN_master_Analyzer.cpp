@@ -0,0 +1,112 @@
+/**
+  \file     LIN_master_Analyzer.cpp
+  \brief    Bus load and schedule feasibility analyzer for LIN master emulation
+  \details  This library checks schedule tables against the frame timing of LIN and of this library, and calculates
+            cycle time and bus load. For details see LIN_master_Analyzer.h.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "LIN_master_Analyzer.h"
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Analyze a schedule table at run time
+  \details    Analyze a schedule table at run time, e.g. for tables received from a host. Same results as the
+              constexpr methods, but iterative, i.e. with low stack usage
+  \param[in]  Table       array of frame slots
+  \param[in]  NumSlots    number of frame slots in table
+  \param[in]  Baudrate    baudrate [Baud] of LIN_Master::begin(), used for slots with baudrate 0
+  \param[out] Result      cycle times, bus load and violations of table
+  \param[in]  Space       inter-frame space [us] required after a frame within its slot
+*/
+void LIN_Master_Analyzer::analyze(const LIN_Master_Schedule::slot_t Table[], uint8_t NumSlots, uint16_t Baudrate,
+  LIN_Master_Analyzer::result_t &Result, uint32_t Space)
+{
+  uint32_t  sumNominal = 0;
+  uint32_t  sumWorst = 0;
+  uint8_t   violation;
+
+  // init result
+  memset(&Result, 0, sizeof(Result));
+  Result.firstInfeasible = 0xFF;
+
+  // no valid table
+  if ((Table == NULL) || (Baudrate == 0))
+    return;
+
+  // loop over slots
+  for (uint8_t i=0; i<NumSlots; i++)
+  {
+    const LIN_Master_Schedule::slot_t   *pSlot = Table + i;
+
+    // check slot timing, incl. collision resolution table of event triggered slot
+    violation = LIN_Master_Analyzer::checkSlot(*pSlot, Baudrate, Space);
+    if ((pSlot->type == LIN_Master::EVENT_TRIGGERED) && (pSlot->table != NULL))
+    {
+      for (uint8_t j=0; j<pSlot->numSlots; j++)
+        violation |= LIN_Master_Analyzer::checkSlot(pSlot->table[j], Baudrate, Space);
+    }
+    Result.violations |= violation;
+    if (violation & (LIN_Master_Analyzer::SLOT_NOMINAL | LIN_Master_Analyzer::SLOT_MAX | LIN_Master_Analyzer::SLOT_INVALID))
+    {
+      if (Result.numInfeasible == 0)
+        Result.firstInfeasible = i;
+      Result.numInfeasible++;
+    }
+
+    // sum up bus occupancy and slot durations
+    sumNominal          += LIN_Master_Analyzer::slotNominal(*pSlot, Baudrate);
+    sumWorst            += LIN_Master_Analyzer::slotWorst(*pSlot, Baudrate);
+    Result.cycleNominal += LIN_Master_Analyzer::_duration(LIN_Master_Analyzer::TIME_NOMINAL, *pSlot, Baudrate);
+    Result.cycleWorst   += LIN_Master_Analyzer::_duration(LIN_Master_Analyzer::TIME_WORST, *pSlot, Baudrate);
+
+  } // loop over slots
+
+  // calculate bus load
+  Result.loadNominal = LIN_Master_Analyzer::_percent(sumNominal, Result.cycleNominal);
+  Result.loadWorst   = LIN_Master_Analyzer::_percent(sumWorst, Result.cycleWorst);
+
+} // LIN_Master_Analyzer::analyze()
+
+
+
+/**
+  \brief      Create copy of a schedule table with suggested slot times
+  \details    Create copy of a schedule table with minimal slot times, which still tolerate worst-case frames,
+              i.e. frame timeout and immediate retries, plus inter-frame space, rounded up to the time base.
+              Back-to-back slots (slot time 0) are kept. Collision resolution tables and associated frames of
+              sporadic slots are referenced, not copied
+  \param[in]  Table       array of frame slots
+  \param[out] Compressed  array of frame slots with suggested slot times. May be identical to Table for RAM tables
+  \param[in]  NumSlots    number of frame slots in table
+  \param[in]  Baudrate    baudrate [Baud] of LIN_Master::begin(), used for slots with baudrate 0
+  \param[in]  Space       inter-frame space [us] required after a frame within its slot
+  \param[in]  TimeBase    time base [us] of slot times, e.g. 1000 for LDF tables (must be >0)
+*/
+void LIN_Master_Analyzer::compress(const LIN_Master_Schedule::slot_t Table[], LIN_Master_Schedule::slot_t Compressed[], uint8_t NumSlots,
+  uint16_t Baudrate, uint32_t Space, uint32_t TimeBase)
+{
+  // no valid table
+  if ((Table == NULL) || (Compressed == NULL) || (Baudrate == 0) || (TimeBase == 0))
+    return;
+
+  // copy slots with suggested slot times
+  for (uint8_t i=0; i<NumSlots; i++)
+  {
+    uint32_t  slotTime = LIN_Master_Analyzer::suggestSlot(Table[i], Baudrate, Space, TimeBase);
+
+    Compressed[i] = Table[i];
+    Compressed[i].slotTime = slotTime;
+  }
+
+} // LIN_Master_Analyzer::compress()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
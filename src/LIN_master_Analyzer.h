@@ -0,0 +1,232 @@
+/**
+  \file     LIN_master_Analyzer.h
+  \brief    Bus load and schedule feasibility analyzer for LIN master emulation
+  \details  This library checks schedule tables against the frame timing of LIN and of this library, and calculates
+            cycle time and bus load. Per slot, three frame durations are distinguished:
+              - nominal: header (34 bit) and response (10 bit per byte incl. checksum) without gaps
+              - max: 140% of nominal, i.e. the max. frame duration allowed by LIN, e.g. for slow slaves
+              - worst: frame timeout of the LIN master node (150% of BREAK..CHK, see sendMasterRequest()), i.e. if the
+                slave is silent, multiplied with the number of immediate retries (see LIN_Master_Schedule::retry_t)
+            A slot shorter than nominal or max. frame duration (incl. inter-frame space) is infeasible, a slot
+            shorter than worst case delays the schedule if a slave is silent. All timing functions are constexpr,
+            i.e. constexpr schedule tables can be checked at compile time via static_assert(). A compressed table
+            with minimal slot times which still tolerate worst-case frames is created via compress().
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_ANALYZER_H_
+#define _LIN_MASTER_ANALYZER_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <Arduino.h>
+#include "LIN_master.h"
+#include "LIN_master_Schedule.h"
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+#define LIN_ANALYZER_SPACE      0           //!< default inter-frame space [us] required after a frame within its slot
+#define LIN_ANALYZER_TIMEBASE   1000        //!< default time base [us] of slot times suggested by compress()
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  LIN schedule analyzer class
+
+  \details LIN schedule analyzer class. Static methods only, i.e. no instance is required.
+    Slot time 0 (back-to-back) is always feasible. Baudrate 0 of a slot refers to the baudrate passed to the analyzer.
+    Collision resolution tables of event triggered slots are checked, but not counted in cycle time and bus load.
+*/
+class LIN_Master_Analyzer
+{
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// timing violations of a slot. Use bitmasks, as violations can be combined
+    typedef enum
+    {
+      SLOT_OK         = 0x00,                     //!< slot time is sufficient for worst-case frame
+      SLOT_NOMINAL    = 0x01,                     //!< slot shorter than nominal frame -> always overruns
+      SLOT_MAX        = 0x02,                     //!< slot shorter than max. frame (140% nominal) -> overruns for slow slaves
+      SLOT_TIMEOUT    = 0x04,                     //!< slot shorter than frame timeout incl. immediate retries -> overruns if slave is silent
+      SLOT_INVALID    = 0x08                      //!< invalid number of data bytes (not 1..8)
+    } violation_t;
+
+
+    /// result of schedule table analysis
+    typedef struct
+    {
+      uint32_t              cycleNominal;         //!< table cycle time [us] with nominal frames
+      uint32_t              cycleWorst;           //!< table cycle time [us] with worst-case frames
+      uint8_t               loadNominal;          //!< bus load [%] with nominal frames
+      uint8_t               loadWorst;            //!< bus load [%] with worst-case frames
+      uint8_t               violations;           //!< violations of all slots, see violation_t
+      uint8_t               numInfeasible;        //!< number of infeasible slots (SLOT_NOMINAL, SLOT_MAX or SLOT_INVALID)
+      uint8_t               firstInfeasible;      //!< index of first infeasible slot (0xFF = none)
+    } result_t;
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// frame duration used for analysis
+    typedef enum
+    {
+      TIME_NOMINAL    = 0,                        //!< nominal frame duration
+      TIME_MAX        = 1,                        //!< max. frame duration (140% nominal)
+      TIME_WORST      = 2                         //!< frame timeout of master node incl. immediate retries
+    } timing_t;
+
+    /// @brief Convert 1/10 bit times to duration [us] at baudrate (rounded up)
+    static constexpr uint32_t _tenthBitsToUs(uint32_t TenthBits, uint16_t Baudrate)
+      { return (TenthBits * 100000UL + Baudrate - 1) / Baudrate; }
+
+    /// @brief Getter for larger of two values
+    static constexpr uint32_t _max(uint32_t A, uint32_t B)
+      { return (A > B) ? A : B; }
+
+    /// @brief Getter for effective baudrate of a slot
+    static constexpr uint16_t _baudrate(const LIN_Master_Schedule::slot_t &Slot, uint16_t Baudrate)
+      { return (Slot.baudrate != 0) ? Slot.baudrate : Baudrate; }
+
+    /// @brief Getter for duration [us] of the frame of a slot. Worst case incl. immediate retries (not for event triggered frames)
+    static constexpr uint32_t _frame(timing_t Time, const LIN_Master_Schedule::slot_t &Slot, uint16_t Baudrate)
+    {
+      return (Time == TIME_NOMINAL) ? frameNominal(Slot.numData, _baudrate(Slot, Baudrate)) :
+        (Time == TIME_MAX) ? frameMax(Slot.numData, _baudrate(Slot, Baudrate)) :
+        frameTimeout(Slot.numData, _baudrate(Slot, Baudrate)) *
+          (((Slot.type != LIN_Master::EVENT_TRIGGERED) && (Slot.retry == LIN_Master_Schedule::RETRY_IMMEDIATE)) ? (1UL + Slot.retries) : 1UL);
+    }
+
+    /// @brief Getter for max. frame duration [us] of a list, i.e. associated frames of a sporadic slot
+    static constexpr uint32_t _list(timing_t Time, const LIN_Master_Schedule::slot_t List[], uint8_t Num, uint16_t Baudrate)
+    {
+      return (Num == 0) ? 0 : _max(_frame(Time, List[0], Baudrate), _list(Time, List+1, Num-1, Baudrate));
+    }
+
+    /// @brief Getter for bus occupancy [us] of a slot, i.e. duration of its (largest) frame
+    static constexpr uint32_t _occupancy(timing_t Time, const LIN_Master_Schedule::slot_t &Slot, uint16_t Baudrate)
+    {
+      return (Slot.type == LIN_Master::SPORADIC) ?
+        ((Slot.table != NULL) ? _list(Time, Slot.table, Slot.numSlots, Baudrate) : 0) :
+        _frame(Time, Slot, Baudrate);
+    }
+
+    /// @brief Getter for duration [us] of a slot, i.e. slot time or longer frame (overrun, back-to-back)
+    static constexpr uint32_t _duration(timing_t Time, const LIN_Master_Schedule::slot_t &Slot, uint16_t Baudrate)
+      { return _max(Slot.slotTime, _occupancy(Time, Slot, Baudrate)); }
+
+    /// @brief Sum of bus occupancy [us] of all slots of a table
+    static constexpr uint32_t _sumOccupancy(timing_t Time, const LIN_Master_Schedule::slot_t Table[], uint8_t Num, uint16_t Baudrate)
+      { return (Num == 0) ? 0 : _occupancy(Time, Table[0], Baudrate) + _sumOccupancy(Time, Table+1, Num-1, Baudrate); }
+
+    /// @brief Sum of durations [us] of all slots of a table, i.e. cycle time
+    static constexpr uint32_t _sumDuration(timing_t Time, const LIN_Master_Schedule::slot_t Table[], uint8_t Num, uint16_t Baudrate)
+      { return (Num == 0) ? 0 : _duration(Time, Table[0], Baudrate) + _sumDuration(Time, Table+1, Num-1, Baudrate); }
+
+    /// @brief Calculate percentage (w/o overflow for long cycles)
+    static constexpr uint8_t _percent(uint32_t Part, uint32_t Total)
+      { return (Total == 0) ? 0 : (uint8_t) ((Total > 40000000UL) ? (Part / (Total / 100)) : ((100UL * Part) / Total)); }
+
+    /// @brief Check if all slots of a table incl. collision resolution tables are feasible
+    static constexpr bool _feasible(const LIN_Master_Schedule::slot_t Table[], uint8_t Num, uint16_t Baudrate, uint32_t Space)
+    {
+      return (Num == 0) ||
+        (((checkSlot(Table[0], Baudrate, Space) & (SLOT_NOMINAL | SLOT_MAX | SLOT_INVALID)) == 0) &&
+        ((Table[0].type != LIN_Master::EVENT_TRIGGERED) || (Table[0].table == NULL) || _feasible(Table[0].table, Table[0].numSlots, Baudrate, Space)) &&
+        _feasible(Table+1, Num-1, Baudrate, Space));
+    }
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Getter for nominal frame duration [us], i.e. 34 bit header + 10 bit per data and checksum byte
+    static constexpr uint32_t frameNominal(uint8_t NumData, uint16_t Baudrate)
+      { return _tenthBitsToUs(10UL * (34 + 10 * (NumData + 1)), Baudrate); }
+
+    /// @brief Getter for max. frame duration [us] allowed by LIN, i.e. 140% nominal
+    static constexpr uint32_t frameMax(uint8_t NumData, uint16_t Baudrate)
+      { return _tenthBitsToUs(14UL * (34 + 10 * (NumData + 1)), Baudrate); }
+
+    /// @brief Getter for frame timeout [us] of LIN master node, i.e. 150% of BREAK..CHK (see LIN_Master::_frameTimeout())
+    static constexpr uint32_t frameTimeout(uint8_t NumData, uint16_t Baudrate)
+      { return (((uint32_t) (NumData + 5) * (10000000UL / Baudrate)) * 3) >> 1; }
+
+    /// @brief Getter for nominal bus occupancy [us] of a slot. Sporadic slot: largest associated frame
+    static constexpr uint32_t slotNominal(const LIN_Master_Schedule::slot_t &Slot, uint16_t Baudrate)
+      { return _occupancy(TIME_NOMINAL, Slot, Baudrate); }
+
+    /// @brief Getter for max. bus occupancy [us] of a slot allowed by LIN
+    static constexpr uint32_t slotMax(const LIN_Master_Schedule::slot_t &Slot, uint16_t Baudrate)
+      { return _occupancy(TIME_MAX, Slot, Baudrate); }
+
+    /// @brief Getter for worst-case bus occupancy [us] of a slot, i.e. frame timeout incl. immediate retries
+    static constexpr uint32_t slotWorst(const LIN_Master_Schedule::slot_t &Slot, uint16_t Baudrate)
+      { return _occupancy(TIME_WORST, Slot, Baudrate); }
+
+    /// @brief Check slot timing, returns violation_t bitmask (SLOT_OK = no violation). Slot time 0 is always sufficient
+    static constexpr uint8_t checkSlot(const LIN_Master_Schedule::slot_t &Slot, uint16_t Baudrate, uint32_t Space = LIN_ANALYZER_SPACE)
+    {
+      return (uint8_t) (((Slot.type != LIN_Master::SPORADIC) && ((Slot.numData < 1) || (Slot.numData > 8)) ? SLOT_INVALID : SLOT_OK) |
+        (((Slot.slotTime != 0) && (Slot.slotTime < slotNominal(Slot, Baudrate) + Space)) ? SLOT_NOMINAL : SLOT_OK) |
+        (((Slot.slotTime != 0) && (Slot.slotTime < slotMax(Slot, Baudrate) + Space)) ? SLOT_MAX : SLOT_OK) |
+        (((Slot.slotTime != 0) && (Slot.slotTime < slotWorst(Slot, Baudrate) + Space)) ? SLOT_TIMEOUT : SLOT_OK));
+    }
+
+    /// @brief Getter for suggested slot time [us], i.e. worst-case occupancy and space rounded up to time base (0 = keep back-to-back)
+    static constexpr uint32_t suggestSlot(const LIN_Master_Schedule::slot_t &Slot, uint16_t Baudrate,
+      uint32_t Space = LIN_ANALYZER_SPACE, uint32_t TimeBase = LIN_ANALYZER_TIMEBASE)
+    {
+      return (Slot.slotTime == 0) ? 0 :
+        ((slotWorst(Slot, Baudrate) + Space + TimeBase - 1) / TimeBase) * TimeBase;
+    }
+
+    /// @brief Getter for cycle time [us] of a table with nominal frames
+    static constexpr uint32_t cycleNominal(const LIN_Master_Schedule::slot_t Table[], uint8_t NumSlots, uint16_t Baudrate)
+      { return _sumDuration(TIME_NOMINAL, Table, NumSlots, Baudrate); }
+
+    /// @brief Getter for cycle time [us] of a table with worst-case frames, i.e. with slot overruns
+    static constexpr uint32_t cycleWorst(const LIN_Master_Schedule::slot_t Table[], uint8_t NumSlots, uint16_t Baudrate)
+      { return _sumDuration(TIME_WORST, Table, NumSlots, Baudrate); }
+
+    /// @brief Getter for bus load [%] of a table with nominal frames
+    static constexpr uint8_t loadNominal(const LIN_Master_Schedule::slot_t Table[], uint8_t NumSlots, uint16_t Baudrate)
+      { return _percent(_sumOccupancy(TIME_NOMINAL, Table, NumSlots, Baudrate), cycleNominal(Table, NumSlots, Baudrate)); }
+
+    /// @brief Getter for bus load [%] of a table with worst-case frames
+    static constexpr uint8_t loadWorst(const LIN_Master_Schedule::slot_t Table[], uint8_t NumSlots, uint16_t Baudrate)
+      { return _percent(_sumOccupancy(TIME_WORST, Table, NumSlots, Baudrate), cycleWorst(Table, NumSlots, Baudrate)); }
+
+    /// @brief Check if all slots of a table are feasible, i.e. no SLOT_NOMINAL, SLOT_MAX or SLOT_INVALID (e.g. for static_assert())
+    static constexpr bool isFeasible(const LIN_Master_Schedule::slot_t Table[], uint8_t NumSlots, uint16_t Baudrate, uint32_t Space = LIN_ANALYZER_SPACE)
+      { return (Table != NULL) && (Baudrate != 0) && _feasible(Table, NumSlots, Baudrate, Space); }
+
+    /// @brief Analyze a schedule table at run time (iterative, i.e. low stack usage)
+    static void analyze(const LIN_Master_Schedule::slot_t Table[], uint8_t NumSlots, uint16_t Baudrate,
+      LIN_Master_Analyzer::result_t &Result, uint32_t Space = LIN_ANALYZER_SPACE);
+
+    /// @brief Create copy of a schedule table with suggested slot times, see suggestSlot()
+    static void compress(const LIN_Master_Schedule::slot_t Table[], LIN_Master_Schedule::slot_t Compressed[], uint8_t NumSlots,
+      uint16_t Baudrate, uint32_t Space = LIN_ANALYZER_SPACE, uint32_t TimeBase = LIN_ANALYZER_TIMEBASE);
+
+}; // class LIN_Master_Analyzer
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_ANALYZER_H_
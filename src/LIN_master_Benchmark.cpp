@@ -0,0 +1,191 @@
+/**
+  \file     LIN_master_Benchmark.cpp
+  \brief    On-target benchmark for LIN master emulation
+  \details  This library measures frame rate, CPU time per frame, handler() cost and frame duration jitter
+            of a LIN master node, and prints the results as CSV for regression tracking.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "LIN_master_Benchmark.h"
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor for LIN benchmark
+  \details    Constructor for LIN benchmark. Store pointer to LIN master node under test.
+  \param[in]  Interface     LIN master node under test
+*/
+LIN_Master_Benchmark::LIN_Master_Benchmark(LIN_Master &Interface)
+{
+  // store pointer to LIN node
+  this->pLIN = &Interface;
+
+  // default frame: master request works without slave (only echo required)
+  this->setFrame(LIN_Master::MASTER_REQUEST, 0x1A, 8);
+
+} // LIN_Master_Benchmark::LIN_Master_Benchmark()
+
+
+
+/**
+  \brief      Set frame used for benchmark
+  \details    Set frame used for benchmark. Master requests only require the LIN echo, slave responses require a slave node
+  \param[in]  Type        frame type
+  \param[in]  Id          frame identifier
+  \param[in]  NumData     number of data bytes (0..8)
+*/
+void LIN_Master_Benchmark::setFrame(LIN_Master::frame_t Type, uint8_t Id, uint8_t NumData)
+{
+  // store frame properties
+  this->type    = Type;
+  this->id      = Id;
+  this->numData = (NumData <= 8) ? NumData : 8;
+
+  // data pattern for master request
+  for (uint8_t i=0; i<8; i++)
+    this->data[i] = 0x55 ^ i;
+
+} // LIN_Master_Benchmark::setFrame()
+
+
+
+/**
+  \brief      Run benchmark at specified baudrate
+  \details    Re-open LIN node with specified baudrate and send frames back-to-back for the specified duration.
+              handler() is polled as fast as possible. CPU time per frame is the time spent in the frame start
+              function plus in handler() calls which changed the state, i.e. excludes idle polling. For blocking
+              backends (e.g. SoftwareSerial) this is the complete frame duration.
+              Jitter is the difference between max. and min. frame duration.
+  \param[in]  Baudrate    communication speed [Baud]
+  \param[in]  Duration    measurement duration [ms]
+  \param[out] Result      benchmark result
+*/
+void LIN_Master_Benchmark::run(uint16_t Baudrate, uint32_t Duration, LIN_Master_Benchmark::result_t &Result)
+{
+  LIN_Master::state_t   stateOld, state;
+  uint32_t              timeBegin, timeFrame, timeCall, dt;
+
+  // init result
+  memset(&Result, 0, sizeof(Result));
+  Result.baudrate     = Baudrate;
+  Result.duration     = Duration;
+  Result.timeFrameMin = 0xFFFFFFFF;
+
+  // re-open LIN node with specified baudrate
+  this->pLIN->end();
+  this->pLIN->begin(Baudrate);
+
+  // send frames back-to-back
+  timeBegin = millis();
+  while (millis() - timeBegin < Duration)
+  {
+    // start frame
+    this->pLIN->resetStateMachine();
+    this->pLIN->resetError();
+    timeFrame = micros();
+    if (this->type == LIN_Master::MASTER_REQUEST)
+      state = this->pLIN->sendMasterRequest(LIN_Master::LIN_V2, this->id, this->numData, this->data);
+    else
+      state = this->pLIN->receiveSlaveResponse(LIN_Master::LIN_V2, this->id, this->numData);
+    Result.timeCpu += micros() - timeFrame;
+
+    // poll handler until frame is finished
+    while ((state == LIN_Master::STATE_BREAK) || (state == LIN_Master::STATE_BODY))
+    {
+      stateOld = state;
+      timeCall = micros();
+      state    = this->pLIN->handler();
+      dt       = micros() - timeCall;
+
+      // update handler statistics
+      Result.numHandler++;
+      Result.timeHandlerSum += dt;
+      if (dt > Result.timeHandlerMax)
+        Result.timeHandlerMax = dt;
+
+      // state changed -> count as CPU time for frame
+      if (state != stateOld)
+        Result.timeCpu += dt;
+    }
+
+    // update frame statistics
+    dt = micros() - timeFrame;
+    Result.numFrames++;
+    if (this->pLIN->getError() != LIN_Master::NO_ERROR)
+      Result.numErrors++;
+    if (dt < Result.timeFrameMin)
+      Result.timeFrameMin = dt;
+    if (dt > Result.timeFrameMax)
+      Result.timeFrameMax = dt;
+
+  } // benchmark loop
+
+  // release LIN node
+  this->pLIN->resetStateMachine();
+  this->pLIN->resetError();
+
+} // LIN_Master_Benchmark::run()
+
+
+
+/**
+  \brief      Print CSV header line
+  \details    Print CSV header line for printResult(). Times in [us]
+  \param[in]  Out     output stream, e.g. Serial
+*/
+void LIN_Master_Benchmark::printHeader(Print &Out)
+{
+  Out.println("BENCH,name,baudrate,frames,errors,frames_per_s,cpu_per_frame,handler_avg,handler_max,frame_min,frame_max,jitter");
+
+} // LIN_Master_Benchmark::printHeader()
+
+
+
+/**
+  \brief      Print result as CSV line
+  \details    Print benchmark result as CSV line with prefix "BENCH" for easy filtering. Times in [us]
+  \param[in]  Out       output stream, e.g. Serial
+  \param[in]  Name      name of backend / board
+  \param[in]  Result    benchmark result
+*/
+void LIN_Master_Benchmark::printResult(Print &Out, const char Name[], const LIN_Master_Benchmark::result_t &Result)
+{
+  uint32_t    fps10 = (Result.duration > 0) ? (Result.numFrames * 10000UL) / Result.duration : 0;   // [0.1 frames/s]
+  uint32_t    frames = (Result.numFrames > 0) ? Result.numFrames : 1;
+  uint32_t    calls  = (Result.numHandler > 0) ? Result.numHandler : 1;
+
+  Out.print("BENCH,");
+  Out.print(Name);
+  Out.print(',');
+  Out.print((unsigned long) Result.baudrate);
+  Out.print(',');
+  Out.print((unsigned long) Result.numFrames);
+  Out.print(',');
+  Out.print((unsigned long) Result.numErrors);
+  Out.print(',');
+  Out.print((unsigned long) (fps10 / 10));
+  Out.print('.');
+  Out.print((unsigned long) (fps10 % 10));
+  Out.print(',');
+  Out.print((unsigned long) (Result.timeCpu / frames));
+  Out.print(',');
+  Out.print((unsigned long) (Result.timeHandlerSum / calls));
+  Out.print(',');
+  Out.print((unsigned long) Result.timeHandlerMax);
+  Out.print(',');
+  Out.print((unsigned long) ((Result.numFrames > 0) ? Result.timeFrameMin : 0));
+  Out.print(',');
+  Out.print((unsigned long) Result.timeFrameMax);
+  Out.print(',');
+  Out.println((unsigned long) ((Result.numFrames > 0) ? (Result.timeFrameMax - Result.timeFrameMin) : 0));
+
+} // LIN_Master_Benchmark::printResult()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
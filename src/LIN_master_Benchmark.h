@@ -0,0 +1,89 @@
+/**
+  \file     LIN_master_Benchmark.h
+  \brief    On-target benchmark for LIN master emulation
+  \details  This library measures frame rate, CPU time per frame, handler() cost and frame duration jitter
+            of a LIN master node, and prints the results as CSV for regression tracking.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_BENCHMARK_H_
+#define _LIN_MASTER_BENCHMARK_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <Arduino.h>
+#include "LIN_master.h"
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  LIN master benchmark
+
+  \details LIN master benchmark. Sends frames back-to-back on a LIN master node and measures timing.
+*/
+class LIN_Master_Benchmark
+{
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// benchmark result for one baudrate. Times in [us]
+    typedef struct
+    {
+      uint16_t              baudrate;             //!< communication baudrate [Baud]
+      uint32_t              duration;             //!< measurement duration [ms]
+      uint32_t              numFrames;            //!< number of finished frames
+      uint32_t              numErrors;            //!< number of frames with error
+      uint32_t              timeCpu;              //!< sum of CPU time for frame start and state changing handler() calls
+      uint32_t              numHandler;           //!< number of handler() calls
+      uint32_t              timeHandlerSum;       //!< sum of handler() durations
+      uint32_t              timeHandlerMax;       //!< max. handler() duration
+      uint32_t              timeFrameMin;         //!< min. frame duration (start to STATE_DONE)
+      uint32_t              timeFrameMax;         //!< max. frame duration (start to STATE_DONE)
+    } result_t;
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    LIN_Master            *pLIN;                  //!< pointer to LIN master node under test
+    LIN_Master::frame_t   type;                   //!< frame type used for benchmark
+    uint8_t               id;                     //!< frame identifier used for benchmark
+    uint8_t               numData;                //!< number of data bytes used for benchmark
+    uint8_t               data[8];                //!< data bytes for master request
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_Benchmark(LIN_Master &Interface);
+
+    /// @brief Set frame used for benchmark (default: master request 0x1A with 8 bytes)
+    void setFrame(LIN_Master::frame_t Type, uint8_t Id, uint8_t NumData);
+
+    /// @brief Run benchmark at specified baudrate
+    void run(uint16_t Baudrate, uint32_t Duration, result_t &Result);
+
+    /// @brief Print CSV header line
+    static void printHeader(Print &Out);
+
+    /// @brief Print result as CSV line
+    static void printResult(Print &Out, const char Name[], const result_t &Result);
+
+}; // class LIN_Master_Benchmark
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_BENCHMARK_H_
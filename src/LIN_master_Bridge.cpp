@@ -0,0 +1,588 @@
+/**
+  \file     LIN_master_Bridge.cpp
+  \brief    LIN-to-host bridge with batched, COBS framed binary protocol
+  \details  This library turns a LIN master node into a LIN interface for host tools, e.g. via USB or Wi-Fi. Host
+            commands are decoded on the fly, and frame results are COBS encoded into a double-buffered transmit
+            path. For protocol details see LIN_master_Bridge.h.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "LIN_master_Bridge.h"
+
+
+/**************************
+ * PROTECTED METHODS
+**************************/
+
+/**
+  \brief      Decode a byte received from host
+  \details    Decode a COBS encoded byte received from host. Each code byte gives the distance to the next replaced
+              0x00 (0xFF = block of 254 bytes without 0x00). The packet delimiter 0x00 executes the decoded packet.
+              Invalid and too long packets are skipped until the next delimiter
+  \param[in]  Byte      received byte
+*/
+void LIN_Master_Bridge::_receiveByte(uint8_t Byte)
+{
+  // delimiter -> execute complete packet, report incomplete packet. Repeated delimiters are ignored
+  if (Byte == 0x00)
+  {
+    if ((this->invalidRx) || (this->remainRx != 0))
+      this->error |= LIN_Master_Bridge::ERROR_FRAMING;
+    else if (this->lenRx > 0)
+      this->_processPacket();
+
+    // wait for next packet
+    this->lenRx     = 0;
+    this->codeRx    = 0;
+    this->remainRx  = 0;
+    this->invalidRx = false;
+    return;
+  }
+
+  // skip rest of invalid packet
+  if (this->invalidRx)
+    return;
+
+  // code byte -> restore 0x00 of previous block (not after a block of 254 bytes)
+  if (this->remainRx == 0)
+  {
+    if ((this->codeRx != 0) && (this->codeRx != 0xFF))
+    {
+      if (this->lenRx >= LIN_BRIDGE_SIZE_RX)
+      {
+        this->invalidRx = true;                               // packet too long -> skip until next delimiter
+        return;
+      }
+      this->bufRx[this->lenRx++] = 0x00;
+    }
+    this->codeRx   = Byte;
+    this->remainRx = Byte - 1;
+    return;
+  }
+
+  // data byte
+  if (this->lenRx >= LIN_BRIDGE_SIZE_RX)
+  {
+    this->invalidRx = true;                                   // packet too long -> skip until next delimiter
+    return;
+  }
+  this->bufRx[this->lenRx++] = Byte;
+  this->remainRx--;
+
+} // LIN_Master_Bridge::_receiveByte()
+
+
+
+/**
+  \brief      Execute all commands of a decoded host packet
+  \details    Execute all commands of a decoded host packet in order. An unknown or truncated command aborts the packet
+*/
+void LIN_Master_Bridge::_processPacket(void)
+{
+  uint16_t  pos = 0;
+  uint16_t  len;
+
+  // execute commands until end of packet or error
+  while (pos < this->lenRx)
+  {
+    len = this->_command(this->bufRx + pos, this->lenRx - pos);
+    if (len == 0)
+    {
+      this->error |= LIN_Master_Bridge::ERROR_COMMAND;
+      return;
+    }
+    pos += len;
+  }
+
+} // LIN_Master_Bridge::_processPacket()
+
+
+
+/**
+  \brief      Execute a host command
+  \details    Check and execute a host command. One-shot frames are appended to the job queue of the LIN node, i.e.
+              they are sent between schedule slots. A new schedule table stops the schedule, see LIN_BRIDGE_CMD_START
+  \param[in]  Cmd       command incl. parameters
+  \param[in]  Len       remaining length of packet
+  \return     command length, or 0 if command is unknown or truncated
+*/
+uint16_t LIN_Master_Bridge::_command(const uint8_t Cmd[], uint16_t Len)
+{
+  LIN_Master::frame_t     type;
+  LIN_Master::version_t   version;
+  uint16_t                len;
+  uint8_t                 numSlots;
+  uint16_t                numEntries;
+  uint8_t                 idx;
+  bool                    ok;
+
+  // act according to command
+  switch (Cmd[0])
+  {
+    // one-shot frame: cmd, type | version<<4, ID, numData, data (master request only)
+    case LIN_BRIDGE_CMD_FRAME:
+      if ((Len < 4) || (Cmd[3] > 8))
+        return 0;
+      type    = (LIN_Master::frame_t) (Cmd[1] & 0x0F);
+      version = (LIN_Master::version_t) (Cmd[1] >> 4);
+      len     = 4 + ((type == LIN_Master::MASTER_REQUEST) ? Cmd[3] : 0);
+      if (Len < len)
+        return 0;
+      if (type == LIN_Master::MASTER_REQUEST)
+        ok = this->pLIN->queueMasterRequest(version, Cmd[2], Cmd[3], Cmd + 4);
+      else if (type == LIN_Master::SLAVE_RESPONSE)
+        ok = this->pLIN->queueSlaveResponse(version, Cmd[2], Cmd[3]);
+      else if (type == LIN_Master::EVENT_TRIGGERED)
+        ok = this->pLIN->queueEventTriggered(version, Cmd[2], Cmd[3]);
+      else
+        return 0;
+      if (!ok)
+        this->error |= LIN_Master_Bridge::ERROR_FULL;
+      return len;
+
+    // schedule table: cmd, numSlots, per slot: type | version<<4, ID, numData, slot time [us] (4B), retries | policy<<7,
+    // data (master request) or numEntries and entries of collision resolution table (event triggered)
+    case LIN_BRIDGE_CMD_SCHEDULE:
+      if (Len < 2)
+        return 0;
+      numSlots = Cmd[1];
+
+      // check complete command before changing table. Count entries incl. collision resolution tables
+      len = 2;
+      numEntries = numSlots;
+      for (uint8_t i=0; i<numSlots; i++)
+      {
+        uint16_t  lenSlot = this->_checkSlot(Cmd + len, Len - len, false, numEntries);
+        if (lenSlot == 0)
+          return 0;
+        len += lenSlot;
+      }
+      if (numEntries > LIN_BRIDGE_SLOTS)
+      {
+        this->error |= LIN_Master_Bridge::ERROR_FULL;
+        return len;
+      }
+
+      // stop schedule and replace table. Started frames keep their own copy of the data.
+      // Collision resolution tables are stored after the slots
+      this->schedule.stop();
+      len = 2;
+      idx = numSlots;
+      for (uint8_t i=0; i<numSlots; i++)
+      {
+        LIN_Master_Schedule::slot_t   *pSlot = this->table + i;
+        this->_decodeSlot(pSlot, Cmd + len);
+        len += 8;
+        if (pSlot->type == LIN_Master::MASTER_REQUEST)
+        {
+          memcpy(this->dataSlot[i], Cmd + len, pSlot->numData);
+          pSlot->data = this->dataSlot[i];
+          len += pSlot->numData;
+        }
+        else if (pSlot->type == LIN_Master::EVENT_TRIGGERED)
+        {
+          pSlot->table    = this->table + idx;
+          pSlot->numSlots = Cmd[len++];
+          for (uint8_t j=0; j<pSlot->numSlots; j++)
+          {
+            this->_decodeSlot(this->table + (idx++), Cmd + len);
+            len += 8;
+          }
+        }
+      }
+      if (!this->schedule.setTable(this->table, numSlots))
+        this->error |= LIN_Master_Bridge::ERROR_COMMAND;
+      return len;
+
+    // start schedule with first slot
+    case LIN_BRIDGE_CMD_START:
+      this->schedule.start();
+      return 1;
+
+    // stop schedule after current frame
+    case LIN_BRIDGE_CMD_STOP:
+      this->schedule.stop();
+      return 1;
+
+    // unknown command
+    default:
+      return 0;
+
+  } // switch (Cmd)
+
+} // LIN_Master_Bridge::_command()
+
+
+
+/**
+  \brief      Check a schedule slot of a host command
+  \details    Check a schedule slot of a host command for valid frame type and length, incl. the entries of the
+              collision resolution table of an event triggered slot. Entries must be slave responses
+  \param[in]  Slot        encoded slot
+  \param[in]  Len         remaining length of packet
+  \param[in]  Entry       slot is entry of a collision resolution table
+  \param[in,out] NumEntries  number of table entries, incremented by entries of collision resolution table
+  \return     slot length, or 0 if slot is invalid or truncated
+*/
+uint16_t LIN_Master_Bridge::_checkSlot(const uint8_t Slot[], uint16_t Len, bool Entry, uint16_t &NumEntries)
+{
+  LIN_Master::frame_t     type;
+  uint16_t                len = 8;
+
+  // check fixed part
+  if ((Len < len) || (Slot[2] > 8))
+    return 0;
+  type = (LIN_Master::frame_t) (Slot[0] & 0x0F);
+
+  // entry of collision resolution table -> only slave response
+  if (Entry)
+    return (type == LIN_Master::SLAVE_RESPONSE) ? len : 0;
+
+  // master request -> data follow
+  if (type == LIN_Master::MASTER_REQUEST)
+    len += Slot[2];
+
+  // event triggered -> collision resolution table follows
+  else if (type == LIN_Master::EVENT_TRIGGERED)
+  {
+    if (Len < len + 1)
+      return 0;
+    NumEntries += Slot[len];
+    for (uint8_t i=Slot[len++]; i>0; i--)
+    {
+      if (this->_checkSlot(Slot + len, Len - len, true, NumEntries) == 0)
+        return 0;
+      len += 8;
+    }
+  }
+
+  // other types are not supported
+  else if (type != LIN_Master::SLAVE_RESPONSE)
+    return 0;
+
+  // return slot length, if complete
+  return (Len < len) ? 0 : len;
+
+} // LIN_Master_Bridge::_checkSlot()
+
+
+
+/**
+  \brief      Decode fixed part of a schedule slot of a host command
+  \details    Decode frame type, version, ID, number of data bytes, slot time and retries of a schedule slot.
+              Data and collision resolution table are set by the caller
+  \param[out] pSlot       decoded table entry
+  \param[in]  Slot        encoded slot, checked via _checkSlot()
+*/
+void LIN_Master_Bridge::_decodeSlot(LIN_Master_Schedule::slot_t *pSlot, const uint8_t Slot[])
+{
+  memset(pSlot, 0, sizeof(LIN_Master_Schedule::slot_t));
+  pSlot->type     = (LIN_Master::frame_t) (Slot[0] & 0x0F);
+  pSlot->version  = (LIN_Master::version_t) (Slot[0] >> 4);
+  pSlot->id       = Slot[1];
+  pSlot->numData  = Slot[2];
+  pSlot->slotTime = (uint32_t) Slot[3] | ((uint32_t) Slot[4] << 8) | ((uint32_t) Slot[5] << 16) | ((uint32_t) Slot[6] << 24);
+  pSlot->retries  = Slot[7] & 0x7F;
+  pSlot->retry    = (Slot[7] & 0x80) ? LIN_Master_Schedule::RETRY_NEXT_SLOT : LIN_Master_Schedule::RETRY_IMMEDIATE;
+
+} // LIN_Master_Bridge::_decodeSlot()
+
+
+
+/**
+  \brief      Append a byte to the packet being filled
+  \details    Append a byte to the packet being filled with COBS encoding. A 0x00 closes the current block by
+              setting its code byte, a block of 254 non-zero bytes is closed with code 0xFF
+  \param[in]  Byte      byte to append
+*/
+void LIN_Master_Bridge::_encodeByte(uint8_t Byte)
+{
+  uint8_t   *buf = this->bufTx[this->idxTx];
+
+  // 0x00 -> close block, start next block
+  if (Byte == 0x00)
+  {
+    buf[this->posCode] = (uint8_t) (this->lenTx - this->posCode);
+    this->posCode = this->lenTx++;
+    return;
+  }
+
+  // other byte -> append. Block of 254 bytes -> close block without 0x00
+  buf[this->lenTx++] = Byte;
+  if (this->lenTx - this->posCode == 0xFF)
+  {
+    buf[this->posCode] = 0xFF;
+    this->posCode = this->lenTx++;
+  }
+
+} // LIN_Master_Bridge::_encodeByte()
+
+
+
+/**
+  \brief      Append a record to the packet being filled
+  \details    Append a record to the packet being filled. A new packet starts with its sequence number.
+              COBS adds max. one byte per record (Len < 254), plus the delimiter, i.e. the check is exact enough
+  \param[in]  Record    record to append
+  \param[in]  Len       length of record
+  \return     true if record was added, false if buffer is full
+*/
+bool LIN_Master_Bridge::_encodeRecord(const uint8_t Record[], uint8_t Len)
+{
+  // buffer empty -> start packet with sequence number
+  if (this->lenTx == 0)
+  {
+    this->posCode = 0;
+    this->lenTx   = 1;
+    this->timeTx  = micros();
+    this->_encodeByte(this->seqTx);
+  }
+
+  // check free space incl. COBS overhead and delimiter
+  if (this->lenTx + Len + 2 > LIN_BRIDGE_SIZE_TX)
+    return false;
+
+  // encode record
+  for (uint8_t i=0; i<Len; i++)
+    this->_encodeByte(Record[i]);
+  return true;
+
+} // LIN_Master_Bridge::_encodeRecord()
+
+
+
+/**
+  \brief      Terminate packet being filled and swap transmit buffers
+  \details    Set last code byte, append delimiter and pass buffer to _sendPacket(). Buffer being sent must be idle
+*/
+void LIN_Master_Bridge::_finishPacket(void)
+{
+  uint8_t   *buf = this->bufTx[this->idxTx];
+
+  // close last block and terminate packet
+  buf[this->posCode]   = (uint8_t) (this->lenTx - this->posCode);
+  buf[this->lenTx++]   = 0x00;
+
+  // send this buffer, fill other buffer
+  this->lenSend = this->lenTx;
+  this->posSend = 0;
+  this->idxTx  ^= 1;
+  this->lenTx   = 0;
+  this->seqTx++;
+
+} // LIN_Master_Bridge::_finishPacket()
+
+
+
+/**
+  \brief      Write buffer being sent to host
+  \details    Write as many bytes of the buffer being sent as the host link accepts without blocking
+*/
+void LIN_Master_Bridge::_sendPacket(void)
+{
+  uint16_t  len;
+  int       space;
+
+  // nothing to send
+  if (this->lenSend == 0)
+    return;
+
+  // get free space of host link
+  #if defined(ARDUINO_ARCH_SAM) || defined(LIN_BRIDGE_WRITE_CHUNKS)
+    space = LIN_BRIDGE_CHUNK;                                 // availableForWrite() not supported by host link
+  #else
+    space = this->pHost->availableForWrite();
+  #endif
+  if (space <= 0)
+    return;
+
+  // write next part of packet
+  len = this->lenSend - this->posSend;
+  if (len > (uint16_t) space)
+    len = (uint16_t) space;
+  this->pHost->write(this->bufTx[this->idxTx ^ 1] + this->posSend, len);
+  this->posSend += len;
+
+  // packet completely sent -> buffer is free
+  if (this->posSend >= this->lenSend)
+    this->lenSend = 0;
+
+} // LIN_Master_Bridge::_sendPacket()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor for LIN bridge
+  \details    Constructor for LIN bridge. Store pointers to LIN node and host link
+  \param[in]  Interface     LIN master node
+  \param[in]  Host          host link, e.g. Serial
+*/
+LIN_Master_Bridge::LIN_Master_Bridge(LIN_Master &Interface, Stream &Host) : schedule(Interface)
+{
+  // store pointers to LIN node and host link
+  this->pLIN      = &Interface;
+  this->pHost     = &Host;
+
+  // initialize bridge properties
+  this->timeFlush = LIN_BRIDGE_FLUSH;
+  this->error     = LIN_Master_Bridge::NO_ERROR;
+  this->lenRx     = 0;
+  this->codeRx    = 0;
+  this->remainRx  = 0;
+  this->invalidRx = false;
+  this->idxTx     = 0;
+  this->lenTx     = 0;
+  this->posCode   = 0;
+  this->timeTx    = 0;
+  this->seqTx     = 0;
+  this->lenSend   = 0;
+  this->posSend   = 0;
+
+} // LIN_Master_Bridge::LIN_Master_Bridge()
+
+
+
+/**
+  \brief      Start bridge
+  \details    Start bridge. Attach job and result queue to LIN node, which must already be opened via begin()
+  \param[in]  FlushTime   max. delay [us] of a result until its packet is sent. Longer = fewer, larger packets
+*/
+void LIN_Master_Bridge::begin(uint32_t FlushTime)
+{
+  // store parameters in class variables
+  this->timeFlush = FlushTime;
+
+  // reset host link
+  this->error     = LIN_Master_Bridge::NO_ERROR;
+  this->lenRx     = 0;
+  this->codeRx    = 0;
+  this->remainRx  = 0;
+  this->invalidRx = false;
+  this->lenTx     = 0;
+  this->lenSend   = 0;
+
+  // frames are started back-to-back by LIN node, results are collected in queue
+  this->pLIN->attachJobQueue(this->queueJob, LIN_BRIDGE_JOBS);
+  this->pLIN->attachResultQueue(this->queueResult, LIN_BRIDGE_RESULTS);
+
+} // LIN_Master_Bridge::begin()
+
+
+
+/**
+  \brief      Stop bridge
+  \details    Stop bridge and schedule, and detach job and result queue from LIN node
+*/
+void LIN_Master_Bridge::end(void)
+{
+  // stop schedule and detach queues
+  this->schedule.stop();
+  this->pLIN->attachJobQueue(NULL, 0);
+  this->pLIN->attachResultQueue(NULL, 0);
+
+} // LIN_Master_Bridge::end()
+
+
+
+/**
+  \brief      Send pending results to host
+  \details    Send pending results to host without waiting for flush time. Blocks until previous packet is written
+*/
+void LIN_Master_Bridge::flush(void)
+{
+  // no pending results
+  if (this->lenTx == 0)
+    return;
+
+  // wait until previous packet is written, then send current packet
+  while (this->lenSend != 0)
+    this->_sendPacket();
+  this->_finishPacket();
+  this->_sendPacket();
+
+} // LIN_Master_Bridge::flush()
+
+
+
+/**
+  \brief      Handle host link, schedule and LIN node in background
+  \details    Decode and execute host packets, handle schedule and LIN node, and encode finished frames. A packet is
+              sent if the transmit buffer is full or the oldest result is older than the flush time. If the host
+              link is too slow, results stay in the result queue until a buffer is free (and are lost on overflow)
+  \return     LIN state machine state
+*/
+LIN_Master::state_t LIN_Master_Bridge::handler(void)
+{
+  LIN_Master::state_t   state;
+  LIN_Master::result_t  result;
+  uint8_t               record[9 + 8];
+
+  // decode and execute host packets
+  while (this->pHost->available())
+    this->_receiveByte(this->pHost->read());
+
+  // handle schedule and LIN node
+  state = this->schedule.handler();
+
+  // report bridge errors and lost results
+  if (this->pLIN->getLostResults() > 0)
+    this->error |= LIN_Master_Bridge::ERROR_LOST;
+  if (this->error != LIN_Master_Bridge::NO_ERROR)
+  {
+    record[0] = LIN_BRIDGE_REC_STATUS;
+    record[1] = this->error;
+    record[2] = this->pLIN->getLostResults();
+    if (this->_encodeRecord(record, 3))
+    {
+      this->error = LIN_Master_Bridge::NO_ERROR;
+      this->pLIN->resetLostResults();
+    }
+  }
+
+  // encode finished frames while buffer space is available
+  while (this->pLIN->availableResults() > 0)
+  {
+    // buffer full -> send if possible, else keep results in queue
+    if (this->lenTx + sizeof(record) + 2 > LIN_BRIDGE_SIZE_TX)
+    {
+      if (this->lenSend != 0)
+        break;
+      this->_finishPacket();
+    }
+
+    // encode frame record
+    this->pLIN->readResult(result);
+    record[0] = LIN_BRIDGE_REC_FRAME;
+    record[1] = (uint8_t) result.type;
+    record[2] = result.id;
+    record[3] = (uint8_t) result.error;
+    record[4] = result.numData;
+    record[5] = (uint8_t) (result.timestamp);
+    record[6] = (uint8_t) (result.timestamp >> 8);
+    record[7] = (uint8_t) (result.timestamp >> 16);
+    record[8] = (uint8_t) (result.timestamp >> 24);
+    memcpy(record + 9, result.data, result.numData);
+    this->_encodeRecord(record, 9 + result.numData);
+  }
+
+  // flush time elapsed -> send packet
+  if ((this->lenTx > 0) && (this->lenSend == 0) && (micros() - this->timeTx >= this->timeFlush))
+    this->_finishPacket();
+
+  // write to host without blocking
+  this->_sendPacket();
+
+  // return LIN state
+  return state;
+
+} // LIN_Master_Bridge::handler()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,180 @@
+/**
+  \file     LIN_master_Bridge.h
+  \brief    LIN-to-host bridge with batched, COBS framed binary protocol
+  \details  This library turns a LIN master node into a LIN interface for host tools, e.g. via USB or Wi-Fi. The
+            host sends packets with batched commands (one-shot frames, schedule table, start/stop), and the bridge
+            returns packets with batched frame results incl. timestamps. Packets are COBS encoded and terminated by
+            0x00, i.e. the host can synchronize at any packet boundary. Results are encoded on the fly into one of
+            two transmit buffers, while the other is written to the host without blocking. Thus one USB packet
+            carries many LIN frames, and the host sees wire-rate traffic.
+            Packet payload (before COBS, multi-byte values little endian):
+              - host -> bridge: sequence of commands
+                - LIN_BRIDGE_CMD_FRAME: cmd, type | version<<4, ID, numData, data (master request only)
+                - LIN_BRIDGE_CMD_SCHEDULE: cmd, numSlots, per slot: type | version<<4, ID, numData, slot time [us] (4B),
+                  retries | policy<<7 (see LIN_Master_Schedule::retry_t), followed by data (master request) or by
+                  numEntries and the entries of the collision resolution table in slot format (event triggered,
+                  slave responses only). Schedule is stopped and the table replaced
+                - LIN_BRIDGE_CMD_START, LIN_BRIDGE_CMD_STOP: cmd
+              - bridge -> host: packet sequence number, followed by records
+                - LIN_BRIDGE_REC_FRAME: rec, type, ID, error, numData, timestamp [us] (4B), data
+                - LIN_BRIDGE_REC_STATUS: rec, error (see error_t), number of lost results
+            A host decoder is provided in extras/LIN_Bridge/linbridge.py.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \note     The bridge uses job and result queue of the LIN node, i.e. the LIN node must not be used otherwise
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_BRIDGE_H_
+#define _LIN_MASTER_BRIDGE_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <Arduino.h>
+#include "LIN_master.h"
+#include "LIN_master_Schedule.h"
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+#define LIN_BRIDGE_SIZE_RX      256         //!< max. size of decoded host packet [B]
+#define LIN_BRIDGE_SIZE_TX      256         //!< size of each of the two transmit buffers [B] (COBS encoded)
+#define LIN_BRIDGE_RESULTS      16          //!< size of result queue of LIN node
+#define LIN_BRIDGE_JOBS         8           //!< size of job queue of LIN node for one-shot frames
+#define LIN_BRIDGE_SLOTS        16          //!< max. number of schedule slots incl. entries of collision resolution tables
+#define LIN_BRIDGE_FLUSH        2000        //!< default max. delay [us] of a result until its packet is sent
+#define LIN_BRIDGE_CHUNK        64          //!< bytes per write to host if availableForWrite() is not supported, see LIN_BRIDGE_WRITE_CHUNKS
+//#define LIN_BRIDGE_WRITE_CHUNKS           //!< write fixed chunks instead of availableForWrite(), e.g. for WiFiClient (always on SAM)
+
+#define LIN_BRIDGE_CMD_FRAME    0x01        //!< host command: send one-shot frame
+#define LIN_BRIDGE_CMD_SCHEDULE 0x02        //!< host command: replace schedule table
+#define LIN_BRIDGE_CMD_START    0x03        //!< host command: start schedule
+#define LIN_BRIDGE_CMD_STOP     0x04        //!< host command: stop schedule
+#define LIN_BRIDGE_REC_FRAME    0x81        //!< bridge record: finished frame
+#define LIN_BRIDGE_REC_STATUS   0x82        //!< bridge record: bridge error
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  LIN-to-host bridge
+
+  \details LIN-to-host bridge. Executes batched host commands on a LIN master node and returns batched frame results.
+*/
+class LIN_Master_Bridge
+{
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// bridge error codes, reported to host via LIN_BRIDGE_REC_STATUS. Use bitmasks, as errors are collected until sent
+    typedef enum
+    {
+      NO_ERROR        = 0x00,                     //!< no error
+      ERROR_FRAMING   = 0x01,                     //!< invalid COBS packet or packet too long
+      ERROR_COMMAND   = 0x02,                     //!< unknown or truncated command (rest of packet is ignored), or infeasible schedule table
+      ERROR_FULL      = 0x04,                     //!< job queue full or too many schedule slots
+      ERROR_LOST      = 0x08                      //!< results lost because host link is too slow
+    } error_t;
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    LIN_Master            *pLIN;                  //!< pointer to LIN master node
+    Stream                *pHost;                 //!< pointer to host link, e.g. Serial
+    LIN_Master_Schedule   schedule;               //!< schedule table handler of LIN node
+    uint32_t              timeFlush;              //!< max. delay [us] of a result until its packet is sent
+    uint8_t               error;                  //!< errors not yet reported to host, see error_t
+
+    // queues and schedule table of LIN node
+    LIN_Master::result_t  queueResult[LIN_BRIDGE_RESULTS];    //!< result queue of LIN node
+    LIN_Master::job_t     queueJob[LIN_BRIDGE_JOBS];          //!< job queue of LIN node for one-shot frames
+    LIN_Master_Schedule::slot_t table[LIN_BRIDGE_SLOTS];      //!< schedule table set by host, followed by collision resolution tables
+    uint8_t               dataSlot[LIN_BRIDGE_SLOTS][8];      //!< master request data of schedule slots
+
+    // host -> bridge (COBS decoder)
+    uint8_t               bufRx[LIN_BRIDGE_SIZE_RX];  //!< decoded host packet
+    uint16_t              lenRx;                  //!< number of decoded bytes
+    uint8_t               codeRx;                 //!< current COBS code byte (0 = start of packet)
+    uint8_t               remainRx;               //!< remaining bytes of current COBS block
+    bool                  invalidRx;              //!< packet invalid, skip until next delimiter
+
+    // bridge -> host (COBS encoder, double buffered)
+    uint8_t               bufTx[2][LIN_BRIDGE_SIZE_TX];   //!< transmit buffers, one is filled while the other is sent
+    uint8_t               idxTx;                  //!< index of buffer being filled
+    uint16_t              lenTx;                  //!< length of buffer being filled (0 = empty)
+    uint16_t              posCode;                //!< position of current COBS code byte in buffer being filled
+    uint32_t              timeTx;                 //!< micros() when first record was added to buffer being filled
+    uint8_t               seqTx;                  //!< sequence number of next packet
+    uint16_t              lenSend;                //!< length of buffer being sent (0 = idle)
+    uint16_t              posSend;                //!< number of bytes already sent
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Decode a byte received from host
+    void _receiveByte(uint8_t Byte);
+
+    /// @brief Execute all commands of a decoded host packet
+    void _processPacket(void);
+
+    /// @brief Execute a host command. Returns command length, or 0 on error
+    uint16_t _command(const uint8_t Cmd[], uint16_t Len);
+
+    /// @brief Check a schedule slot of a host command. Returns slot length, or 0 if invalid or truncated
+    uint16_t _checkSlot(const uint8_t Slot[], uint16_t Len, bool Entry, uint16_t &NumEntries);
+
+    /// @brief Decode fixed part of a schedule slot of a host command
+    void _decodeSlot(LIN_Master_Schedule::slot_t *pSlot, const uint8_t Slot[]);
+
+    /// @brief Append a byte to the packet being filled (COBS encoded)
+    void _encodeByte(uint8_t Byte);
+
+    /// @brief Append a record to the packet being filled. Returns false if buffer is full
+    bool _encodeRecord(const uint8_t Record[], uint8_t Len);
+
+    /// @brief Terminate packet being filled and swap transmit buffers
+    void _finishPacket(void);
+
+    /// @brief Write buffer being sent to host without blocking
+    void _sendPacket(void);
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_Bridge(LIN_Master &Interface, Stream &Host);
+
+    /// @brief Start bridge. Attaches job and result queue to LIN node, which must already be opened
+    void begin(uint32_t FlushTime = LIN_BRIDGE_FLUSH);
+
+    /// @brief Stop bridge and schedule. Detaches job and result queue from LIN node
+    void end(void);
+
+    /// @brief Getter for schedule handler, e.g. for local schedule table
+    inline LIN_Master_Schedule &getSchedule(void) { return this->schedule; }
+
+    /// @brief Send pending results to host without waiting for flush time
+    void flush(void);
+
+    /// @brief Handle host link, schedule and LIN node in background (call as often as possible)
+    LIN_Master::state_t handler(void);
+
+}; // class LIN_Master_Bridge
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_BRIDGE_H_
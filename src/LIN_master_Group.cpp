@@ -0,0 +1,219 @@
+/**
+  \file     LIN_master_Group.cpp
+  \brief    Multi-bus manager for LIN master emulation
+  \details  This library services several LIN master nodes (optionally with schedule tables) from a single handler() call.
+            Only buses with pending work are serviced, as indicated by a readiness bitmask. Schedules of all buses
+            can be started with a time offset, so that several buses can run at full bus load.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "LIN_master_Group.h"
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor for LIN group
+  \details    Constructor for empty LIN group. Add buses via add()
+*/
+LIN_Master_Group::LIN_Master_Group(void)
+{
+  // initialize group properties
+  for (uint8_t i=0; i<LIN_GROUP_MAX; i++)
+  {
+    this->bus[i]      = NULL;
+    this->schedule[i] = NULL;
+  }
+  this->numBus    = 0;
+  this->maskReady = 0x00;
+  this->callback  = NULL;
+
+} // LIN_Master_Group::LIN_Master_Group()
+
+
+
+/**
+  \brief      Add LIN master node to group
+  \details    Add LIN master node and optional schedule to group. If a schedule is given, the bus is serviced via
+              LIN_Master_Schedule::handler() and finished frames are reported via the schedule callback.
+  \param[in]  LIN         LIN master node
+  \param[in]  Schedule    optional schedule for this node (NULL = none)
+  \return     index of bus in group, or -1 if group is full
+*/
+int8_t LIN_Master_Group::add(LIN_Master &LIN, LIN_Master_Schedule *Schedule)
+{
+  // group is full
+  if (this->numBus >= LIN_GROUP_MAX)
+    return -1;
+
+  // store bus
+  this->bus[this->numBus]      = &LIN;
+  this->schedule[this->numBus] = Schedule;
+
+  // return index of new bus
+  return (int8_t) (this->numBus++);
+
+} // LIN_Master_Group::add()
+
+
+
+/**
+  \brief      Start sending a LIN master request frame on a bus in background
+  \details    Start sending a LIN master request frame on a bus in background and mark bus as ready.
+  \param[in]  Bus         index of bus in group
+  \param[in]  Version     frame version (LIN_V1 or LIN_V2)
+  \param[in]  Id          frame ID (protected or unprotected)
+  \param[in]  NumData     number of data bytes (0..8)
+  \param[in]  Data        data bytes
+  \param[in]  Callback    optional function called when this frame is finished (NULL = none)
+  \return     current state of LIN state machine
+*/
+LIN_Master::state_t LIN_Master_Group::sendMasterRequest(uint8_t Bus, LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, uint8_t Data[], LIN_Master::callbackFrame_t Callback)
+{
+  // invalid bus
+  if (Bus >= this->numBus)
+    return LIN_Master::STATE_OFF;
+
+  // start frame and mark bus as ready
+  this->setReady(Bus);
+  return this->bus[Bus]->sendMasterRequest(Version, Id, NumData, Data, Callback);
+
+} // LIN_Master_Group::sendMasterRequest()
+
+
+
+/**
+  \brief      Start receiving a LIN slave response frame on a bus in background
+  \details    Start receiving a LIN slave response frame on a bus in background and mark bus as ready.
+  \param[in]  Bus         index of bus in group
+  \param[in]  Version     frame version (LIN_V1 or LIN_V2)
+  \param[in]  Id          frame ID (protected or unprotected)
+  \param[in]  NumData     number of data bytes (0..8)
+  \param[in]  Callback    optional function called when this frame is finished (NULL = none)
+  \return     current state of LIN state machine
+*/
+LIN_Master::state_t LIN_Master_Group::receiveSlaveResponse(uint8_t Bus, LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, LIN_Master::callbackFrame_t Callback)
+{
+  // invalid bus
+  if (Bus >= this->numBus)
+    return LIN_Master::STATE_OFF;
+
+  // start frame and mark bus as ready
+  this->setReady(Bus);
+  return this->bus[Bus]->receiveSlaveResponse(Version, Id, NumData, Callback);
+
+} // LIN_Master_Group::receiveSlaveResponse()
+
+
+
+/**
+  \brief      Start schedules of all buses with staggered start times
+  \details    Start schedules of all buses. Schedule of bus n starts n*Stagger after the first one, so that BREAKs
+              and frame ends of different buses are not handled in the same handler() call.
+  \param[in]  Stagger     time offset [us] between schedules of consecutive buses
+*/
+void LIN_Master_Group::startSchedules(uint32_t Stagger)
+{
+  uint32_t  delayStart = 0;
+
+  // start all schedules with offset
+  for (uint8_t i=0; i<this->numBus; i++)
+  {
+    if (this->schedule[i] != NULL)
+    {
+      this->schedule[i]->start(delayStart);
+      if (this->schedule[i]->isRunning())
+        this->setReady(i);
+      delayStart += Stagger;
+    }
+  }
+
+} // LIN_Master_Group::startSchedules()
+
+
+
+/**
+  \brief      Stop schedules of all buses after current frame
+  \details    Stop schedules of all buses. Ongoing frames are still finished by handler()
+*/
+void LIN_Master_Group::stopSchedules(void)
+{
+  // stop all schedules
+  for (uint8_t i=0; i<this->numBus; i++)
+  {
+    if (this->schedule[i] != NULL)
+      this->schedule[i]->stop();
+  }
+
+} // LIN_Master_Group::stopSchedules()
+
+
+
+/**
+  \brief      Handle all buses with pending work
+  \details    Handle all buses marked in readiness bitmask. Idle buses are not called. On buses without schedule,
+              the group callback is called for finished frames and state machine and error are reset afterwards.
+              A bus is removed from the readiness mask when it is idle and its schedule (if any) is stopped.
+  \return     readiness bitmask after handling
+*/
+uint8_t LIN_Master_Group::handler(void)
+{
+  LIN_Master::state_t   state;
+  LIN_Master            *pLIN;
+  uint8_t               mask = this->maskReady;
+  uint8_t               bit  = 0x01;
+
+  // service only buses with pending work
+  for (uint8_t i=0; mask != 0; i++, bit <<= 1)
+  {
+    // bus not ready -> skip
+    if (!(mask & bit))
+      continue;
+    mask &= ~bit;
+    pLIN = this->bus[i];
+
+    // bus with schedule -> schedule handles frames and callbacks
+    if (this->schedule[i] != NULL)
+    {
+      state = this->schedule[i]->handler();
+      if (this->schedule[i]->isRunning())
+        continue;
+    }
+
+    // bus without schedule -> handle LIN node directly
+    else
+    {
+      state = pLIN->handler();
+
+      // frame finished -> notify user and release LIN node
+      if (state == LIN_Master::STATE_DONE)
+      {
+        if (this->callback != NULL)
+          this->callback(*pLIN, i);
+        if (pLIN->getState() == LIN_Master::STATE_DONE)
+        {
+          pLIN->resetStateMachine();
+          pLIN->resetError();
+        }
+        state = pLIN->getState();
+      }
+    }
+
+    // bus idle -> no pending work
+    if ((state == LIN_Master::STATE_IDLE) || (state == LIN_Master::STATE_OFF))
+      this->maskReady &= ~bit;
+
+  } // loop over ready buses
+
+  // return readiness mask
+  return this->maskReady;
+
+} // LIN_Master_Group::handler()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,107 @@
+/**
+  \file     LIN_master_Group.h
+  \brief    Multi-bus manager for LIN master emulation
+  \details  This library services several LIN master nodes (optionally with schedule tables) from a single handler() call.
+            Only buses with pending work are serviced, as indicated by a readiness bitmask. Schedules of all buses
+            can be started with a time offset, so that several buses can run at full bus load.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_GROUP_H_
+#define _LIN_MASTER_GROUP_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <Arduino.h>
+#include "LIN_master.h"
+#include "LIN_master_Schedule.h"
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+#define LIN_GROUP_MAX      8            //!< max. number of buses in a group (bits in readiness mask)
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  Group of LIN master nodes
+
+  \details Group of LIN master nodes. Services all buses with pending work from one handler() call.
+*/
+class LIN_Master_Group
+{
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// callback for finished frame on a bus without schedule. Called before state machine and error are reset
+    typedef void (*callback_t)(LIN_Master &LIN, uint8_t Bus);
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    LIN_Master            *bus[LIN_GROUP_MAX];    //!< LIN master nodes
+    LIN_Master_Schedule   *schedule[LIN_GROUP_MAX]; //!< optional schedule per bus (NULL = none)
+    uint8_t               numBus;                 //!< number of buses in group
+    uint8_t               maskReady;              //!< readiness bitmask: bus has ongoing frame or running schedule
+    callback_t            callback;               //!< user function called when a frame is finished
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_Group(void);
+
+    /// @brief Add LIN master node (and optional schedule) to group
+    int8_t add(LIN_Master &LIN, LIN_Master_Schedule *Schedule = NULL);
+
+    /// @brief Getter for number of buses in group
+    inline uint8_t getNumBus(void) { return this->numBus; }
+
+    /// @brief Getter for LIN master node of bus
+    inline LIN_Master &getBus(uint8_t Bus) { return *(this->bus[Bus]); }
+
+    /// @brief Attach callback for finished frames on buses without schedule
+    inline void attachCallback(callback_t Callback) { this->callback = Callback; }
+
+    /// @brief Mark bus as ready, e.g. after starting a frame directly via LIN master node. Invalid bus is ignored
+    inline void setReady(uint8_t Bus) { if (Bus < this->numBus) this->maskReady |= (uint8_t) (1 << Bus); }
+
+    /// @brief Getter for readiness bitmask
+    inline uint8_t getReady(void) { return this->maskReady; }
+
+    /// @brief Start sending a LIN master request frame on a bus in background
+    LIN_Master::state_t sendMasterRequest(uint8_t Bus, LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, uint8_t Data[], LIN_Master::callbackFrame_t Callback = NULL);
+
+    /// @brief Start receiving a LIN slave response frame on a bus in background
+    LIN_Master::state_t receiveSlaveResponse(uint8_t Bus, LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, LIN_Master::callbackFrame_t Callback = NULL);
+
+    /// @brief Start schedules of all buses with staggered start times
+    void startSchedules(uint32_t Stagger);
+
+    /// @brief Stop schedules of all buses after current frame
+    void stopSchedules(void);
+
+    /// @brief Handle all buses with pending work (call as often as possible)
+    uint8_t handler(void);
+
+}; // class LIN_Master_Group
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_GROUP_H_
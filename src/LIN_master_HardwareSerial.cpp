@@ -11,9 +11,87 @@
 #include "LIN_master_HardwareSerial.h"
 
 
+// AVR: Tx enable bit in UART control register B (name depends on device)
+#if defined(ARDUINO_ARCH_AVR)
+  #if defined(TXEN0)
+    #define LIN_BIT_TXEN    TXEN0
+  #elif defined(TXEN)
+    #define LIN_BIT_TXEN    TXEN
+  #endif
+#endif
+
+
+/**
+  \brief      Drive Tx pin low or release it to UART
+  \details    Drive Tx pin low or release it to UART for BREAK_PIN. On AVR the UART transmitter is disabled, i.e. the
+              pin is controlled by PORT (pre-set to output low). On SAM the pin is switched from peripheral to PIO control.
+  \param[in]  Low       true=drive Tx pin low, false=release to UART
+*/
+void LIN_Master_HardwareSerial::_setBreakPin(bool Low)
+{
+  // AVR: disable/enable UART transmitter. Avoid conflict with Tx interrupt of Arduino core
+  #if defined(ARDUINO_ARCH_AVR) && defined(LIN_BIT_TXEN)
+    noInterrupts();
+    if (Low)
+      *(this->regUCSRB) &= ~(1 << LIN_BIT_TXEN);
+    else
+      *(this->regUCSRB) |= (1 << LIN_BIT_TXEN);
+    interrupts();
+
+  // SAM: switch pin to PIO output low, or back to peripheral
+  #elif defined(ARDUINO_ARCH_SAM)
+    Pio       *pPort = g_APinDescription[this->pinBreak].pPort;
+    uint32_t  mask   = g_APinDescription[this->pinBreak].ulPin;
+    if (Low)
+    {
+      pPort->PIO_CODR = mask;
+      pPort->PIO_OER  = mask;
+      pPort->PIO_PER  = mask;
+    }
+    else
+      pPort->PIO_PDR  = mask;
+
+  #endif
+
+  // store pin status
+  this->breakLow = Low;
+
+} // LIN_Master_HardwareSerial::_setBreakPin()
+
+
+
+/**
+  \brief      Pre-set Tx pin for BREAK_PIN, or restore it
+  \details    On AVR, pre-set Tx pin to output low for BREAK_PIN. This is overridden by the UART while its transmitter
+              is enabled, i.e. must only be done while the UART is open. Else the pin is restored to input with pull-up,
+              i.e. recessive level, before the UART is closed or BREAK_PIN is left. Else the pin would drive the bus
+              dominant after the UART is closed. On SAM the pin is only switched to PIO during the BREAK, i.e. no pre-set
+  \param[in]  Preset    true=pre-set pin to output low, false=restore to input with pull-up
+*/
+void LIN_Master_HardwareSerial::_presetBreakPin(bool Preset)
+{
+  #if defined(ARDUINO_ARCH_AVR) && defined(LIN_BIT_TXEN)
+    if (Preset)
+    {
+      digitalWrite(this->pinBreak, LOW);
+      pinMode(this->pinBreak, OUTPUT);
+    }
+    else
+      pinMode(this->pinBreak, INPUT_PULLUP);
+  #else
+    (void) Preset;
+  #endif
+
+} // LIN_Master_HardwareSerial::_presetBreakPin()
+
+
+
+
 /**
   \brief      Send LIN break
-  \details    Send LIN break (=16bit low)
+  \details    Send LIN break (=16bit low). With BREAK_PIN, BREAK (13 bit low) and BREAK delimiter (1 bit high) are timed
+              by a bounded busy wait, i.e. this call blocks for 14 bit (730us at 19.2kBaud), and the rest of the header
+              is sent directly. Thus the header is not stretched by the latency of handler() calls, e.g. from a ticker
   \return     current state of LIN state machine
 */
 LIN_Master::state_t LIN_Master_HardwareSerial::_sendBreak(void)
@@ -36,12 +114,43 @@ LIN_Master::state_t LIN_Master_HardwareSerial::_sendBreak(void)
   while (this->pSerial->available())
     this->pSerial->read();
 
-  // set half baudrate for BREAK
-  this->pSerial->begin(this->baudrate >> 1);
-  while(!(*(this->pSerial)));
+  // send BREAK via Tx pin override (13 bit low) and BREAK delimiter (1 bit high), then send rest of frame
+  if (this->breakMode == LIN_Master_HardwareSerial::BREAK_PIN)
+  {
+    uint32_t    timeStart;
+    uint32_t    timeBreak     = (13UL * this->timePerByte) / 10;     // 13 bit in 32bit, as ticks_t may be 16bit
+    uint32_t    timeDelimiter = (uint32_t) this->timePerByte / 10;   // 1 bit
+
+    // BREAK
+    this->_setBreakPin(true);
+    timeStart = LIN_Master_Timebase::getTicks();
+    while ((uint32_t) (LIN_Master_Timebase::getTicks() - timeStart) < timeBreak);
+
+    // BREAK delimiter
+    this->_setBreakPin(false);
+    timeStart = LIN_Master_Timebase::getTicks();
+    while ((uint32_t) (LIN_Master_Timebase::getTicks() - timeStart) < timeDelimiter);
+
+    // discard BREAK echo (0x00 with framing error). Echo of BREAK is not checked
+    while (this->pSerial->available())
+      this->pSerial->read();
+    this->bufRx[0] = this->bufTx[0];
+    this->numRx    = 1;
 
-  // send BREAK (>=13 bit low)
-  this->pSerial->write(bufTx[0]);
+    // send rest of frame (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+    this->pSerial->write(this->bufTx+1, this->lenTx-1);
+  }
+
+  // send BREAK via half baudrate
+  else
+  {
+    // set half baudrate for BREAK
+    this->pSerial->begin(this->baudrate >> 1);
+    while(!(*(this->pSerial)));
+
+    // send BREAK (>=13 bit low)
+    this->pSerial->write(bufTx[0]);
+  }
 
   // progress state
   this->state = LIN_Master::STATE_BREAK;
@@ -73,11 +182,16 @@ LIN_Master::state_t LIN_Master_HardwareSerial::_sendFrame(void)
     return this->state;
   }
 
-  // byte(s) received (likely BREAK echo)
-  if (this->pSerial->available())
+  // BREAK via Tx pin override -> header already sent in _sendBreak()
+  if (this->breakMode == LIN_Master_HardwareSerial::BREAK_PIN)
+    this->state = LIN_Master::STATE_BODY;
+
+  // BREAK via baudrate and byte(s) received (likely BREAK echo)
+  else if (this->pSerial->available())
   {
     // store echo in Rx
     this->bufRx[0] = this->pSerial->read();
+    this->numRx    = 1;
 
     // restore nominal baudrate
     this->pSerial->begin(this->baudrate);
@@ -91,17 +205,12 @@ LIN_Master::state_t LIN_Master_HardwareSerial::_sendFrame(void)
 
   } // BREAK echo received
   
-  // no byte(s) received
-  else
+  // BREAK not yet finished -> check for timeout
+  if ((this->state == LIN_Master::STATE_BREAK) && (this->_checkTimeout()))
   {
-    // check for timeout
-    if (micros() - this->timeStart > this->timeMax)
-    {
-      this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_TIMEOUT);
-      this->state = LIN_Master::STATE_DONE;
-    }
-
-  } // no byte(s) received
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_TIMEOUT);
+    this->state = LIN_Master::STATE_DONE;
+  }
   
   // return state
   return this->state;
@@ -130,12 +239,16 @@ LIN_Master::state_t LIN_Master_HardwareSerial::_receiveFrame(void)
     return this->state;
   }
 
-  // frame body received (-1 because BREAK is handled already handled in _sendFrame())
-  if (this->pSerial->available() >= this->lenRx-1)
+  // store received bytes and check echo byte-wise (BREAK is already handled in _sendFrame()). Abort on first mismatch
+  while ((this->numRx < this->lenRx) && (this->pSerial->available()))
   {
-    // store bytes in Rx
-    this->pSerial->readBytes(this->bufRx+1, this->lenRx-1);
+    if (!this->_storeByte(this->pSerial->read()))
+      return this->state;
+  }
 
+  // frame body received
+  if (this->numRx >= this->lenRx)
+  {
     // check frame for errors
     this->error = (LIN_Master::error_t) ((int) this->error | (int) this->_checkFrame());
 
@@ -148,7 +261,7 @@ LIN_Master::state_t LIN_Master_HardwareSerial::_receiveFrame(void)
   else
   {
     // check for timeout
-    if (micros() - this->timeStart > this->timeMax)
+    if (this->_checkTimeout())
     {
       this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_TIMEOUT);
       this->state = LIN_Master::STATE_DONE;
@@ -162,6 +275,72 @@ LIN_Master::state_t LIN_Master_HardwareSerial::_receiveFrame(void)
 } // LIN_Master_HardwareSerial::_receiveFrame()
 
 
+
+/**
+  \brief      Send wake-up pulse
+  \details    Send wake-up pulse (250us..5ms low) for waking up slaves from sleep mode
+*/
+void LIN_Master_HardwareSerial::_sendWakeup(void)
+{
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master_HardwareSerial::_sendWakeup()");
+  #endif
+
+  // send 0x00 at nominal baudrate, i.e. 9 bit low (469us at 19.2kBaud). Echo is discarded by next _sendBreak()
+  this->pSerial->write((uint8_t) 0x00);
+
+} // LIN_Master_HardwareSerial::_sendWakeup()
+
+
+
+/**
+  \brief      Check for wake-up pulse from a slave
+  \details    Check for wake-up pulse from a slave while in sleep mode. The pulse is received as byte (typically 0x00
+              or 0x80 with framing error), i.e. any received byte indicates a wake-up
+  \return     true if a wake-up pulse was received
+*/
+bool LIN_Master_HardwareSerial::_receiveWakeup(void)
+{
+  // no byte received -> no wake-up
+  if (!this->pSerial->available())
+    return false;
+
+  // discard received bytes
+  while (this->pSerial->available())
+    this->pSerial->read();
+
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 1)
+    LIN_DEBUG_SERIAL.println("LIN_Master_HardwareSerial::_receiveWakeup(): wake-up received");
+  #endif
+
+  // wake-up pulse detected
+  return true;
+
+} // LIN_Master_HardwareSerial::_receiveWakeup()
+
+
+
+/**
+  \brief      Apply changed baudrate to UART
+  \details    Apply changed baudrate to UART. With BREAK_BAUDRATE, the nominal baudrate is restored after each BREAK
+              anyway, i.e. only BREAK_PIN requires a re-init of the UART
+*/
+void LIN_Master_HardwareSerial::_setBaudrate(void)
+{
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master_HardwareSerial::_setBaudrate()");
+  #endif
+
+  // UART stays at nominal baudrate -> set new baudrate
+  if (this->breakMode == LIN_Master_HardwareSerial::BREAK_PIN)
+    this->pSerial->begin(this->baudrate);
+
+} // LIN_Master_HardwareSerial::_setBaudrate()
+
+
 /**
   \brief      Constructor for LIN node class using HardwareSerial
   \details    Constructor for LIN node class for using HardwareSerial. Store pointer to used serial interface.
@@ -172,6 +351,14 @@ LIN_Master_HardwareSerial::LIN_Master_HardwareSerial(HardwareSerial &Interface,
 {
   // store pointer to used HW serial
   this->pSerial    = &Interface;
+
+  // BREAK via baudrate by default
+  this->breakMode  = LIN_Master_HardwareSerial::BREAK_BAUDRATE;
+  this->pinBreak   = 0;
+  this->breakLow   = false;
+  #if defined(ARDUINO_ARCH_AVR)
+    this->regUCSRB = NULL;
+  #endif
   
   // must not open connection here, else (at least) ESP32 and ESP8266 fail
 
@@ -193,6 +380,10 @@ void LIN_Master_HardwareSerial::begin(uint16_t Baudrate)
   this->pSerial->begin(this->baudrate);
   while(!(*(this->pSerial)));
 
+  // pre-set Tx pin for BREAK_PIN. UART transmitter controls the pin meanwhile
+  if (this->breakMode == LIN_Master_HardwareSerial::BREAK_PIN)
+    this->_presetBreakPin(true);
+
 } // LIN_Master_HardwareSerial::begin()
 
 
@@ -205,12 +396,96 @@ void LIN_Master_HardwareSerial::end()
 {
   // call base class method
   LIN_Master::end();
+
+  // release Tx pin, if required, and restore it to recessive level before UART releases it
+  if (this->breakLow)
+    this->_setBreakPin(false);
+  if (this->breakMode == LIN_Master_HardwareSerial::BREAK_PIN)
+    this->_presetBreakPin(false);
     
   // close serial interface
   this->pSerial->end();
 
 } // LIN_Master_HardwareSerial::end()
 
+
+
+/**
+  \brief      Set method for BREAK generation
+  \details    Set method for BREAK generation. BREAK_BAUDRATE sends 0x00 at half baudrate and is supported on all boards.
+              BREAK_PIN drives the Tx pin low for 13 bit via a pin override, which avoids re-initializing the UART
+              for each frame. The BREAK is timed by a busy wait in the handler() call starting the frame (14 bit incl.
+              BREAK delimiter, i.e. 730us at 19.2kBaud). It is supported on AVR (Serial..Serial3) and SAM. If a mode is not supported, the
+              current mode is kept. Must not be called during a frame. On AVR the Tx pin is pre-set to output low
+              only while the UART is open, and restored to input with pull-up by end() or when leaving BREAK_PIN.
+  \param[in]  Mode      method for BREAK generation
+  \param[in]  PinTx     Tx pin of serial interface (only for BREAK_PIN)
+  \return     mode is supported and was set
+*/
+bool LIN_Master_HardwareSerial::setBreakMode(LIN_Master_HardwareSerial::breakMode_t Mode, uint8_t PinTx)
+{
+  // BREAK via baudrate is always supported
+  if (Mode == LIN_Master_HardwareSerial::BREAK_BAUDRATE)
+  {
+    if (this->breakLow)
+      this->_setBreakPin(false);
+    if (this->breakMode == LIN_Master_HardwareSerial::BREAK_PIN)
+      this->_presetBreakPin(false);
+    this->breakMode = Mode;
+    return true;
+  }
+
+  // AVR: get UART control register of serial interface
+  #if defined(ARDUINO_ARCH_AVR) && defined(LIN_BIT_TXEN)
+    this->regUCSRB = NULL;
+    #if defined(HAVE_HWSERIAL0) && defined(UCSR0B)
+      if (this->pSerial == &Serial)
+        this->regUCSRB = &UCSR0B;
+    #elif defined(HAVE_HWSERIAL0) && defined(UCSRB)
+      if (this->pSerial == &Serial)
+        this->regUCSRB = &UCSRB;
+    #endif
+    #if defined(HAVE_HWSERIAL1)
+      if (this->pSerial == &Serial1)
+        this->regUCSRB = &UCSR1B;
+    #endif
+    #if defined(HAVE_HWSERIAL2)
+      if (this->pSerial == &Serial2)
+        this->regUCSRB = &UCSR2B;
+    #endif
+    #if defined(HAVE_HWSERIAL3)
+      if (this->pSerial == &Serial3)
+        this->regUCSRB = &UCSR3B;
+    #endif
+    if (this->regUCSRB == NULL)
+      return false;
+
+  // SAM: check pin number
+  #elif defined(ARDUINO_ARCH_SAM)
+    if (PinTx >= PINS_COUNT)
+      return false;
+
+  // other boards: not supported
+  #else
+    (void) PinTx;
+    return false;
+  #endif
+
+  // restore previous Tx pin, if changed
+  if ((this->breakMode == LIN_Master_HardwareSerial::BREAK_PIN) && (this->pinBreak != PinTx))
+    this->_presetBreakPin(false);
+
+  // store BREAK mode
+  this->pinBreak  = PinTx;
+  this->breakMode = Mode;
+
+  // pre-set Tx pin only while UART is open, else in begin()
+  if (this->state != LIN_Master::STATE_OFF)
+    this->_presetBreakPin(true);
+  return true;
+
+} // LIN_Master_HardwareSerial::setBreakMode()
+
 /*-----------------------------------------------------------------------------
     END OF FILE
 -----------------------------------------------------------------------------*/
\ No newline at end of file
@@ -32,15 +32,38 @@
 */
 class LIN_Master_HardwareSerial : public LIN_Master
 {
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// method for BREAK generation
+    typedef enum
+    {
+      BREAK_BAUDRATE      = 0,                //!< send 0x00 at half baudrate (default, all boards)
+      BREAK_PIN           = 1                 //!< low pulse via Tx pin override, timed by busy wait (AVR and SAM only)
+    } breakMode_t;
+
+
   // PROTECTED VARIABLES
   protected:
 
     HardwareSerial        *pSerial;           //!< pointer to used HW serial
+    breakMode_t           breakMode;          //!< method for BREAK generation
+    uint8_t               pinBreak;           //!< Tx pin for BREAK_PIN
+    bool                  breakLow;           //!< BREAK_PIN: Tx pin is currently driven low
+    #if defined(ARDUINO_ARCH_AVR)
+      volatile uint8_t    *regUCSRB;          //!< AVR: UART control register B, for Tx enable
+    #endif
 
 
   // PROTECTED METHODS
   protected:
   
+    /// @brief Drive Tx pin low or release it to UART (BREAK_PIN only)
+    void _setBreakPin(bool Low);
+
+    /// @brief Pre-set Tx pin for BREAK_PIN while UART is enabled, or restore it to recessive level
+    void _presetBreakPin(bool Preset);
+
     /// @brief Send LIN break
     LIN_Master::state_t _sendBreak(void);
 
@@ -50,6 +73,15 @@ class LIN_Master_HardwareSerial : public LIN_Master
     /// @brief Read and check LIN frame
     LIN_Master::state_t _receiveFrame(void);
 
+    /// @brief Send wake-up pulse
+    void _sendWakeup(void);
+
+    /// @brief Check for wake-up pulse from a slave
+    bool _receiveWakeup(void);
+
+    /// @brief Apply changed baudrate to UART (BREAK_PIN only)
+    void _setBaudrate(void);
+
 
   // PUBLIC METHODS
   public:
@@ -63,6 +95,12 @@ class LIN_Master_HardwareSerial : public LIN_Master
     /// @brief Close serial interface
     void end(void);
 
+    /// @brief Set method for BREAK generation
+    bool setBreakMode(breakMode_t Mode, uint8_t PinTx = 0);
+
+    /// @brief Getter for method for BREAK generation
+    inline breakMode_t getBreakMode(void) { return this->breakMode; }
+
 }; // class LIN_Master_HardwareSerial
 
 
@@ -47,7 +47,7 @@ LIN_Master::state_t LIN_Master_HardwareSerial_ESP32::_sendBreak(void)
   this->pSerial->write(bufTx[0]);
 
   // store starting time
-  timeStartBreak = micros();
+  timeStartBreak = LIN_Master_Timebase::getTicks();
 
   // progress state
   this->state = LIN_Master::STATE_BREAK;
@@ -80,7 +80,7 @@ LIN_Master::state_t LIN_Master_HardwareSerial_ESP32::_sendFrame(void)
   }
 
   // Serial.available() has >1ms delay -> use duration of BREAK instead
-  if ((micros() - timeStartBreak) > (timePerByte << 1))
+  if ((LIN_Master_Timebase::getTicks() - timeStartBreak) > ((uint32_t) this->timePerByte << 1))
   {
     // skip reading Rx now (is not yet in buffer)
 
@@ -99,7 +99,7 @@ LIN_Master::state_t LIN_Master_HardwareSerial_ESP32::_sendFrame(void)
   else
   {
     // check for timeout
-    if (micros() - this->timeStart > this->timeMax)
+    if (this->_checkTimeout())
     {
       this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_TIMEOUT);
       this->state = LIN_Master::STATE_DONE;
@@ -134,12 +134,17 @@ LIN_Master::state_t LIN_Master_HardwareSerial_ESP32::_receiveFrame(void)
     return this->state;
   }
 
-  // frame body received. Here, need to read BREAK as well due to delay of Serial.available()
-  if (this->pSerial->available() >= this->lenRx)
+  // store received bytes and check echo byte-wise. Here, need to read BREAK as well due to delay of Serial.available().
+  // Abort on first mismatch
+  while ((this->numRx < this->lenRx) && (this->pSerial->available()))
   {
-    // store bytes in Rx
-    this->pSerial->readBytes(this->bufRx, this->lenRx);
+    if (!this->_storeByte(this->pSerial->read()))
+      return this->state;
+  }
 
+  // frame body received
+  if (this->numRx >= this->lenRx)
+  {
     // check frame for errors
     this->error = (LIN_Master::error_t) ((int) this->error | (int) this->_checkFrame());
 
@@ -152,7 +157,7 @@ LIN_Master::state_t LIN_Master_HardwareSerial_ESP32::_receiveFrame(void)
   else
   {
     // check for timeout
-    if (micros() - this->timeStart > this->timeMax)
+    if (this->_checkTimeout())
     {
       this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_TIMEOUT);
       this->state = LIN_Master::STATE_DONE;
@@ -183,6 +188,8 @@ LIN_Master_HardwareSerial_ESP32::LIN_Master_HardwareSerial_ESP32(HardwareSerial
   this->pinTx      = PinTx;                                   // transmit pin
   this->pinLedRx   = pinLedRx;
   this->pinLedTx   = pinLedTx;
+  this->flagEvent  = false;                                  // no UART receive event yet
+  this->taskEvent  = NULL;                                   // no task to notify
   // must not open connection here, else system resets
 
 } // LIN_Master_HardwareSerial_ESP32::LIN_Master_HardwareSerial_ESP32()
@@ -206,6 +213,49 @@ void LIN_Master_HardwareSerial_ESP32::begin(uint16_t Baudrate)
 
 } // LIN_Master_HardwareSerial_ESP32::begin()
 
+
+
+/**
+  \brief      Notify application task on UART receive event
+  \details    Notify application task on UART receive event, i.e. when reception pauses after BREAK echo and after frame.
+              The UART event task only sets a flag (see getEvent()) and optionally notifies the specified task via
+              xTaskNotifyGive(). The state machine is owned by the application task, i.e. handler() must only be called
+              from there, e.g. via ulTaskNotifyTake() with a timeout of few ms, or via polling getEvent(). The timeout
+              is required to detect frame timeouts, because a missing slave response causes no receive event.
+              Requires ESP32 core >=2.0. Call after begin().
+  \param[in]  Task    task to notify on receive event, e.g. xTaskGetCurrentTaskHandle(). NULL: only set flag
+  \return     true if events are supported by ESP32 core, else false
+*/
+bool LIN_Master_HardwareSerial_ESP32::enableEvents(TaskHandle_t Task)
+{
+  #if defined(ESP_ARDUINO_VERSION_MAJOR) && (ESP_ARDUINO_VERSION_MAJOR >= 2)
+
+    // store task to notify
+    this->taskEvent = Task;
+    this->flagEvent = false;
+
+    // on reception pause (onlyOnTimeout=true) only flag event and notify task. Don't call handler() from UART event task,
+    // as it would run the state machine in parallel to the application task (dual-core)
+    this->pSerial->onReceive([this]() {
+      this->flagEvent = true;
+      if (this->taskEvent != NULL)
+        xTaskNotifyGive(this->taskEvent);
+    }, true);
+
+    return true;
+
+  #else
+
+    // no receive event in ESP32 core <2.0
+    (void) Task;
+    return false;
+
+  #endif
+
+} // LIN_Master_HardwareSerial_ESP32::enableEvents()
+
+
+
 void LIN_Master_HardwareSerial_ESP32::ledTx(uint8_t value){
   digitalWrite(this->pinLedTx, value);
 }
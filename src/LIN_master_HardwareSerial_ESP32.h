@@ -43,7 +43,9 @@ class LIN_Master_HardwareSerial_ESP32 : public LIN_Master_HardwareSerial
     uint8_t               pinTx;              //!< pin used for transmit
     uint8_t               pinLedRx;
     uint8_t               pinLedTx;
-    uint32_t              timeStartBreak;     //!< micros() when BREAK was sent
+    uint32_t              timeStartBreak;     //!< time [ticks] when BREAK was sent
+    volatile bool         flagEvent;          //!< UART receive event occurred, set by UART event task
+    TaskHandle_t          taskEvent;          //!< task to notify on UART receive event, or NULL
 
 
   // PROTECTED METHODS
@@ -67,6 +69,13 @@ class LIN_Master_HardwareSerial_ESP32 : public LIN_Master_HardwareSerial
      
     /// @brief Open serial interface
     void begin(uint16_t Baudrate);
+
+    /// @brief Notify application task on UART receive event (requires ESP32 core >=2.0)
+    bool enableEvents(TaskHandle_t Task = NULL);
+
+    /// @brief Check and clear UART receive event. If true, call handler()
+    inline bool getEvent(void) { if (!this->flagEvent) return false; this->flagEvent = false; return true; }
+
     void ledTx(uint8_t value);
     void ledRx(uint8_t value);
 
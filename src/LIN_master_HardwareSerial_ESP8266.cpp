@@ -82,6 +82,7 @@ LIN_Master::state_t LIN_Master_HardwareSerial_ESP8266::_sendFrame(void)
   {
     // store echo in Rx
     this->bufRx[0] = this->pSerial->read();
+    this->numRx    = 1;
 
     // restore nominal baudrate
     this->pSerial->updateBaudRate(this->baudrate);
@@ -98,7 +99,7 @@ LIN_Master::state_t LIN_Master_HardwareSerial_ESP8266::_sendFrame(void)
   else
   {
     // check for timeout
-    if (micros() - this->timeStart > this->timeMax)
+    if (this->_checkTimeout())
     {
       this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_TIMEOUT);
       this->state = LIN_Master::STATE_DONE;
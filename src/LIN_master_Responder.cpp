@@ -0,0 +1,341 @@
+/**
+  \file     LIN_master_Responder.cpp
+  \brief    LIN slave node emulation (responder) via a HardwareSerial interface
+  \details  This library emulates any number of LIN slave nodes on one HardwareSerial interface, e.g. for testing
+            master code in a hardware-in-the-loop rig. It detects BREAK+SYNC, checks the received PID and looks up the
+            frame in a table indexed by frame ID. Slave responses are published directly from the handler() call which
+            received the PID, master requests are received and stored in the same table.
+            PID and checksum are calculated via the LIN_Master frame engine, see LIN_master.h.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "LIN_master_Responder.h"
+
+
+/**************************
+ * PROTECTED METHODS
+**************************/
+
+/**
+  \brief      Handle a received byte
+  \details    Handle a received byte according to responder state
+  \param[in]  Byte      received byte
+*/
+void LIN_Master_Responder::_receiveByte(uint8_t Byte)
+{
+  // act according to current state
+  switch (this->state)
+  {
+    // wait for BREAK, which is received as 0x00
+    case LIN_Master_Responder::STATE_BREAK:
+      if (Byte == 0x00)
+        this->state = LIN_Master_Responder::STATE_SYNC;
+      break;
+
+    // wait for SYNC. Repeated 0x00 -> keep waiting, else no BREAK
+    case LIN_Master_Responder::STATE_SYNC:
+      if (Byte == 0x55)
+        this->state = LIN_Master_Responder::STATE_PID;
+      else if (Byte != 0x00)
+        this->state = LIN_Master_Responder::STATE_BREAK;
+      break;
+
+    // PID received -> respond or receive request
+    case LIN_Master_Responder::STATE_PID:
+      this->_receivePID(Byte);
+      break;
+
+    // check echo of sent response. Mismatch e.g. due to collision with other slave
+    case LIN_Master_Responder::STATE_RESPONSE:
+      if (Byte != this->buf[this->pos])
+        this->_frameDone(LIN_Master::ERROR_ECHO);
+      else if (++(this->pos) >= this->len)
+        this->_frameDone(LIN_Master::NO_ERROR);
+      break;
+
+    // receive master request. When complete, check checksum and store data
+    case LIN_Master_Responder::STATE_REQUEST:
+      this->buf[this->pos++] = Byte;
+      if (this->pos >= this->len)
+      {
+        LIN_Master_Responder::entry_t   *pEntry = this->table + this->id;
+        if (this->buf[this->len-1] != LIN_Master::calculateChecksum(pEntry->version, this->id, this->len-1, this->buf))
+          this->_frameDone(LIN_Master::ERROR_CHK);
+        else
+        {
+          memcpy(pEntry->data, this->buf, this->len-1);
+          this->_frameDone(LIN_Master::NO_ERROR);
+        }
+      }
+      break;
+
+    // interface closed -> ignore byte
+    default:
+      break;
+
+  } // switch (state)
+
+} // LIN_Master_Responder::_receiveByte()
+
+
+
+/**
+  \brief      Handle received PID
+  \details    Check parity of received PID and look up frame in table. Slave response frames are sent directly,
+              master request frames are received by the following handler() calls. Other IDs are skipped.
+  \param[in]  PID       received protected identifier
+*/
+void LIN_Master_Responder::_receivePID(uint8_t PID)
+{
+  LIN_Master_Responder::entry_t   *pEntry;
+
+  // store unprotected ID
+  this->id = PID & 0x3F;
+
+  // parity error -> report and wait for next BREAK
+  if (PID != LIN_Master::calculatePID(PID))
+  {
+    this->_frameDone(LIN_Master::ERROR_CHK);
+    return;
+  }
+
+  // ID not handled -> skip frame
+  pEntry = (this->table != NULL) ? (this->table + this->id) : NULL;
+  if ((pEntry == NULL) || (pEntry->numData == 0) || (pEntry->numData > 8) ||
+    ((pEntry->type != LIN_Master::SLAVE_RESPONSE) && (pEntry->type != LIN_Master::MASTER_REQUEST)))
+  {
+    this->state = LIN_Master_Responder::STATE_BREAK;
+    return;
+  }
+
+  // set frame timeout (= 150% nominal DATA[]+CHK+response space)
+  this->len       = pEntry->numData + 1;
+  this->pos       = 0;
+  this->timeStart = micros();
+  this->timeMax   = (((this->len + 1) * this->timePerByte) * 3) >> 1;
+
+  // slave response -> send DATA[] and CHK directly, then check echo
+  if (pEntry->type == LIN_Master::SLAVE_RESPONSE)
+  {
+    memcpy(this->buf, pEntry->data, pEntry->numData);
+    this->buf[pEntry->numData] = LIN_Master::calculateChecksum(pEntry->version, this->id, pEntry->numData, this->buf);
+    this->pSerial->write(this->buf, this->len);
+    this->state = LIN_Master_Responder::STATE_RESPONSE;
+  }
+
+  // master request -> receive DATA[] and CHK
+  else
+    this->state = LIN_Master_Responder::STATE_REQUEST;
+
+} // LIN_Master_Responder::_receivePID()
+
+
+
+/**
+  \brief      Frame finished, notify user
+  \details    Frame finished. Count error-free frames, call user callback and wait for next BREAK
+  \param[in]  Error     frame error
+*/
+void LIN_Master_Responder::_frameDone(LIN_Master::error_t Error)
+{
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 1)
+    if (Error != LIN_Master::NO_ERROR)
+    {
+      LIN_DEBUG_SERIAL.print("LIN_Master_Responder::_frameDone(): ID 0x");
+      LIN_DEBUG_SERIAL.print(this->id, HEX);
+      LIN_DEBUG_SERIAL.print(", error 0x");
+      LIN_DEBUG_SERIAL.println(Error, HEX);
+    }
+  #endif
+
+  // store result and wait for next BREAK
+  this->error = Error;
+  this->state = LIN_Master_Responder::STATE_BREAK;
+  if ((Error == LIN_Master::NO_ERROR) && (this->table != NULL))
+    this->table[this->id].count++;
+
+  // notify user
+  if (this->callback != NULL)
+    this->callback(this->id, Error);
+
+} // LIN_Master_Responder::_frameDone()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor for LIN responder
+  \details    Constructor for LIN responder. Store pointer to used serial interface.
+  \param[in]  Interface     serial interface for LIN
+*/
+LIN_Master_Responder::LIN_Master_Responder(HardwareSerial &Interface)
+{
+  // store pointer to used HW serial
+  this->pSerial     = &Interface;
+
+  // initialize responder properties
+  this->baudrate    = 0;
+  this->timePerByte = 0;
+  this->table       = NULL;
+  this->callback    = NULL;
+  this->state       = LIN_Master_Responder::STATE_OFF;
+  this->error       = LIN_Master::NO_ERROR;
+  this->id          = 0;
+  this->len         = 0;
+  this->pos         = 0;
+  this->timeStart   = 0;
+  this->timeMax     = 0;
+
+  // must not open connection here, else (at least) ESP32 and ESP8266 fail
+
+} // LIN_Master_Responder::LIN_Master_Responder()
+
+
+
+/**
+  \brief      Open serial interface
+  \details    Open serial interface with specified baudrate and wait for first BREAK
+  \param[in]  Baudrate    communication speed [Baud]
+*/
+void LIN_Master_Responder::begin(uint16_t Baudrate)
+{
+  // store parameters in class variables
+  this->baudrate    = Baudrate;
+  this->timePerByte = 10000000L / (uint32_t) this->baudrate;
+
+  // open serial interface
+  this->pSerial->begin(this->baudrate);
+  while(!(*(this->pSerial)));
+
+  // wait for first frame
+  this->error = LIN_Master::NO_ERROR;
+  this->state = LIN_Master_Responder::STATE_BREAK;
+
+} // LIN_Master_Responder::begin()
+
+
+
+/**
+  \brief      Close serial interface
+  \details    Close serial interface
+*/
+void LIN_Master_Responder::end(void)
+{
+  // close serial interface
+  this->pSerial->end();
+  this->state = LIN_Master_Responder::STATE_OFF;
+
+} // LIN_Master_Responder::end()
+
+
+
+/**
+  \brief      Attach frame table
+  \details    Attach frame table with one entry per frame ID. Entries can be initialized statically or via setFrame().
+              Table is not cleared on attach
+  \param[in]  Table     table with 64 entries for IDs 0x00..0x3F. Must remain valid while attached. NULL = detach
+*/
+void LIN_Master_Responder::attachTable(LIN_Master_Responder::entry_t Table[64])
+{
+  // table must not be used by handler() meanwhile
+  noInterrupts();
+  this->table = Table;
+  if (this->state != LIN_Master_Responder::STATE_OFF)
+    this->state = LIN_Master_Responder::STATE_BREAK;
+  interrupts();
+
+} // LIN_Master_Responder::attachTable()
+
+
+
+/**
+  \brief      Set frame of an ID
+  \details    Set frame type, version and data of an ID. Slave response data is published with the next header of
+              this ID. Interrupts are disabled for consistency
+  \param[in]  Type      SLAVE_RESPONSE (publish data), MASTER_REQUEST (receive data) or other (ignore ID)
+  \param[in]  Version   LIN protocol version
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \param[in]  NumData   number of data bytes (1..8)
+  \param[in]  Data      response data (NULL = keep data)
+*/
+void LIN_Master_Responder::setFrame(LIN_Master::frame_t Type, LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[])
+{
+  LIN_Master_Responder::entry_t   *pEntry;
+
+  // no table attached or invalid length
+  if ((this->table == NULL) || (NumData > 8))
+    return;
+
+  // update table entry
+  pEntry = this->table + (Id & 0x3F);
+  noInterrupts();
+  pEntry->type    = Type;
+  pEntry->version = Version;
+  pEntry->numData = NumData;
+  if (Data != NULL)
+    memcpy(pEntry->data, Data, NumData);
+  interrupts();
+
+} // LIN_Master_Responder::setFrame()
+
+
+
+/**
+  \brief      Getter for data of an ID
+  \details    Copy data of an ID, e.g. the last received master request. Interrupts are disabled for consistency
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \param[out] Data      buffer for data (size >= numData of entry)
+*/
+void LIN_Master_Responder::getData(uint8_t Id, uint8_t Data[])
+{
+  LIN_Master_Responder::entry_t   *pEntry;
+
+  // no table attached
+  if (this->table == NULL)
+    return;
+
+  // copy data
+  pEntry = this->table + (Id & 0x3F);
+  noInterrupts();
+  memcpy(Data, pEntry->data, (pEntry->numData <= 8) ? pEntry->numData : 8);
+  interrupts();
+
+} // LIN_Master_Responder::getData()
+
+
+
+/**
+  \brief      Handle received bytes
+  \details    Handle all received bytes and check frame timeout. A slave response is sent from the call which received
+              the PID, i.e. handler() must be called at least once per byte time to meet the response space
+  \return     responder state
+*/
+LIN_Master_Responder::state_t LIN_Master_Responder::handler(void)
+{
+  // interface closed
+  if (this->state == LIN_Master_Responder::STATE_OFF)
+    return this->state;
+
+  // handle all received bytes
+  while (this->pSerial->available())
+    this->_receiveByte(this->pSerial->read());
+
+  // frame not completed in time -> abort
+  if (((this->state == LIN_Master_Responder::STATE_RESPONSE) || (this->state == LIN_Master_Responder::STATE_REQUEST)) &&
+    (micros() - this->timeStart > this->timeMax))
+    this->_frameDone(LIN_Master::ERROR_TIMEOUT);
+
+  // return responder state
+  return this->state;
+
+} // LIN_Master_Responder::handler()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,143 @@
+/**
+  \file     LIN_master_Responder.h
+  \brief    LIN slave node emulation (responder) via a HardwareSerial interface
+  \details  This library emulates any number of LIN slave nodes on one HardwareSerial interface, e.g. for testing
+            master code in a hardware-in-the-loop rig. It detects BREAK+SYNC, checks the received PID and looks up the
+            frame in a table indexed by frame ID. Slave responses are published directly from the handler() call which
+            received the PID, master requests are received and stored in the same table.
+            PID and checksum are calculated via the LIN_Master frame engine, see LIN_master.h.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \note     As HardwareSerial reports no framing errors, BREAK is detected as 0x00 followed by SYNC (0x55). Frames with IDs
+            not in the table are skipped until the next BREAK
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_RESPONDER_H_
+#define _LIN_MASTER_RESPONDER_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <Arduino.h>
+#include "LIN_master.h"
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  LIN slave node emulation via HardwareSerial
+
+  \details LIN slave node emulation via HardwareSerial. Responds to or receives frames according to a frame table.
+*/
+class LIN_Master_Responder
+{
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// state of responder state machine
+    typedef enum
+    {
+      STATE_OFF       = 0,                        //!< LIN interface closed
+      STATE_BREAK     = 1,                        //!< wait for BREAK (0x00)
+      STATE_SYNC      = 2,                        //!< wait for SYNC (0x55)
+      STATE_PID       = 3,                        //!< wait for protected ID
+      STATE_RESPONSE  = 4,                        //!< response sent, wait for echo of DATA[] and CHK
+      STATE_REQUEST   = 5                         //!< receive DATA[] and CHK of master request
+    } state_t;
+
+
+    /// frame table entry per ID
+    typedef struct
+    {
+      LIN_Master::frame_t   type;                 //!< SLAVE_RESPONSE: publish data. MASTER_REQUEST: receive data. Other: ignore ID
+      LIN_Master::version_t version;              //!< LIN protocol version (for checksum)
+      uint8_t               numData;              //!< number of data bytes (1..8)
+      uint8_t               data[8];              //!< response data to publish, or last received request data
+      volatile uint8_t      count;                //!< number of frames handled without error (overflows)
+    } entry_t;
+
+
+    /// callback for handled frame. Called from handler() after the response echo or request was received
+    typedef void (*callback_t)(uint8_t Id, LIN_Master::error_t Error);
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    HardwareSerial        *pSerial;               //!< pointer to used HW serial
+    uint16_t              baudrate;               //!< communication baudrate [Baud]
+    uint32_t              timePerByte;            //!< time [us] per byte at specified baudrate
+    entry_t               *table;                 //!< frame table for IDs 0x00..0x3F (NULL = no frames)
+    callback_t            callback;               //!< user function called when a frame is handled (NULL = none)
+
+    // current frame
+    state_t               state;                  //!< state of responder state machine
+    LIN_Master::error_t   error;                  //!< error of last handled frame
+    uint8_t               id;                     //!< ID of current frame
+    uint8_t               buf[9];                 //!< sent response or received request (DATA[] and CHK)
+    uint8_t               len;                    //!< expected number of bytes in buf
+    uint8_t               pos;                    //!< number of bytes received in buf
+    uint32_t              timeStart;              //!< micros() at reception of PID
+    uint32_t              timeMax;                //!< max. time [us] from PID to end of frame
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Handle a received byte
+    void _receiveByte(uint8_t Byte);
+
+    /// @brief Handle received PID, i.e. send response or start receiving request
+    void _receivePID(uint8_t PID);
+
+    /// @brief Frame finished, notify user and wait for next BREAK
+    void _frameDone(LIN_Master::error_t Error);
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_Responder(HardwareSerial &Interface);
+
+    /// @brief Open serial interface
+    void begin(uint16_t Baudrate);
+
+    /// @brief Close serial interface
+    void end(void);
+
+    /// @brief Attach frame table with 64 entries for IDs 0x00..0x3F (NULL = detach)
+    void attachTable(entry_t Table[64]);
+
+    /// @brief Attach callback for handled frames (NULL = detach)
+    inline void attachCallback(callback_t Callback) { this->callback = Callback; }
+
+    /// @brief Set frame of an ID: response to publish or request to receive
+    void setFrame(LIN_Master::frame_t Type, LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[] = NULL);
+
+    /// @brief Getter for data of an ID, e.g. last received request. Interrupts are disabled for consistency
+    void getData(uint8_t Id, uint8_t Data[]);
+
+    /// @brief Getter for responder state
+    inline state_t getState(void) { return this->state; }
+
+    /// @brief Getter for error of last handled frame
+    inline LIN_Master::error_t getError(void) { return this->error; }
+
+    /// @brief Handle received bytes (call as often as possible, at least once per byte time)
+    state_t handler(void);
+
+}; // class LIN_Master_Responder
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_RESPONDER_H_
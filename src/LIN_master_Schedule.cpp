@@ -0,0 +1,466 @@
+/**
+  \file     LIN_master_Schedule.cpp
+  \brief    Schedule table handler for LIN master emulation
+  \details  This library provides a table-driven scheduler on top of a LIN master node.
+            Frame slots are started on a fixed time grid, i.e. without drift, and the next slot is started
+            from the same handler() call that finished the previous frame.
+            Event triggered slots are resolved via a collision resolution table, and sporadic slots send the
+            first updated frame of their associated frame list (LIN 2.x).
+            Frames failing with timeout or checksum error are retried according to a per-slot retry policy.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "LIN_master_Schedule.h"
+#if defined(LIN_SCHEDULE_CHECK)
+  #include "LIN_master_Analyzer.h"
+#endif
+
+
+/**************************
+ * PROTECTED METHODS
+**************************/
+
+/**
+  \brief      Start frame of current slot
+  \details    Start LIN frame of current slot in background. While resolving a collision, the current entry
+              of the collision resolution table is started instead. A sporadic slot sends the first updated
+              frame of its associated frame list, or stays empty if no frame is updated.
+*/
+void LIN_Master_Schedule::_startSlot(void)
+{
+  const LIN_Master_Schedule::slot_t   *pSlot = this->_getSlot();
+  uint8_t                             id;
+
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.print("LIN_Master_Schedule::_startSlot(): ");
+    LIN_DEBUG_SERIAL.println((int) this->slot);
+  #endif
+
+  // new frame -> no retries yet
+  this->frame    = NULL;
+  this->numRetry = 0;
+
+  // sporadic slot -> send highest priority updated frame and clear its flag. No updated frame -> slot stays empty
+  if (pSlot->type == LIN_Master::SPORADIC)
+  {
+    const LIN_Master_Schedule::slot_t   *pList = pSlot->table;
+    pSlot = NULL;
+    for (uint8_t i=0; i<this->_getSlot()->numSlots; i++)
+    {
+      id = pList[i].id & 0x3F;
+      if (this->updated[id >> 5] & (1UL << (id & 0x1F)))
+      {
+        noInterrupts();
+        this->updated[id >> 5] &= ~(1UL << (id & 0x1F));
+        interrupts();
+        pSlot = pList + i;
+        break;
+      }
+    }
+    if (pSlot == NULL)
+      return;
+  }
+
+  // start frame and store it for retries
+  if (this->_startFrame(pSlot))
+    this->frame = pSlot;
+
+} // LIN_Master_Schedule::_startSlot()
+
+
+
+/**
+  \brief      Start frame of a slot or table entry
+  \details    Start LIN frame of a slot or table entry in background with the baudrate of the slot. A slave response
+              of an absent slave in backoff is skipped, i.e. the slot stays empty
+  \param[in]  pSlot     slot or table entry to start
+  \return     true if frame is started or queued, false if slot stays empty
+*/
+bool LIN_Master_Schedule::_startFrame(const LIN_Master_Schedule::slot_t *pSlot)
+{
+  // set baudrate of frame. Timing is precomputed, i.e. fast for a few different baudrates
+  this->pLIN->setBaudrate(pSlot->baudrate);
+
+  // start frame according to slot type. Skip slave response of absent slave during backoff (slot stays empty)
+  if (pSlot->type == LIN_Master::MASTER_REQUEST)
+    this->pLIN->sendMasterRequest(pSlot->version, pSlot->id, pSlot->numData, pSlot->data);
+  else if (pSlot->type == LIN_Master::EVENT_TRIGGERED)
+    this->pLIN->receiveEventTriggered(pSlot->version, pSlot->id, pSlot->numData);
+  else if (!this->pLIN->skipFrame(pSlot->id))
+    this->pLIN->receiveSlaveResponse(pSlot->version, pSlot->id, pSlot->numData);
+  else
+    return false;
+
+  // wait for frame to finish
+  this->ongoing = true;
+  return true;
+
+} // LIN_Master_Schedule::_startFrame()
+
+
+
+/**
+  \brief      Check if frame of current slot was finished
+  \details    Check if the frame of the current slot was finished since the last call, via the sequence number of
+              completed frames of the LIN node. Unlike STATE_DONE this also works if the LIN node releases the state
+              machine directly, i.e. if a result or job queue is attached. Other frames, e.g. one-shot frames from
+              the job queue, are ignored
+  \param[out] View      zero-copy view of finished frame, see LIN_Master::getFrameView()
+  \return     true if frame of current slot was finished
+*/
+bool LIN_Master_Schedule::_checkFrame(LIN_Master::view_t &View)
+{
+  // no frame finished since last call
+  if (this->pLIN->getFrameSeq() == this->seqFrame)
+    return false;
+  this->seqFrame = this->pLIN->getFrameSeq();
+
+  // no frame of current slot ongoing
+  if ((!this->ongoing) || (this->frame == NULL))
+    return false;
+
+  // check that finished frame belongs to current slot
+  this->pLIN->getFrameView(View);
+  if ((View.type != this->frame->type) || (View.id != this->frame->id))
+    return false;
+
+  // frame of current slot finished
+  this->ongoing = false;
+  return true;
+
+} // LIN_Master_Schedule::_checkFrame()
+
+
+
+/**
+  \brief      Advance to next slot
+  \details    Advance to next slot. After a collision in an event triggered slot, the entries of its collision
+              resolution table are polled first. A pending table switch is done at the slot or table boundary.
+*/
+void LIN_Master_Schedule::_nextSlot(void)
+{
+  // collision detected -> poll resolution table in following slots
+  if (this->collision)
+  {
+    this->collision = false;
+    this->resolve   = 0;
+  }
+
+  // resolving collision -> next entry of resolution table
+  else if ((this->resolve != 0xFF) && (this->resolve+1 < this->table[this->slot].numSlots))
+    this->resolve++;
+
+  // switch to new table (if pending), else advance to next slot
+  else
+  {
+    this->resolve = 0xFF;
+    if ((this->tableNext != NULL) && ((this->switchImmediate) || (this->slot+1 >= this->numSlots)))
+    {
+      noInterrupts();
+      this->table     = this->tableNext;
+      this->numSlots  = this->numSlotsNext;
+      this->tableNext = NULL;
+      interrupts();
+      this->slot      = 0;
+    }
+    else if (++(this->slot) >= this->numSlots)
+      this->slot = 0;
+  }
+
+} // LIN_Master_Schedule::_nextSlot()
+
+
+
+/**
+  \brief      Check if failed frame of current slot is retried
+  \details    Check if the finished frame of the current slot is retried, i.e. it failed with ERROR_TIMEOUT or
+              ERROR_CHK and has retries left. Event triggered frames are not retried, as a missing response is
+              regular and collisions are resolved via the resolution table. Slave responses of absent slaves
+              in backoff are not retried either, see LIN_Master::isBackoff()
+  \param[in]  Error     error of finished frame
+  \return     true if frame is retried
+*/
+bool LIN_Master_Schedule::_checkRetry(LIN_Master::error_t Error)
+{
+  const LIN_Master_Schedule::slot_t   *pFrame = this->frame;
+
+  // no retry configured or retries exhausted
+  if ((pFrame == NULL) || (this->numRetry >= pFrame->retries))
+    return false;
+
+  // only retry timeout or checksum error of unconditional frames
+  if ((!(Error & (LIN_Master::ERROR_TIMEOUT | LIN_Master::ERROR_CHK))) ||
+    (pFrame->type == LIN_Master::EVENT_TRIGGERED))
+    return false;
+
+  // absent slave in backoff -> don't retry
+  if ((pFrame->type == LIN_Master::SLAVE_RESPONSE) && (this->pLIN->isBackoff(pFrame->id)))
+    return false;
+
+  // count retry
+  this->numRetry++;
+  return true;
+
+} // LIN_Master_Schedule::_checkRetry()
+
+
+
+/**
+  \brief      Check if a schedule table is feasible
+  \details    Check slot times of a schedule table at the nominal baudrate of the LIN node, see LIN_Master_Analyzer.
+              Only with LIN_SCHEDULE_CHECK, else and before LIN_Master::begin() all tables are accepted
+  \param[in]  Table       array of frame slots
+  \param[in]  NumSlots    number of frame slots in table
+  \return     true if table is accepted
+*/
+bool LIN_Master_Schedule::_checkTable(const LIN_Master_Schedule::slot_t Table[], uint8_t NumSlots)
+{
+  #if defined(LIN_SCHEDULE_CHECK)
+    if (this->pLIN->getNominalBaudrate() != 0)
+      return LIN_Master_Analyzer::isFeasible(Table, NumSlots, this->pLIN->getNominalBaudrate());
+  #else
+    (void) Table;
+    (void) NumSlots;
+  #endif
+
+  // no check
+  return true;
+
+} // LIN_Master_Schedule::_checkTable()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor for LIN schedule table handler
+  \details    Constructor for LIN schedule table handler. Store pointer to used LIN master node.
+  \param[in]  Interface     LIN master node to execute the schedule on
+*/
+LIN_Master_Schedule::LIN_Master_Schedule(LIN_Master &Interface)
+{
+  // store pointer to LIN node
+  this->pLIN            = &Interface;
+
+  // initialize schedule properties
+  this->table           = NULL;
+  this->numSlots        = 0;
+  this->tableNext       = NULL;
+  this->numSlotsNext    = 0;
+  this->switchImmediate = false;
+  this->slot            = 0;
+  this->timeSlot        = 0;
+  this->running         = false;
+  this->pending         = false;
+  this->delayStart      = 0;
+  this->callback        = NULL;
+  this->collision       = false;
+  this->resolve         = 0xFF;
+  this->updated[0]      = 0;
+  this->updated[1]      = 0;
+  this->frame           = NULL;
+  this->numRetry        = 0;
+  this->retryPending    = false;
+  this->seqRetry        = 0;
+  this->ongoing         = false;
+  this->seqFrame        = this->pLIN->getFrameSeq();
+
+} // LIN_Master_Schedule::LIN_Master_Schedule()
+
+
+
+/**
+  \brief      Set schedule table
+  \details    Set schedule table. If schedule is running, the new table is started with its first slot
+              either after the current slot (Immediate=true) or after the last slot of the current table.
+  \param[in]  Table       array of frame slots. Must remain valid while in use
+  \param[in]  NumSlots    number of frame slots in table
+  \param[in]  Immediate   switch table after current slot (true) or at end of current table (false)
+  \return     true if table is set, false if table is infeasible (only with LIN_SCHEDULE_CHECK)
+*/
+bool LIN_Master_Schedule::setTable(const LIN_Master_Schedule::slot_t Table[], uint8_t NumSlots, bool Immediate)
+{
+  // infeasible table -> keep current table
+  if (!this->_checkTable(Table, NumSlots))
+    return false;
+
+  // schedule not running -> use new table directly
+  if (!this->running)
+  {
+    this->table     = Table;
+    this->numSlots  = NumSlots;
+    this->slot         = 0;
+    this->collision    = false;
+    this->resolve      = 0xFF;
+    this->retryPending = false;
+    return true;
+  }
+
+  // store table for switching at slot boundary
+  noInterrupts();
+  this->tableNext       = Table;
+  this->numSlotsNext    = NumSlots;
+  this->switchImmediate = Immediate;
+  interrupts();
+
+  // table set
+  return true;
+
+} // LIN_Master_Schedule::setTable()
+
+
+
+/**
+  \brief      Start schedule with first slot
+  \details    Start schedule with first slot. The first frame is started by the first call of handler() after
+              the specified delay, e.g. to stagger schedules of several buses. With LIN_SCHEDULE_CHECK, a table
+              set before LIN_Master::begin() is checked here
+  \param[in]  Delay     delay [us] of first slot
+  \return     true if schedule is started, false if table is invalid or infeasible
+*/
+bool LIN_Master_Schedule::start(uint32_t Delay)
+{
+  // no valid or infeasible table -> don't start
+  if ((this->table == NULL) || (this->numSlots == 0) || (!this->_checkTable(this->table, this->numSlots)))
+    return false;
+
+  // start with first slot
+  this->slot         = 0;
+  this->collision    = false;
+  this->resolve      = 0xFF;
+  this->retryPending = false;
+  this->ongoing      = false;
+  this->seqFrame     = this->pLIN->getFrameSeq();
+  this->timeSlot     = micros();
+  this->delayStart   = Delay;
+  this->pending      = true;
+  this->running      = true;
+
+  // schedule started
+  return true;
+
+} // LIN_Master_Schedule::start()
+
+
+
+/**
+  \brief      Handle LIN background operation and schedule (call as often as possible)
+  \details    Handle LIN background operation and schedule. Call LIN master handler and check for finished frames.
+              Next slot is started as soon as current frame is finished and the current slot time has elapsed.
+              Slot starting times are on a fixed grid, i.e. handler call latency does not accumulate.
+              After a collision in an event triggered slot, the frames of its collision resolution table are
+              polled in the following slots (using their slot times) before the schedule continues.
+              Frames failing with ERROR_TIMEOUT or ERROR_CHK are retried directly or in an inserted slot,
+              depending on their retry policy. The callback is only called with the result of the last retry.
+              Finished frames are detected via the frame sequence number, i.e. retries and collision resolution
+              also work with a result or job queue attached to the LIN node.
+  \return     LIN state machine state
+*/
+LIN_Master::state_t LIN_Master_Schedule::handler(void)
+{
+  LIN_Master::state_t   state;
+  LIN_Master::view_t    view;
+  uint32_t              timeNow;
+
+  // call LIN background handler
+  state = this->pLIN->handler();
+
+  // frame of current slot finished -> check for collision and retry, and notify user
+  if (this->_checkFrame(view))
+  {
+    // collision in event triggered slot -> start resolution after this slot
+    if ((this->resolve == 0xFF) && (this->table[this->slot].type == LIN_Master::EVENT_TRIGGERED) &&
+      (this->table[this->slot].numSlots > 0) && (view.error & LIN_Master::ERROR_CHK))
+      this->collision = true;
+
+    // failed frame with retries left -> repeat directly within slot time (if no queued frame was started), or in next slot
+    if (this->_checkRetry(view.error))
+    {
+      if ((this->frame->retry == LIN_Master_Schedule::RETRY_IMMEDIATE) &&
+        ((state == LIN_Master::STATE_IDLE) || (state == LIN_Master::STATE_DONE)))
+      {
+        this->ongoing = true;
+        return this->pLIN->retryFrame();
+      }
+      this->retryPending = true;
+      this->seqRetry     = this->seqFrame;
+    }
+
+    // notify user about final result. With result or job queue the LIN node is already released
+    else if ((this->callback != NULL) && (state == LIN_Master::STATE_DONE))
+      this->callback(*(this->pLIN), this->slot);
+
+  } // frame finished
+
+  // frame finished -> release LIN node
+  if (state == LIN_Master::STATE_DONE)
+  {
+    this->pLIN->resetStateMachine();
+    this->pLIN->resetError();
+    state = LIN_Master::STATE_IDLE;
+  }
+
+  // schedule stopped or frame ongoing -> nothing else to do
+  if ((!this->running) || (state != LIN_Master::STATE_IDLE))
+    return state;
+
+  // get current time
+  timeNow = micros();
+
+  // first slot after start() -> start time grid after delay
+  if (this->pending)
+  {
+    if (timeNow - this->timeSlot < this->delayStart)
+      return state;
+    this->pending  = false;
+    this->timeSlot = timeNow;
+  }
+
+  // frame of current slot finished
+  else
+  {
+    // wait until current slot has elapsed
+    if (timeNow - this->timeSlot < this->_getSlot()->slotTime)
+      return state;
+
+    // advance time grid by slot duration (avoids drift)
+    this->timeSlot += this->_getSlot()->slotTime;
+
+    // advance to next slot, unless failed frame is repeated in an inserted slot
+    if (!this->retryPending)
+      this->_nextSlot();
+
+    // schedule lags behind by more than one slot (e.g. overrun) -> re-sync time grid
+    if (timeNow - this->timeSlot >= this->_getSlot()->slotTime)
+      this->timeSlot = timeNow;
+
+  } // frame finished
+
+  // start frame of this slot, or repeat failed frame. Other frames finished meanwhile (e.g. from job queue) -> start failed frame again
+  if (this->retryPending)
+  {
+    this->retryPending = false;
+    if (this->pLIN->getFrameSeq() == this->seqRetry)
+    {
+      this->ongoing = true;
+      this->pLIN->retryFrame();
+    }
+    else
+      this->_startFrame(this->frame);
+  }
+  else
+    this->_startSlot();
+
+  // return state machine state
+  return this->pLIN->getState();
+
+} // LIN_Master_Schedule::handler()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
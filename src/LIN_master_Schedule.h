@@ -0,0 +1,176 @@
+/**
+  \file     LIN_master_Schedule.h
+  \brief    Schedule table handler for LIN master emulation
+  \details  This library provides a table-driven scheduler on top of a LIN master node.
+            Frame slots are started on a fixed time grid, i.e. without drift, and the next slot is started
+            from the same handler() call that finished the previous frame.
+            Event triggered slots are resolved via a collision resolution table, and sporadic slots send the
+            first updated frame of their associated frame list (LIN 2.x).
+            Frames failing with timeout or checksum error are retried according to a per-slot retry policy.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_SCHEDULE_H_
+#define _LIN_MASTER_SCHEDULE_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <Arduino.h>
+#include "LIN_master.h"
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+//#define LIN_SCHEDULE_CHECK                //!< reject infeasible tables in setTable() and start(), see LIN_Master_Analyzer
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  LIN schedule table handler
+
+  \details LIN schedule table handler. Executes a table of frame slots on a LIN master node in background.
+*/
+class LIN_Master_Schedule
+{
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// retry policy of a frame slot, i.e. when a failed frame is repeated and how retries count toward slot time
+    typedef enum
+    {
+      RETRY_IMMEDIATE = 0,                        //!< repeat directly from handler(). Retries share the slot time of the failed frame
+      RETRY_NEXT_SLOT = 1                         //!< repeat in an inserted slot. Each retry takes one more slot time, i.e. delays the schedule
+    } retry_t;
+
+
+    /// schedule table entry (=frame slot)
+    typedef struct slot_s
+    {
+      LIN_Master::frame_t   type;                 //!< frame type (MASTER_REQUEST, SLAVE_RESPONSE, EVENT_TRIGGERED or SPORADIC)
+      LIN_Master::version_t version;              //!< LIN protocol version
+      uint8_t               id;                   //!< frame identifier (protected or unprotected)
+      uint8_t               numData;              //!< number of data bytes (0..8)
+      uint8_t               *data;                //!< data bytes for master request (NULL for slave response)
+      uint32_t              slotTime;             //!< slot duration [us]. 0 = start next slot directly after frame
+      const struct slot_s   *table;               //!< event triggered: collision resolution table. Sporadic: associated frames by priority
+      uint8_t               numSlots;             //!< number of entries in above table
+      uint8_t               retries;              //!< max. retries after ERROR_TIMEOUT or ERROR_CHK (0 = no retry)
+      retry_t               retry;                //!< retry policy, see retry_t
+      uint16_t              baudrate;             //!< baudrate [Baud] of frame (0 = baudrate of LIN_Master::begin()), see LIN_Master::setBaudrate()
+    } slot_t;
+
+    /// callback for finished frame slot. Called before state machine and error are reset, after last retry. Not called if LIN node uses a result or job queue
+    typedef void (*callback_t)(LIN_Master &LIN, uint8_t Slot);
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    LIN_Master            *pLIN;                  //!< pointer to LIN master node
+    const slot_t          *table;                 //!< active schedule table
+    uint8_t               numSlots;               //!< number of slots in active table
+    const slot_t          *tableNext;             //!< schedule table to switch to at end of table (NULL = none)
+    uint8_t               numSlotsNext;           //!< number of slots in next table
+    bool                  switchImmediate;        //!< switch to next table after current slot
+    uint8_t               slot;                   //!< index of current slot
+    uint32_t              timeSlot;               //!< starting time [us] of current slot
+    bool                  running;                //!< schedule is executed
+    bool                  pending;                //!< frame of current slot not yet started
+    uint32_t              delayStart;             //!< delay [us] of first slot after start()
+    callback_t            callback;               //!< user function called when a frame is finished
+
+    // event triggered and sporadic frames
+    bool                  collision;              //!< collision in event triggered slot -> resolve in next slots
+    uint8_t               resolve;                //!< index in collision resolution table (0xFF = not resolving)
+    uint32_t              updated[2];             //!< bitmask of updated sporadic frames per ID 0x00..0x3F
+
+    // retries of failed frames
+    const slot_t          *frame;                 //!< entry of frame started in current slot (NULL = slot empty)
+    uint8_t               numRetry;               //!< number of retries of current frame
+    bool                  retryPending;           //!< repeat failed frame in next slot (RETRY_NEXT_SLOT)
+    uint8_t               seqRetry;               //!< frame sequence number when retry was scheduled, see LIN_Master::getFrameSeq()
+
+    // detection of finished frames, also if LIN node releases state machine directly (result or job queue)
+    bool                  ongoing;                //!< frame of current slot started and not yet finished
+    uint8_t               seqFrame;               //!< sequence number of last checked frame, see LIN_Master::getFrameSeq()
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Start frame of current slot
+    void _startSlot(void);
+
+    /// @brief Start frame of a slot or table entry. Returns false if slot stays empty
+    bool _startFrame(const slot_t *pSlot);
+
+    /// @brief Check if frame of current slot was finished in last LIN handler call
+    bool _checkFrame(LIN_Master::view_t &View);
+
+    /// @brief Advance to next slot, next entry of collision resolution table or next table
+    void _nextSlot(void);
+
+    /// @brief Check if failed frame of current slot is retried
+    bool _checkRetry(LIN_Master::error_t Error);
+
+    /// @brief Check if a schedule table is feasible (only with LIN_SCHEDULE_CHECK)
+    bool _checkTable(const slot_t Table[], uint8_t NumSlots);
+
+    /// @brief Getter for current slot, i.e. entry of collision resolution table while resolving
+    inline const slot_t *_getSlot(void)
+      { return (this->resolve != 0xFF) ? (this->table[this->slot].table + this->resolve) : (this->table + this->slot); }
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_Schedule(LIN_Master &Interface);
+
+    /// @brief Set schedule table. Returns false for infeasible table (only with LIN_SCHEDULE_CHECK)
+    bool setTable(const slot_t Table[], uint8_t NumSlots, bool Immediate = true);
+
+    /// @brief Attach callback for finished frames
+    inline void attachCallback(callback_t Callback) { this->callback = Callback; }
+
+    /// @brief Start schedule with first slot (optionally delayed, e.g. for staggering buses). Returns false for invalid or infeasible table
+    bool start(uint32_t Delay = 0);
+
+    /// @brief Stop schedule after current frame
+    inline void stop(void) { this->running = false; }
+
+    /// @brief Getter for schedule status
+    inline bool isRunning(void) { return this->running; }
+
+    /// @brief Getter for index of current slot
+    inline uint8_t getSlot(void) { return this->slot; }
+
+    /// @brief Getter for collision resolution status
+    inline bool isResolving(void) { return (this->resolve != 0xFF); }
+
+    /// @brief Mark a frame as updated, i.e. send it in next sporadic slot it is associated to
+    inline void setUpdated(uint8_t Id)
+      { Id &= 0x3F; noInterrupts(); this->updated[Id >> 5] |= (1UL << (Id & 0x1F)); interrupts(); }
+
+    /// @brief Handle LIN background operation and schedule (call as often as possible)
+    LIN_Master::state_t handler(void);
+
+}; // class LIN_Master_Schedule
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_SCHEDULE_H_
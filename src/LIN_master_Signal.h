@@ -0,0 +1,223 @@
+/**
+  \file     LIN_master_Signal.h
+  \brief    Signal packing/unpacking layer for LIN master emulation
+  \details  This header provides compile-time signal descriptors with inlined bit extraction and insertion, and
+            frame buffers with change tracking, so that only changed signals need to be decoded. Signal positions
+            are template parameters, i.e. the compiler generates the minimal shift/mask code per signal.
+            Descriptors are typically generated from a LIN Description File, see extras/LDF_Generator/ldf2h.py.
+            Signals are packed LSB first, with bit 0 being the LSB of the first data byte (as defined by LIN).
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_SIGNAL_H_
+#define _LIN_MASTER_SIGNAL_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <Arduino.h>
+#include "LIN_master.h"
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASSES
+-----------------------------------------------------------------------------*/
+/**
+  \brief  Scalar LIN signal descriptor
+
+  \details Scalar LIN signal (1..16 bit) at a fixed bit position. All methods are static and inlined.
+  \tparam Start     position of signal LSB in frame [bit] (0..63)
+  \tparam Length    signal length [bit] (1..16)
+*/
+template <uint8_t Start, uint8_t Length>
+class LIN_Master_Signal
+{
+  static_assert((Length >= 1) && (Length <= 16), "LIN scalar signal must have 1..16 bits");
+  static_assert(Start + Length <= 64, "LIN signal exceeds 8 data bytes");
+
+  // PUBLIC CONSTANTS
+  public:
+
+    static constexpr uint8_t    start    = Start;                             //!< position of signal LSB [bit]
+    static constexpr uint8_t    length   = Length;                            //!< signal length [bit]
+    static constexpr uint8_t    minData  = (Start + Length + 7) >> 3;         //!< min. number of data bytes containing signal
+    static constexpr uint8_t    first    = Start >> 3;                        //!< index of first data byte
+    static constexpr uint8_t    shift    = Start & 0x07;                      //!< position of signal LSB in first byte
+    static constexpr uint8_t    numBytes = (shift + Length + 7) >> 3;         //!< number of data bytes touched by signal (1..3)
+    static constexpr uint16_t   mask     = (uint16_t) ((1UL << Length) - 1);  //!< signal value mask
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Extract signal value from frame data
+    static inline uint16_t get(const uint8_t Data[])
+    {
+      uint32_t  raw = Data[first];
+      if (numBytes > 1)
+        raw |= ((uint32_t) Data[first+1]) << 8;
+      if (numBytes > 2)
+        raw |= ((uint32_t) Data[first+2]) << 16;
+      return (uint16_t) ((raw >> shift) & mask);
+    }
+
+    /// @brief Insert signal value into frame data. Other bits are not changed
+    static inline void set(uint8_t Data[], uint16_t Value)
+    {
+      uint32_t  val = ((uint32_t) (Value & mask)) << shift;
+      uint32_t  msk = ((uint32_t) mask) << shift;
+      Data[first] = (uint8_t) ((Data[first] & ~msk) | val);
+      if (numBytes > 1)
+        Data[first+1] = (uint8_t) ((Data[first+1] & ~(msk >> 8)) | (val >> 8));
+      if (numBytes > 2)
+        Data[first+2] = (uint8_t) ((Data[first+2] & ~(msk >> 16)) | (val >> 16));
+    }
+
+    /// @brief Check if any signal bit is set, e.g. in change mask
+    static inline bool any(const uint8_t Data[]) { return (get(Data) != 0); }
+
+    /// @brief Check if signal has changed in last-value cache entry, see LIN_Master::subscribe()
+    static inline bool isChanged(const LIN_Master::cache_t &Entry) { return ((Entry.numData >= minData) && any(Entry.diff)); }
+
+}; // class LIN_Master_Signal
+
+
+
+/**
+  \brief  Byte array LIN signal descriptor
+
+  \details Byte array LIN signal (1..8 byte) at a fixed byte position. Array signals are accessed in place.
+  \tparam First     index of first data byte (0..7)
+  \tparam NumBytes  signal length [byte] (1..8)
+*/
+template <uint8_t First, uint8_t NumBytes>
+class LIN_Master_SignalArray
+{
+  static_assert((NumBytes >= 1) && (First + NumBytes <= 8), "LIN array signal exceeds 8 data bytes");
+
+  // PUBLIC CONSTANTS
+  public:
+
+    static constexpr uint8_t    start    = First << 3;                        //!< position of signal LSB [bit]
+    static constexpr uint8_t    length   = NumBytes << 3;                     //!< signal length [bit]
+    static constexpr uint8_t    minData  = First + NumBytes;                  //!< min. number of data bytes containing signal
+    static constexpr uint8_t    first    = First;                             //!< index of first data byte
+    static constexpr uint8_t    numBytes = NumBytes;                          //!< signal length [byte]
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Getter for pointer to signal bytes in frame data (no copy)
+    static inline const uint8_t *get(const uint8_t Data[]) { return Data + First; }
+
+    /// @brief Copy signal bytes into frame data
+    static inline void set(uint8_t Data[], const uint8_t Value[]) { memcpy(Data + First, Value, NumBytes); }
+
+    /// @brief Check if any signal byte is non-zero, e.g. in change mask
+    static inline bool any(const uint8_t Data[])
+    {
+      uint8_t   sum = 0;
+      for (uint8_t i=0; i<NumBytes; i++)
+        sum |= Data[First+i];
+      return (sum != 0);
+    }
+
+    /// @brief Check if signal has changed in last-value cache entry, see LIN_Master::subscribe()
+    static inline bool isChanged(const LIN_Master::cache_t &Entry) { return ((Entry.numData >= minData) && any(Entry.diff)); }
+
+}; // class LIN_Master_SignalArray
+
+
+
+/**
+  \brief  LIN frame buffer with change tracking
+
+  \details LIN frame buffer with change tracking. update() stores new frame data and a bitwise change mask,
+           so that isChanged() checks a signal without decoding it.
+  \tparam NumData   number of data bytes (1..8)
+*/
+template <uint8_t NumData>
+class LIN_Master_SignalFrame
+{
+  static_assert((NumData >= 1) && (NumData <= 8), "LIN frame must have 1..8 data bytes");
+
+  // PUBLIC VARIABLES
+  public:
+
+    uint8_t               data[NumData];          //!< current frame data, e.g. for schedule table
+    uint8_t               diff[NumData];          //!< bits changed by last update() (XOR of old and new data)
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor. Clears data and change mask
+    LIN_Master_SignalFrame(void)
+    {
+      memset(this->data, 0, NumData);
+      memset(this->diff, 0, NumData);
+    }
+
+    /// @brief Store new frame data and update change mask. Returns true if any bit has changed
+    inline bool update(const uint8_t Data[])
+    {
+      uint8_t   sum = 0;
+      for (uint8_t i=0; i<NumData; i++)
+      {
+        this->diff[i] = this->data[i] ^ Data[i];
+        this->data[i] = Data[i];
+        sum |= this->diff[i];
+      }
+      return (sum != 0);
+    }
+
+    /// @brief Store data of error-free result with matching length. Returns true if any bit has changed
+    inline bool update(const LIN_Master::result_t &Result)
+      { return ((Result.error == LIN_Master::NO_ERROR) && (Result.numData == NumData) && this->update(Result.data)); }
+
+    /// @brief Store data of error-free frame view with matching length. Returns true if any bit has changed
+    inline bool update(const LIN_Master::view_t &View)
+      { return ((View.error == LIN_Master::NO_ERROR) && (View.numData == NumData) && this->update(View.data)); }
+
+    /// @brief Clear change mask
+    inline void clearChanged(void) { memset(this->diff, 0, NumData); }
+
+    /// @brief Extract signal value
+    template <class Signal>
+    inline uint16_t get(void) const
+    {
+      static_assert(Signal::minData <= NumData, "signal is not contained in frame");
+      return Signal::get(this->data);
+    }
+
+    /// @brief Insert signal value
+    template <class Signal>
+    inline void set(uint16_t Value)
+    {
+      static_assert(Signal::minData <= NumData, "signal is not contained in frame");
+      Signal::set(this->data, Value);
+    }
+
+    /// @brief Check if signal has changed with last update()
+    template <class Signal>
+    inline bool isChanged(void) const
+    {
+      static_assert(Signal::minData <= NumData, "signal is not contained in frame");
+      return Signal::any(this->diff);
+    }
+
+}; // class LIN_Master_SignalFrame
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_SIGNAL_H_
@@ -0,0 +1,422 @@
+/**
+  \file     LIN_master_Sim.cpp
+  \brief    LIN master node emulation over a simulated bus
+  \details  This library provides a LIN master backend without hardware. Sent bytes are echoed by a virtual bus,
+            emulated slaves respond according to a frame table, and faults are injected pseudo-randomly.
+            For details see LIN_master_Sim.h.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "LIN_master_Sim.h"
+
+
+/**************************
+ * PROTECTED METHODS
+**************************/
+
+/**
+  \brief      Put bytes on virtual bus
+  \details    Replace content of virtual bus with new bytes, e.g. BREAK or frame body. Wire time starts now
+  \param[in]  Data      bytes to put on bus
+  \param[in]  Len       number of bytes
+  \param[in]  TimeByte  duration [ticks] of a byte on bus
+*/
+void LIN_Master_Sim::_putBus(const uint8_t Data[], uint8_t Len, uint32_t TimeByte)
+{
+  // copy bytes and start wire time
+  memcpy(this->bus, Data, Len);
+  this->lenBus      = Len;
+  this->posBus      = 0;
+  this->timeByteBus = TimeByte;
+  this->timeBus     = LIN_Master_Timebase::getTicks();
+
+} // LIN_Master_Sim::_putBus()
+
+
+
+/**
+  \brief      Read next byte from virtual bus
+  \details    Read next byte from virtual bus. With wire time, byte N is available after echo delay plus N+1 byte times
+  \param[out] Byte      read byte
+  \return     true if a byte was read, false if no byte is available (yet)
+*/
+bool LIN_Master_Sim::_readBus(uint8_t &Byte)
+{
+  // no more bytes on bus
+  if (this->posBus >= this->lenBus)
+    return false;
+
+  // wire time: byte not yet completely transmitted
+  if ((this->wireTime) &&
+    (LIN_Master_Timebase::getTicks() - this->timeBus < this->delayEcho + (uint32_t) (this->posBus + 1) * this->timeByteBus))
+    return false;
+
+  // read byte
+  Byte = this->bus[this->posBus++];
+  return true;
+
+} // LIN_Master_Sim::_readBus()
+
+
+
+/**
+  \brief      Append response of emulated slave to virtual bus
+  \details    Look up slave for sent PID and append DATA[] and CHK to the virtual bus. Faults which do not apply
+              to this frame (e.g. no slave responds) are removed from the injected faults
+*/
+void LIN_Master_Sim::_respond(void)
+{
+  uint8_t                         id = this->bufTx[2] & 0x3F;
+  LIN_Master_Responder::entry_t   *pEntry = (this->table != NULL) ? (this->table + id) : NULL;
+  uint8_t                         len;
+
+  // no slave for this ID -> no response, i.e. timeout
+  if ((pEntry == NULL) || (pEntry->type != LIN_Master::SLAVE_RESPONSE) || (pEntry->numData == 0) || (pEntry->numData > 8))
+  {
+    this->faultFrame &= LIN_Master_Sim::FAULT_ECHO;
+    return;
+  }
+
+  // slave is silent -> other response faults don't apply
+  if (this->faultFrame & LIN_Master_Sim::FAULT_TIMEOUT)
+  {
+    this->faultFrame &= (LIN_Master_Sim::FAULT_ECHO | LIN_Master_Sim::FAULT_TIMEOUT);
+    return;
+  }
+
+  // append DATA[] and CHK with version of slave, optionally corrupted or truncated
+  len = pEntry->numData;
+  memcpy(this->bus + this->lenBus, pEntry->data, len);
+  this->bus[this->lenBus + len] = LIN_Master::calculateChecksum(pEntry->version, id, len, pEntry->data);
+  if (this->faultFrame & LIN_Master_Sim::FAULT_CHK)
+    this->bus[this->lenBus + len] ^= 0xFF;
+  len++;
+  if (this->faultFrame & LIN_Master_Sim::FAULT_SHORT)
+    len--;
+  this->lenBus += len;
+  pEntry->count++;
+
+} // LIN_Master_Sim::_respond()
+
+
+
+/**
+  \brief      Send LIN break
+  \details    Put BREAK on virtual bus and select faults for this frame
+  \return     current state of LIN state machine
+*/
+LIN_Master::state_t LIN_Master_Sim::_sendBreak(void)
+{
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master_Sim::_sendBreak()");
+  #endif
+
+  // if bus is not idle, return immediately
+  if (this->state != LIN_Master::STATE_IDLE)
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_STATE);
+    this->state = LIN_Master::STATE_DONE;
+    return this->state;
+  }
+
+  // select faults for this frame
+  this->faultFrame = LIN_Master_Sim::NO_FAULT;
+  for (uint8_t mask = 0x01; mask <= LIN_Master_Sim::FAULT_SHORT; mask <<= 1)
+  {
+    if ((this->faults & mask) && ((this->_random() & 0xFFFF) < this->rateFault))
+      this->faultFrame |= mask;
+  }
+
+  // send BREAK at half baudrate, i.e. double byte time
+  this->_putBus(this->bufTx, 1, 2 * (uint32_t) this->timePerByte);
+
+  // progress state
+  this->state = LIN_Master::STATE_BREAK;
+
+  // return state
+  return this->state;
+
+} // LIN_Master_Sim::_sendBreak()
+
+
+
+/**
+  \brief      Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+  \details    After BREAK echo, put rest of frame on virtual bus. A master request is received by the emulated slaves,
+              for a slave response frame the emulated slave appends its response
+  \return     current state of LIN state machine
+*/
+LIN_Master::state_t LIN_Master_Sim::_sendFrame(void)
+{
+  uint8_t   byte;
+
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master_Sim::_sendFrame()");
+  #endif
+
+  // if state is wrong, exit immediately
+  if (this->state != LIN_Master::STATE_BREAK)
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_STATE);
+    this->state = LIN_Master::STATE_DONE;
+    return this->state;
+  }
+
+  // BREAK not yet finished -> check for timeout
+  if (!this->_readBus(byte))
+  {
+    if (this->_checkTimeout())
+    {
+      this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_TIMEOUT);
+      this->state = LIN_Master::STATE_DONE;
+    }
+    return this->state;
+  }
+
+  // store BREAK echo. Echo of BREAK is not checked
+  this->bufRx[0] = byte;
+  this->numRx    = 1;
+
+  // send rest of frame (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+  this->_putBus(this->bufTx+1, this->lenTx-1, this->timePerByte);
+
+  // slave response frame -> emulated slave responds
+  if (this->lenRx > this->lenTx)
+    this->_respond();
+
+  // master request -> received by emulated slave (if any)
+  else
+  {
+    this->faultFrame &= LIN_Master_Sim::FAULT_ECHO;
+    LIN_Master_Responder::entry_t   *pEntry = (this->table != NULL) ? (this->table + (this->bufTx[2] & 0x3F)) : NULL;
+    if ((pEntry != NULL) && (pEntry->type == LIN_Master::MASTER_REQUEST) && (pEntry->numData == this->lenTx - 4) && (!this->faultFrame))
+    {
+      memcpy(pEntry->data, this->bufTx + 3, pEntry->numData);
+      pEntry->count++;
+    }
+  }
+
+  // corrupt echo of PID
+  if (this->faultFrame & LIN_Master_Sim::FAULT_ECHO)
+    this->bus[1] ^= 0x01;
+  if (this->faultFrame != LIN_Master_Sim::NO_FAULT)
+    this->numFaults++;
+
+  // progress state
+  this->state = LIN_Master::STATE_BODY;
+
+  // return state
+  return this->state;
+
+} // LIN_Master_Sim::_sendFrame()
+
+
+
+/**
+  \brief      Receive and check LIN frame
+  \details    Receive and check LIN frame (request frame: check echo; response frame: check header echo & checksum).
+              In instant mode, missing bytes are reported as timeout without waiting
+  \return     current state of LIN state machine
+*/
+LIN_Master::state_t LIN_Master_Sim::_receiveFrame(void)
+{
+  uint8_t   byte;
+
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master_Sim::_receiveFrame()");
+  #endif
+
+  // if state is wrong, exit immediately
+  if (this->state != LIN_Master::STATE_BODY)
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_STATE);
+    this->state = LIN_Master::STATE_DONE;
+    return this->state;
+  }
+
+  // store received bytes and check echo byte-wise. Abort on first mismatch
+  while ((this->numRx < this->lenRx) && (this->_readBus(byte)))
+  {
+    if (!this->_storeByte(byte))
+      return this->state;
+  }
+
+  // frame body received -> check frame for errors
+  if (this->numRx >= this->lenRx)
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) this->_checkFrame());
+    this->state = LIN_Master::STATE_DONE;
+  }
+
+  // bytes missing -> check for timeout. Instant mode: no more bytes will follow
+  else if (((!this->wireTime) && (this->posBus >= this->lenBus)) || (this->_checkTimeout()))
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_TIMEOUT);
+    this->state = LIN_Master::STATE_DONE;
+  }
+
+  // return state
+  return this->state;
+
+} // LIN_Master_Sim::_receiveFrame()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor for LIN node class over a simulated bus
+  \details    Constructor for LIN node class over a simulated bus. Default is instant timing without slaves and faults
+  \param[in]  NameLIN       LIN node name
+*/
+LIN_Master_Sim::LIN_Master_Sim(const char NameLIN[]) : LIN_Master::LIN_Master(NameLIN)
+{
+  // initialize virtual bus
+  this->lenBus      = 0;
+  this->posBus      = 0;
+  this->timeBus     = 0;
+  this->timeByteBus = 0;
+  this->wireTime    = false;
+  this->delayEcho   = 0;
+
+  // no slaves and faults
+  this->table       = NULL;
+  this->faults      = LIN_Master_Sim::NO_FAULT;
+  this->rateFault   = 0;
+  this->seed        = 1;
+  this->faultFrame  = LIN_Master_Sim::NO_FAULT;
+  this->numFaults   = 0;
+
+} // LIN_Master_Sim::LIN_Master_Sim()
+
+
+
+/**
+  \brief      Open virtual bus
+  \details    Open virtual bus with specified baudrate, which sets the wire time of bytes and the frame timeout
+  \param[in]  Baudrate    communication speed [Baud]
+*/
+void LIN_Master_Sim::begin(uint16_t Baudrate)
+{
+  // call base class method
+  LIN_Master::begin(Baudrate);
+
+  // empty bus
+  this->lenBus = 0;
+  this->posBus = 0;
+
+} // LIN_Master_Sim::begin()
+
+
+
+/**
+  \brief      Close virtual bus
+  \details    Close virtual bus
+*/
+void LIN_Master_Sim::end(void)
+{
+  // call base class method
+  LIN_Master::end();
+
+  // empty bus
+  this->lenBus = 0;
+  this->posBus = 0;
+
+} // LIN_Master_Sim::end()
+
+
+
+/**
+  \brief      Set bus timing
+  \details    Set timing of virtual bus. Instant: all bytes are available directly, e.g. for simulating many frames
+              or measuring CPU overhead. Wire time: bytes are available after their duration at the set baudrate
+  \param[in]  WireTime    bytes are available after their wire time (false = instant)
+  \param[in]  DelayEcho   additional echo delay [us], e.g. of transceiver (only with wire time)
+*/
+void LIN_Master_Sim::setTiming(bool WireTime, uint16_t DelayEcho)
+{
+  // store parameters in class variables
+  this->wireTime  = WireTime;
+  this->delayEcho = LIN_Master_Timebase::usToTicks(DelayEcho);
+
+} // LIN_Master_Sim::setTiming()
+
+
+
+/**
+  \brief      Attach frame table of emulated slaves
+  \details    Attach frame table of emulated slaves with one entry per frame ID. SLAVE_RESPONSE entries respond to
+              their header, MASTER_REQUEST entries store received data. Table is not cleared on attach
+  \param[in]  Table     table with 64 entries for IDs 0x00..0x3F. Must remain valid while attached. NULL = detach
+*/
+void LIN_Master_Sim::attachTable(LIN_Master_Responder::entry_t Table[64])
+{
+  // table must not be used by handler() meanwhile
+  noInterrupts();
+  this->table = Table;
+  interrupts();
+
+} // LIN_Master_Sim::attachTable()
+
+
+
+/**
+  \brief      Set frame of an emulated slave
+  \details    Set frame type, version and data of an ID. Interrupts are disabled for consistency
+  \param[in]  Type      SLAVE_RESPONSE (respond), MASTER_REQUEST (receive data) or other (no slave)
+  \param[in]  Version   LIN protocol version of slave (for checksum)
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \param[in]  NumData   number of data bytes (1..8)
+  \param[in]  Data      response data (NULL = keep data)
+*/
+void LIN_Master_Sim::setFrame(LIN_Master::frame_t Type, LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[])
+{
+  LIN_Master_Responder::entry_t   *pEntry;
+
+  // no table attached or invalid length
+  if ((this->table == NULL) || (NumData > 8))
+    return;
+
+  // update table entry
+  pEntry = this->table + (Id & 0x3F);
+  noInterrupts();
+  pEntry->type    = Type;
+  pEntry->version = Version;
+  pEntry->numData = NumData;
+  if (Data != NULL)
+    memcpy(pEntry->data, Data, NumData);
+  interrupts();
+
+} // LIN_Master_Sim::setFrame()
+
+
+
+/**
+  \brief      Enable fault injection
+  \details    Enable fault injection. For each frame, each enabled fault is injected with the specified probability.
+              Faults which do not apply to a frame, e.g. checksum fault in a master request, are not injected.
+              The same seed gives the same fault sequence
+  \param[in]  Faults    enabled faults, see fault_t (NO_FAULT = disable)
+  \param[in]  Rate      probability of each fault per frame [1/65536]
+  \param[in]  Seed      seed of pseudo-random generator (!=0)
+*/
+void LIN_Master_Sim::setFaults(uint8_t Faults, uint16_t Rate, uint32_t Seed)
+{
+  // store parameters in class variables
+  this->faults    = Faults;
+  this->rateFault = Rate;
+  this->seed      = (Seed != 0) ? Seed : 1;
+  this->numFaults = 0;
+
+} // LIN_Master_Sim::setFaults()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,144 @@
+/**
+  \file     LIN_master_Sim.h
+  \brief    LIN master node emulation over a simulated bus
+  \details  This library provides a LIN master backend without hardware, e.g. for exercising the frame engine,
+            scheduler, queues and timeouts independent of boards, or for measuring the pure CPU overhead of the
+            library. The virtual bus echoes all sent bytes, and emulated slaves respond according to a frame table
+            indexed by frame ID (same format as LIN_Master_Responder). Faults are injected with a configurable
+            probability via a seeded pseudo-random generator, i.e. runs are reproducible.
+            Timing:
+              - instant (default): echo and response are available directly. A missing response byte is reported
+                as ERROR_TIMEOUT without waiting, i.e. millions of frames are simulated within seconds
+              - wire time: bytes become available after the echo delay plus their duration at the set baudrate.
+                Timeouts are detected via the regular frame timeout
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_SIM_H_
+#define _LIN_MASTER_SIM_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <Arduino.h>
+#include "LIN_master.h"
+#include "LIN_master_Responder.h"
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  LIN master node class over a simulated bus
+
+  \details LIN master node class over a simulated bus with emulated slaves and fault injection.
+*/
+class LIN_Master_Sim : public LIN_Master
+{
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// injected faults. Use bitmasks, as faults can be combined
+    typedef enum
+    {
+      NO_FAULT        = 0x00,                     //!< no fault
+      FAULT_ECHO      = 0x01,                     //!< corrupt echo of PID -> ERROR_ECHO
+      FAULT_CHK       = 0x02,                     //!< corrupt checksum of slave response -> ERROR_CHK
+      FAULT_TIMEOUT   = 0x04,                     //!< slave does not respond -> ERROR_TIMEOUT
+      FAULT_SHORT     = 0x08                      //!< slave response lacks last byte -> ERROR_TIMEOUT
+    } fault_t;
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    // virtual bus
+    uint8_t               bus[12];                //!< bytes on bus: echo of sent bytes, followed by slave response
+    uint8_t               lenBus;                 //!< number of bytes on bus
+    uint8_t               posBus;                 //!< number of bytes already read by master
+    uint32_t              timeBus;                //!< time [ticks] when bytes were put on bus
+    uint32_t              timeByteBus;            //!< duration [ticks] of a byte on bus (BREAK: double)
+    bool                  wireTime;               //!< bytes are available after their wire time (false = instant)
+    uint32_t              delayEcho;              //!< additional delay [ticks] of echo, e.g. transceiver
+
+    // emulated slaves
+    LIN_Master_Responder::entry_t *table;         //!< frame table with 64 entries indexed by ID (NULL = no slaves)
+
+    // fault injection
+    uint8_t               faults;                 //!< enabled faults, see fault_t
+    uint16_t              rateFault;              //!< probability of each enabled fault per frame [1/65536]
+    uint32_t              seed;                   //!< state of pseudo-random generator (xorshift32)
+    uint8_t               faultFrame;             //!< faults injected into current frame
+    uint32_t              numFaults;              //!< number of frames with injected fault
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Getter for next pseudo-random number
+    inline uint32_t _random(void)
+      { this->seed ^= this->seed << 13; this->seed ^= this->seed >> 17; this->seed ^= this->seed << 5; return this->seed; }
+
+    /// @brief Put bytes on virtual bus
+    void _putBus(const uint8_t Data[], uint8_t Len, uint32_t TimeByte);
+
+    /// @brief Read next byte from virtual bus, if already available
+    bool _readBus(uint8_t &Byte);
+
+    /// @brief Append response of emulated slave to virtual bus
+    void _respond(void);
+
+    /// @brief Send LIN break
+    LIN_Master::state_t _sendBreak(void);
+
+    /// @brief Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+    LIN_Master::state_t _sendFrame(void);
+
+    /// @brief Read and check LIN frame
+    LIN_Master::state_t _receiveFrame(void);
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_Sim(const char NameLIN[]);
+
+    /// @brief Open virtual bus
+    void begin(uint16_t Baudrate);
+
+    /// @brief Close virtual bus
+    void end(void);
+
+    /// @brief Set bus timing. Default: instant
+    void setTiming(bool WireTime, uint16_t DelayEcho = 0);
+
+    /// @brief Attach frame table of emulated slaves (64 entries indexed by ID, NULL = no slaves)
+    void attachTable(LIN_Master_Responder::entry_t Table[64]);
+
+    /// @brief Set frame of an emulated slave
+    void setFrame(LIN_Master::frame_t Type, LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[] = NULL);
+
+    /// @brief Enable fault injection with probability Rate/65536 per fault and frame (NO_FAULT = disable)
+    void setFaults(uint8_t Faults, uint16_t Rate, uint32_t Seed = 1);
+
+    /// @brief Getter for number of frames with injected fault
+    inline uint32_t getNumFaults(void) { return this->numFaults; }
+
+    /// @brief Clear number of frames with injected fault
+    inline void resetNumFaults(void) { this->numFaults = 0; }
+
+}; // class LIN_Master_Sim
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_SIM_H_
@@ -148,7 +148,7 @@ LIN_Master::state_t LIN_Master_SoftwareSerial::_receiveFrame(void)
     else
     {
       // check for timeout
-      if (micros() - this->timeStart > this->timeMax)
+      if (this->_checkTimeout())
       {
         this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_TIMEOUT);
         this->state = LIN_Master::STATE_DONE;
@@ -165,6 +165,70 @@ LIN_Master::state_t LIN_Master_SoftwareSerial::_receiveFrame(void)
 
 
 
+/**
+  \brief      Send wake-up pulse
+  \details    Send wake-up pulse (250us..5ms low) for waking up slaves from sleep mode
+*/
+void LIN_Master_SoftwareSerial::_sendWakeup(void)
+{
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master_SoftwareSerial::_sendWakeup()");
+  #endif
+
+  // generate wake-up pulse directly via GPIO
+  digitalWrite(pinTx, LOW);
+  delayMicroseconds(LIN_WAKEUP_PULSE);
+  digitalWrite(pinTx, HIGH);
+
+} // LIN_Master_SoftwareSerial::_sendWakeup()
+
+
+
+/**
+  \brief      Check for wake-up pulse from a slave
+  \details    Check for wake-up pulse from a slave while in sleep mode. The pulse is received as byte (typically 0x00
+              or 0x80 with framing error), i.e. any received byte indicates a wake-up
+  \return     true if a wake-up pulse was received
+*/
+bool LIN_Master_SoftwareSerial::_receiveWakeup(void)
+{
+  // no byte received -> no wake-up
+  if (!this->pSerial->available())
+    return false;
+
+  // discard received bytes
+  while (this->pSerial->available())
+    this->pSerial->read();
+
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 1)
+    LIN_DEBUG_SERIAL.println("LIN_Master_SoftwareSerial::_receiveWakeup(): wake-up received");
+  #endif
+
+  // wake-up pulse detected
+  return true;
+
+} // LIN_Master_SoftwareSerial::_receiveWakeup()
+
+
+
+/**
+  \brief      Apply changed baudrate to software UART
+  \details    Apply changed baudrate to software UART and calculate duration of BREAK
+*/
+void LIN_Master_SoftwareSerial::_setBaudrate(void)
+{
+  // calculate duration of BREAK
+  this->durationBreak = LIN_Master_Timebase::ticksToUs(this->timePerByte) * 13 / 10;
+
+  // set bit timing of software UART
+  this->pSerial->begin(this->baudrate);
+
+} // LIN_Master_SoftwareSerial::_setBaudrate()
+
+
+
 /**
   \brief      Constructor for LIN node class using SoftwareSerial
   \details    Constructor for LIN node class for using SoftwareSerial. Store pointers to SW serial instance.
@@ -197,11 +261,8 @@ void LIN_Master_SoftwareSerial::begin(uint16_t Baudrate)
   // call base class method
   LIN_Master::begin(Baudrate);
   
-  // calculate duration of BREAK
-  this->durationBreak = this->timePerByte * 13 / 10;
-  
-  // open serial interface
-  this->pSerial->begin(this->baudrate);
+  // open serial interface and calculate duration of BREAK
+  this->_setBaudrate();
   while(!(*(this->pSerial)));
 
 } // LIN_Master_SoftwareSerial::begin()
@@ -58,6 +58,15 @@ class LIN_Master_SoftwareSerial : public LIN_Master
     /// @brief Read and check LIN frame
     LIN_Master::state_t _receiveFrame(void);
 
+    /// @brief Send wake-up pulse
+    void _sendWakeup(void);
+
+    /// @brief Check for wake-up pulse from a slave
+    bool _receiveWakeup(void);
+
+    /// @brief Apply changed baudrate to software UART and BREAK duration
+    void _setBaudrate(void);
+
 
   // PUBLIC METHODS
   public:
@@ -0,0 +1,497 @@
+/**
+  \file     LIN_master_SoftwareSerial_Timer.cpp
+  \brief    LIN master emulation library for a timer driven software UART (AVR only)
+  \details  This library provides a master node emulation for a LIN bus via a software UART, which is clocked by
+            a timer compare interrupt. BREAK, header and frame body are sent and received from the ISR, i.e.
+            in contrast to LIN_Master_SoftwareSerial the main loop is not blocked during a frame.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \note     Used timer: ATtiny25/45/85 Timer1, ATmega Timer2 (i.e. tone() and PWM on the respective pins are not available)
+  \note     The timer runs at 3x baudrate for Rx sampling. At 8MHz CPU clock a baudrate of <=9600 is recommended
+  \note     Only one instance is supported, as the timer ISR serves one LIN node
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "Arduino.h"
+#include "LIN_master_SoftwareSerial_Timer.h"
+
+// assert AVR platform with supported timer (see header)
+#if defined(LIN_TIMER_TINY_T1) || defined(LIN_TIMER_MEGA_T2)
+
+
+/**************************
+ * STATIC VARIABLES
+**************************/
+
+LIN_Master_SoftwareSerial_Timer *LIN_Master_SoftwareSerial_Timer::pInstance = NULL;
+
+
+/**************************
+ * TIMER ISR
+**************************/
+
+/**
+  \brief      Timer compare ISR
+  \details    Timer compare ISR at 3x baudrate. Calls bit engine of LIN node
+*/
+#if defined(LIN_TIMER_TINY_T1)
+  ISR(TIMER1_COMPA_vect)
+#else
+  ISR(TIMER2_COMPA_vect)
+#endif
+{
+  LIN_Master_SoftwareSerial_Timer   *pLIN = LIN_Master_SoftwareSerial_Timer::getInstance();
+
+  if (pLIN != NULL)
+    pLIN->_tick();
+
+} // ISR()
+
+
+
+/**************************
+ * PROTECTED METHODS
+**************************/
+
+/**
+  \brief      Start timer with 3x baudrate
+  \details    Start timer in CTC mode with 3x baudrate and enable compare interrupt
+*/
+void LIN_Master_SoftwareSerial_Timer::_startTimer(void)
+{
+  #if defined(LIN_TIMER_TINY_T1)
+    TCCR1  = 0;                                               // stop timer
+    TCNT1  = 0;
+    OCR1A  = this->timerCompare;                              // interrupt at compare match
+    OCR1C  = this->timerCompare;                              // clear counter at compare match
+    TIFR   = (1 << OCF1A);                                    // clear pending interrupt
+    TIMSK |= (1 << OCIE1A);                                   // enable compare interrupt
+    TCCR1  = (1 << CTC1) | this->timerPrescaler;              // start timer in CTC mode
+  #else
+    TCCR2B  = 0;                                              // stop timer
+    TCCR2A  = (1 << WGM21);                                   // CTC mode
+    TCNT2   = 0;
+    OCR2A   = this->timerCompare;                             // clear counter and interrupt at compare match
+    TIFR2   = (1 << OCF2A);                                   // clear pending interrupt
+    TIMSK2 |= (1 << OCIE2A);                                  // enable compare interrupt
+    TCCR2B  = this->timerPrescaler;                           // start timer
+  #endif
+
+} // LIN_Master_SoftwareSerial_Timer::_startTimer()
+
+
+
+/**
+  \brief      Stop timer
+  \details    Stop timer and disable compare interrupt
+*/
+void LIN_Master_SoftwareSerial_Timer::_stopTimer(void)
+{
+  #if defined(LIN_TIMER_TINY_T1)
+    TCCR1  = 0;
+    TIMSK &= ~(1 << OCIE1A);
+  #else
+    TCCR2B  = 0;
+    TIMSK2 &= ~(1 << OCIE2A);
+  #endif
+
+} // LIN_Master_SoftwareSerial_Timer::_stopTimer()
+
+
+
+/**
+  \brief      Send LIN break
+  \details    Send LIN break (=13bit low). Tx is set low here, end of BREAK is timed by ISR
+  \return     current state of LIN state machine
+*/
+LIN_Master::state_t LIN_Master_SoftwareSerial_Timer::_sendBreak(void)
+{
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master_SoftwareSerial_Timer::_sendBreak()");
+  #endif
+
+  // if state is wrong, exit immediately
+  if (this->state != LIN_Master::STATE_IDLE)
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_STATE);
+    this->state = LIN_Master::STATE_DONE;
+    return this->state;
+  }
+
+  // init bit engine
+  this->tick  = 0;
+  this->bit   = 0;
+  this->idx   = 0;
+  this->shift = 0;
+  this->phase = LIN_Master_SoftwareSerial_Timer::PHASE_BREAK;
+
+  // start BREAK and timer
+  noInterrupts();
+  *(this->regTx) &= ~(this->maskTx);
+  this->_startTimer();
+  interrupts();
+
+  // progress state
+  this->state = LIN_Master::STATE_BREAK;
+
+  // return state
+  return this->state;
+
+} // LIN_Master_SoftwareSerial_Timer::_sendBreak()
+
+
+
+/**
+  \brief      Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+  \details    Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID). Bytes are sent by ISR,
+              here only wait for end of BREAK
+  \return     current state of LIN state machine
+*/
+LIN_Master::state_t LIN_Master_SoftwareSerial_Timer::_sendFrame(void)
+{
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master_SoftwareSerial_Timer::_sendFrame()");
+  #endif
+
+  // if state is wrong, exit immediately
+  if (this->state != LIN_Master::STATE_BREAK)
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_STATE);
+    this->state = LIN_Master::STATE_DONE;
+    return this->state;
+  }
+
+  // BREAK and delimiter finished -> ISR sends rest of frame
+  if (this->phase >= LIN_Master_SoftwareSerial_Timer::PHASE_SEND)
+  {
+    // progress state
+    this->state = LIN_Master::STATE_BODY;
+
+  } // BREAK finished
+
+  // BREAK ongoing
+  else
+  {
+    // check for timeout
+    if (this->_checkTimeout())
+    {
+      this->_stopTimer();
+      *(this->regTx) |= this->maskTx;
+      this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_TIMEOUT);
+      this->state = LIN_Master::STATE_DONE;
+    }
+
+  } // BREAK ongoing
+
+  // return state
+  return this->state;
+
+} // LIN_Master_SoftwareSerial_Timer::_sendFrame()
+
+
+
+/**
+  \brief      Receive and check LIN frame
+  \details    Receive and check LIN frame (request frame: check echo; response frame: check header echo & checksum).
+              Bytes are received by ISR, here only wait for end of frame
+  \return     current state of LIN state machine
+*/
+LIN_Master::state_t LIN_Master_SoftwareSerial_Timer::_receiveFrame(void)
+{
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master_SoftwareSerial_Timer::_receiveFrame()");
+  #endif
+
+  // if state is wrong, exit immediately
+  if (this->state != LIN_Master::STATE_BODY)
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_STATE);
+    this->state = LIN_Master::STATE_DONE;
+    return this->state;
+  }
+
+  // frame finished by ISR
+  if (this->phase == LIN_Master_SoftwareSerial_Timer::PHASE_DONE)
+  {
+    // check frame for errors
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) this->_checkFrame());
+
+    // progress state
+    this->state = LIN_Master::STATE_DONE;
+
+  } // frame finished
+
+  // frame not yet finished
+  else
+  {
+    // check for timeout
+    if (this->_checkTimeout())
+    {
+      this->_stopTimer();
+      *(this->regTx) |= this->maskTx;
+      this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_TIMEOUT);
+      this->state = LIN_Master::STATE_DONE;
+    }
+
+  } // frame not yet finished
+
+  // return state
+  return this->state;
+
+} // LIN_Master_SoftwareSerial_Timer::_receiveFrame()
+
+
+
+/**
+  \brief      Calculate timer settings for 3x baudrate
+  \details    Calculate timer compare value and prescaler for 3x baudrate. Is applied when the timer is started for
+              the next frame
+*/
+void LIN_Master_SoftwareSerial_Timer::_setBaudrate(void)
+{
+  uint32_t    ticks;
+  uint8_t     cs;
+
+  // CPU clocks per timer tick (=1/3 bit)
+  ticks = (F_CPU + (3L * (uint32_t) this->baudrate) / 2) / (3L * (uint32_t) this->baudrate);
+
+  // find smallest prescaler with compare value <=256
+  #if defined(LIN_TIMER_TINY_T1)
+    // Timer1 of ATtinyX5: prescaler 2^(cs-1), cs=1..15
+    for (cs=1; (cs < 15) && (((ticks + (1UL << (cs-1)) / 2) >> (cs-1)) > 256); cs++);
+    this->timerCompare = (uint8_t) (((ticks + (1UL << (cs-1)) / 2) >> (cs-1)) - 1);
+  #else
+    // Timer2 of ATmega: prescaler 1, 8, 32, 64, 128, 256, 1024 for cs=1..7
+    static const uint16_t   prescaler[] PROGMEM = {1, 8, 32, 64, 128, 256, 1024};
+    uint16_t                div;
+    for (cs=1; cs < 7; cs++)
+    {
+      div = pgm_read_word(&(prescaler[cs-1]));
+      if (((ticks + div / 2) / div) <= 256)
+        break;
+    }
+    div = pgm_read_word(&(prescaler[cs-1]));
+    this->timerCompare = (uint8_t) (((ticks + div / 2) / div) - 1);
+  #endif
+  this->timerPrescaler = cs;
+
+} // LIN_Master_SoftwareSerial_Timer::_setBaudrate()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor for LIN node class using timer driven software UART
+  \details    Constructor for LIN node class using timer driven software UART. Store pins.
+  \param[in]  PinRx         GPIO used for reception
+  \param[in]  PinTx         GPIO used for transmission
+  \param[in]  NameLIN       LIN node name
+*/
+LIN_Master_SoftwareSerial_Timer::LIN_Master_SoftwareSerial_Timer(uint8_t PinRx, uint8_t PinTx, const char NameLIN[]) : LIN_Master::LIN_Master(NameLIN)
+{
+  // store pins used for software UART
+  this->pinRx = PinRx;
+  this->pinTx = PinTx;
+
+  // direct port access for speed. Pins are configured in begin()
+  this->regRx  = portInputRegister(digitalPinToPort(PinRx));
+  this->maskRx = digitalPinToBitMask(PinRx);
+  this->regTx  = portOutputRegister(digitalPinToPort(PinTx));
+  this->maskTx = digitalPinToBitMask(PinTx);
+
+  // init bit engine
+  this->timerCompare   = 0;
+  this->timerPrescaler = 0;
+  this->phase          = LIN_Master_SoftwareSerial_Timer::PHASE_DONE;
+  this->tick           = 0;
+  this->bit            = 0;
+  this->idx            = 0;
+  this->shift          = 0;
+
+} // LIN_Master_SoftwareSerial_Timer::LIN_Master_SoftwareSerial_Timer()
+
+
+
+/**
+  \brief      Open software UART
+  \details    Open software UART with specified baudrate. Configure pins and calculate timer settings for 3x baudrate
+  \param[in]  Baudrate    communication speed [Baud]
+*/
+void LIN_Master_SoftwareSerial_Timer::begin(uint16_t Baudrate)
+{
+  // call base class method
+  LIN_Master::begin(Baudrate);
+
+  // configure pins. Tx idle is high
+  digitalWrite(this->pinTx, HIGH);
+  pinMode(this->pinTx, OUTPUT);
+  pinMode(this->pinRx, INPUT_PULLUP);
+
+  // calculate timer settings for 3x baudrate
+  this->_setBaudrate();
+
+  // timer ISR serves this node
+  this->phase = LIN_Master_SoftwareSerial_Timer::PHASE_DONE;
+  LIN_Master_SoftwareSerial_Timer::pInstance = this;
+
+} // LIN_Master_SoftwareSerial_Timer::begin()
+
+
+
+/**
+  \brief      Close software UART
+  \details    Stop timer and release ISR
+*/
+void LIN_Master_SoftwareSerial_Timer::end()
+{
+  // call base class method
+  LIN_Master::end();
+
+  // stop timer and set Tx to idle
+  noInterrupts();
+  this->_stopTimer();
+  *(this->regTx) |= this->maskTx;
+  if (LIN_Master_SoftwareSerial_Timer::pInstance == this)
+    LIN_Master_SoftwareSerial_Timer::pInstance = NULL;
+  interrupts();
+
+} // LIN_Master_SoftwareSerial_Timer::end()
+
+
+
+/**
+  \brief      Bit engine, called from timer ISR
+  \details    Bit engine, called from timer ISR every 1/3 bit. Sends BREAK and bytes, samples echo in 3rd tick of each
+              bit and receives slave response. Start bit is detected within 1/3 bit, data bits are then sampled
+              between 1/3 and 2/3 of bit time.
+*/
+void LIN_Master_SoftwareSerial_Timer::_tick(void)
+{
+  switch (this->phase)
+  {
+    // BREAK: 13 bit low. Sample echo in bit 5
+    case LIN_Master_SoftwareSerial_Timer::PHASE_BREAK:
+      if (++(this->tick) == 15)
+        this->bufRx[0] = (*(this->regRx) & this->maskRx) ? 0xFF : 0x00;
+      else if (this->tick >= 39)
+      {
+        *(this->regTx) |= this->maskTx;
+        this->tick  = 0;
+        this->phase = LIN_Master_SoftwareSerial_Timer::PHASE_DELIMITER;
+      }
+      break;
+
+    // BREAK delimiter: 1 bit high (3rd tick is start of 1st byte)
+    case LIN_Master_SoftwareSerial_Timer::PHASE_DELIMITER:
+      if (++(this->tick) >= 2)
+      {
+        this->tick  = 0;
+        this->bit   = 0;
+        this->idx   = 1;
+        this->phase = LIN_Master_SoftwareSerial_Timer::PHASE_SEND;
+      }
+      break;
+
+    // send bytes. Set Tx in 1st tick, sample echo in 3rd tick of bit
+    case LIN_Master_SoftwareSerial_Timer::PHASE_SEND:
+      if (this->tick == 0)
+      {
+        uint8_t level = (this->bit == 0) ? 0 : ((this->bit == 9) ? 1 : ((this->bufTx[this->idx] >> (this->bit - 1)) & 0x01));
+        if (level)
+          *(this->regTx) |= this->maskTx;
+        else
+          *(this->regTx) &= ~(this->maskTx);
+      }
+      else if (this->tick == 2)
+      {
+        if ((this->bit >= 1) && (this->bit <= 8) && (*(this->regRx) & this->maskRx))
+          this->shift |= (1 << (this->bit - 1));
+        else if (this->bit == 9)
+          this->bufRx[this->idx] = this->shift;
+      }
+      if (++(this->tick) >= 3)
+      {
+        this->tick = 0;
+        if (++(this->bit) >= 10)
+        {
+          this->bit   = 0;
+          this->shift = 0;
+          if (++(this->idx) >= this->lenTx)
+          {
+            if (this->idx >= this->lenRx)
+            {
+              this->_stopTimer();
+              this->phase = LIN_Master_SoftwareSerial_Timer::PHASE_DONE;
+            }
+            else
+              this->phase = LIN_Master_SoftwareSerial_Timer::PHASE_HUNT;
+          }
+        }
+      }
+      break;
+
+    // wait for start bit of slave response
+    case LIN_Master_SoftwareSerial_Timer::PHASE_HUNT:
+      if (!(*(this->regRx) & this->maskRx))
+      {
+        this->tick  = 0;
+        this->bit   = 0;
+        this->shift = 0;
+        this->phase = LIN_Master_SoftwareSerial_Timer::PHASE_RECEIVE;
+      }
+      break;
+
+    // receive byte of slave response. Sample in 2nd tick after bit boundary
+    case LIN_Master_SoftwareSerial_Timer::PHASE_RECEIVE:
+      if (++(this->tick) >= 3)
+      {
+        this->tick = 0;
+        this->bit++;
+      }
+      if (this->tick == 1)
+      {
+        uint8_t level = *(this->regRx) & this->maskRx;
+
+        // start bit glitch -> wait for next start bit
+        if ((this->bit == 0) && (level))
+          this->phase = LIN_Master_SoftwareSerial_Timer::PHASE_HUNT;
+
+        // data bit (LSB first)
+        else if ((this->bit >= 1) && (this->bit <= 8) && (level))
+          this->shift |= (1 << (this->bit - 1));
+
+        // stop bit -> store byte
+        else if (this->bit == 9)
+        {
+          this->bufRx[this->idx] = this->shift;
+          if (++(this->idx) >= this->lenRx)
+          {
+            this->_stopTimer();
+            this->phase = LIN_Master_SoftwareSerial_Timer::PHASE_DONE;
+          }
+          else
+            this->phase = LIN_Master_SoftwareSerial_Timer::PHASE_HUNT;
+        }
+      }
+      break;
+
+    // frame finished -> nothing to do
+    default:
+      this->_stopTimer();
+      break;
+
+  } // switch (phase)
+
+} // LIN_Master_SoftwareSerial_Timer::_tick()
+
+#endif // LIN_TIMER_TINY_T1 || LIN_TIMER_MEGA_T2
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
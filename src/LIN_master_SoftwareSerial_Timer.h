@@ -0,0 +1,140 @@
+/**
+  \file     LIN_master_SoftwareSerial_Timer.h
+  \brief    LIN master emulation library for a timer driven software UART (AVR only)
+  \details  This library provides a master node emulation for a LIN bus via a software UART, which is clocked by
+            a timer compare interrupt. BREAK, header and frame body are sent and received from the ISR, i.e.
+            in contrast to LIN_Master_SoftwareSerial the main loop is not blocked during a frame.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \note     Used timer: ATtiny25/45/85 Timer1, ATmega Timer2 (i.e. tone() and PWM on the respective pins are not available)
+  \note     The timer runs at 3x baudrate for Rx sampling. At 8MHz CPU clock a baudrate of <=9600 is recommended
+  \note     Only one instance is supported, as the timer ISR serves one LIN node
+  \author   Georg Icking-Konert
+*/
+
+// assert AVR platform with supported timer
+#if defined(ARDUINO_ARCH_AVR) && (defined(__AVR_ATtiny25__) || defined(__AVR_ATtiny45__) || defined(__AVR_ATtiny85__) || defined(TCCR2A))
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_SW_SERIAL_TIMER_H_
+#define _LIN_MASTER_SW_SERIAL_TIMER_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <Arduino.h>
+#include "LIN_master.h"
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+// select timer
+#if defined(__AVR_ATtiny25__) || defined(__AVR_ATtiny45__) || defined(__AVR_ATtiny85__)
+  #define LIN_TIMER_TINY_T1                 //!< use Timer1 of ATtinyX5
+#else
+  #define LIN_TIMER_MEGA_T2                 //!< use Timer2 of ATmega
+#endif
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  LIN master node class via timer driven software UART
+
+  \details LIN master node class via timer driven software UART (AVR only).
+*/
+class LIN_Master_SoftwareSerial_Timer : public LIN_Master
+{
+  // PROTECTED TYPEDEFS
+  protected:
+
+    /// phase of ISR bit engine
+    typedef enum
+    {
+      PHASE_BREAK         = 0,                //!< Tx low for 13 bit
+      PHASE_DELIMITER     = 1,                //!< Tx high for 1 bit
+      PHASE_SEND          = 2,                //!< send bytes and sample echo
+      PHASE_HUNT          = 3,                //!< wait for start bit of slave response
+      PHASE_RECEIVE       = 4,                //!< receive byte of slave response
+      PHASE_DONE          = 5                 //!< frame finished, timer stopped
+    } phase_t;
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    uint8_t               pinRx;              //!< pin used for receive
+    uint8_t               pinTx;              //!< pin used for transmit
+    volatile uint8_t      *regRx;             //!< input register of Rx pin
+    uint8_t               maskRx;             //!< bitmask of Rx pin
+    volatile uint8_t      *regTx;             //!< output register of Tx pin
+    uint8_t               maskTx;             //!< bitmask of Tx pin
+    uint8_t               timerCompare;       //!< timer compare value for 1/3 bit
+    uint8_t               timerPrescaler;     //!< timer clock select bits
+
+    // ISR bit engine
+    volatile uint8_t      phase;              //!< current phase of bit engine
+    uint8_t               tick;               //!< timer tick (1/3 bit) within bit or BREAK
+    uint8_t               bit;                //!< bit within byte (0=start, 1..8=data, 9=stop)
+    uint8_t               idx;                //!< index of current byte in bufTx / bufRx
+    uint8_t               shift;              //!< received bits of current byte
+
+    static LIN_Master_SoftwareSerial_Timer *pInstance;  //!< LIN node served by timer ISR
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Start timer with 3x baudrate
+    void _startTimer(void);
+
+    /// @brief Stop timer
+    void _stopTimer(void);
+
+    /// @brief Send LIN break
+    LIN_Master::state_t _sendBreak(void);
+
+    /// @brief Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+    LIN_Master::state_t _sendFrame(void);
+
+    /// @brief Read and check LIN frame
+    LIN_Master::state_t _receiveFrame(void);
+
+    /// @brief Calculate timer settings for 3x baudrate
+    void _setBaudrate(void);
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_SoftwareSerial_Timer(uint8_t PinRx, uint8_t PinTx, const char NameLIN[] = "");
+
+    /// @brief Open software UART
+    void begin(uint16_t Baudrate);
+
+    /// @brief Close software UART
+    void end(void);
+
+    /// @brief Bit engine, called from timer ISR. Not for user code!
+    void _tick(void);
+
+    /// @brief Getter for LIN node served by timer ISR
+    static inline LIN_Master_SoftwareSerial_Timer *getInstance(void) { return pInstance; }
+
+}; // class LIN_Master_SoftwareSerial_Timer
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_SW_SERIAL_TIMER_H_
+
+#endif // ARDUINO_ARCH_AVR && (ATtinyX5 || TCCR2A)
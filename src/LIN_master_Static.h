@@ -0,0 +1,883 @@
+/**
+  \file     LIN_master_Static.h
+  \brief    Compile-time configured LIN master emulation without virtual functions
+  \details  This header provides a LIN master node, which is configured at compile time via CRTP (curiously recurring
+            template pattern) instead of virtual functions. The serial backend, the max. number of data bytes and the
+            feature set are template parameters, i.e. there are no vtables, the hot path is inlined into handler()
+            and unused features cost neither flash nor RAM. State checks are done once in the frame engine, backends
+            only provide the interface primitives. Use this variant on small devices (e.g. ATtiny) which require only
+            the base functionality of LIN_Master. The frame engine is compatible to LIN_Master, i.e. the same types,
+            PID and checksum calculation are used, see LIN_master.h.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \note     Not supported are sleep mode, schedule tables, result queue, trace, adaptive timeouts and per-frame baudrate.
+            For these use the classes derived from LIN_Master.
+            Backends are LIN_Master_Static_HardwareSerial and, for devices without hardware UART like ATtiny85,
+            LIN_Master_Static_SoftwareSerial (AVR and ESP8266 only)
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_STATIC_H_
+#define _LIN_MASTER_STATIC_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <Arduino.h>
+#include "LIN_master.h"
+#include "LIN_master_Timebase.h"
+#if defined(ARDUINO_ARCH_AVR) || defined(ARDUINO_ARCH_ESP8266)
+  #include <SoftwareSerial.h>
+#endif
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+#define LIN_FEATURE_DEBUG     0x01        //!< print frame errors to LIN_DEBUG_SERIAL (if defined, see LIN_master.h)
+#define LIN_FEATURE_STATS     0x02        //!< collect frame timing and error statistics, see getStats()
+
+
+/*-----------------------------------------------------------------------------
+  FEATURE STORAGE
+-----------------------------------------------------------------------------*/
+/**
+  \brief  Storage for frame statistics of LIN_Master_Static
+
+  \details Storage for frame statistics of LIN_Master_Static. The specialization for disabled statistics is empty
+           and its methods are no-ops, i.e. with empty base optimization it costs neither flash nor RAM.
+  \tparam Enable    collect statistics
+*/
+template <bool Enable>
+class LIN_Master_StaticStats
+{
+  // PROTECTED VARIABLES
+  protected:
+
+    LIN_Master::stats_t   stats;                  //!< timing and error statistics. Retries are not counted
+    uint32_t              timeBody;               //!< time [ticks] at end of BREAK
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Clear statistics and start new measurement period
+    inline void _statsReset(void)
+    {
+      memset(&(this->stats), 0, sizeof(this->stats));
+      this->stats.timeBreakMin    = 0xFFFFFFFF;
+      this->stats.timeResponseMin = 0xFFFFFFFF;
+      this->stats.timeReset       = micros();
+      this->timeBody              = 0;
+    }
+
+    /// @brief Getter for time at handler() entry
+    static inline uint32_t _statsEntry(void) { return LIN_Master_Timebase::getTicks(); }
+
+    /// @brief Update statistics at end of BREAK
+    inline void _statsBreak(uint32_t TimeStart)
+    {
+      this->timeBody = LIN_Master_Timebase::getTicks();
+      uint32_t dt = LIN_Master_Timebase::ticksToUs(this->timeBody - TimeStart);
+      this->stats.numBreak++;
+      this->stats.timeBreakSum += dt;
+      if (dt < this->stats.timeBreakMin)
+        this->stats.timeBreakMin = dt;
+      if (dt > this->stats.timeBreakMax)
+        this->stats.timeBreakMax = dt;
+    }
+
+    /// @brief Update statistics at end of frame
+    inline void _statsFrame(uint32_t TimeStart, LIN_Master::error_t Error)
+    {
+      uint32_t timeNow = LIN_Master_Timebase::getTicks();
+      this->stats.numFrames++;
+      this->stats.timeBusy += LIN_Master_Timebase::ticksToUs(timeNow - TimeStart);
+      if (Error != LIN_Master::NO_ERROR)
+      {
+        this->stats.numErrors++;
+        if (Error & LIN_Master::ERROR_ECHO)
+          this->stats.numErrorEcho++;
+        if (Error & LIN_Master::ERROR_TIMEOUT)
+          this->stats.numErrorTimeout++;
+        if (Error & LIN_Master::ERROR_CHK)
+          this->stats.numErrorChk++;
+        if (Error & (LIN_Master::ERROR_STATE | LIN_Master::ERROR_MISC))
+          this->stats.numErrorOther++;
+      }
+      else
+      {
+        uint32_t dt = LIN_Master_Timebase::ticksToUs(timeNow - this->timeBody);
+        this->stats.numResponse++;
+        this->stats.timeResponseSum += dt;
+        if (dt < this->stats.timeResponseMin)
+          this->stats.timeResponseMin = dt;
+        if (dt > this->stats.timeResponseMax)
+          this->stats.timeResponseMax = dt;
+      }
+    }
+
+    /// @brief Update duration of handler()
+    inline void _statsHandler(uint32_t TimeEntry)
+    {
+      uint32_t dt = LIN_Master_Timebase::ticksToUs(LIN_Master_Timebase::getTicks() - TimeEntry);
+      this->stats.numHandler++;
+      this->stats.timeHandlerSum += dt;
+      if (dt > this->stats.timeHandlerMax)
+        this->stats.timeHandlerMax = dt;
+    }
+
+}; // class LIN_Master_StaticStats
+
+
+
+/**
+  \brief  Empty storage for disabled frame statistics
+*/
+template <>
+class LIN_Master_StaticStats<false>
+{
+  // PROTECTED METHODS
+  protected:
+
+    inline void _statsReset(void) { }
+    static inline uint32_t _statsEntry(void) { return 0; }
+    inline void _statsBreak(uint32_t TimeStart) { (void) TimeStart; }
+    inline void _statsFrame(uint32_t TimeStart, LIN_Master::error_t Error) { (void) TimeStart; (void) Error; }
+    inline void _statsHandler(uint32_t TimeEntry) { (void) TimeEntry; }
+
+}; // class LIN_Master_StaticStats<false>
+
+
+
+/**
+  \brief  Storage for job queue of LIN_Master_Static
+
+  \details Lock-free job queue of LIN_Master_Static (single producer: application, single consumer: handler()).
+           The specialization for size 0 is empty, i.e. it costs neither flash nor RAM.
+  \tparam Size      number of queue entries (one entry is kept free)
+  \tparam MaxData   max. number of data bytes per frame
+*/
+template <uint8_t Size, uint8_t MaxData>
+class LIN_Master_StaticQueue
+{
+  // PROTECTED TYPEDEFS
+  protected:
+
+    /// queued frame
+    typedef struct
+    {
+      LIN_Master::frame_t   type;                 //!< frame type
+      LIN_Master::version_t version;              //!< LIN protocol version
+      uint8_t               id;                   //!< frame identifier (protected or unprotected)
+      uint8_t               numData;              //!< number of data bytes
+      uint8_t               data[MaxData];        //!< data bytes for master request
+    } job_t;
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    job_t                 queueJob[Size];         //!< buffer for frames to send
+    volatile uint8_t      headJob;                //!< index of next job to write
+    volatile uint8_t      tailJob;                //!< index of next job to start
+    uint8_t               lostJobs;               //!< number of frames dropped due to full queue (saturated at 255)
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Clear job queue
+    inline void _queueReset(void) { this->headJob = 0; this->tailJob = 0; this->lostJobs = 0; }
+
+    /// @brief Count frame dropped due to full queue
+    inline void _queueLost(void) { if (this->lostJobs < 255) this->lostJobs++; }
+
+    /// @brief Getter for number of dropped frames
+    inline uint8_t _queueGetLost(void) { return this->lostJobs; }
+
+    /// @brief Clear number of dropped frames
+    inline void _queueResetLost(void) { this->lostJobs = 0; }
+
+    /// @brief Check if jobs are pending
+    inline bool _queuePending(void) { return (this->headJob != this->tailJob); }
+
+    /// @brief Getter for number of free entries
+    inline uint8_t _queueFree(void)
+    {
+      uint8_t head = this->headJob;
+      uint8_t tail = this->tailJob;
+      return (uint8_t) ((tail + Size - head - 1) % Size);
+    }
+
+    /// @brief Append frame to job queue. Returns false if queue is full
+    inline bool _queuePush(LIN_Master::frame_t Type, LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[])
+    {
+      uint8_t head = this->headJob;
+      uint8_t next = (uint8_t) ((head + 1) % Size);
+      if ((next == this->tailJob) || (NumData > MaxData))
+        return false;
+      this->queueJob[head].type    = Type;
+      this->queueJob[head].version = Version;
+      this->queueJob[head].id      = Id;
+      this->queueJob[head].numData = NumData;
+      if (Data != NULL)
+        memcpy(this->queueJob[head].data, Data, NumData);
+      LIN_MEMORY_BARRIER();
+      this->headJob = next;
+      return true;
+    }
+
+    /// @brief Getter for oldest job (NULL = queue empty). Release via _queuePop()
+    inline const job_t *_queuePeek(void)
+    {
+      if (this->headJob == this->tailJob)
+        return NULL;
+      LIN_MEMORY_BARRIER();
+      return &(this->queueJob[this->tailJob]);
+    }
+
+    /// @brief Release oldest job
+    inline void _queuePop(void)
+    {
+      LIN_MEMORY_BARRIER();
+      this->tailJob = (uint8_t) ((this->tailJob + 1) % Size);
+    }
+
+}; // class LIN_Master_StaticQueue
+
+
+
+/**
+  \brief  Empty storage for disabled job queue
+*/
+template <uint8_t MaxData>
+class LIN_Master_StaticQueue<0, MaxData>
+{
+  // PROTECTED TYPEDEFS
+  protected:
+
+    /// dummy queued frame
+    typedef struct
+    {
+      LIN_Master::frame_t   type;                 //!< frame type
+      LIN_Master::version_t version;              //!< LIN protocol version
+      uint8_t               id;                   //!< frame identifier
+      uint8_t               numData;              //!< number of data bytes
+      uint8_t               data[MaxData];        //!< data bytes
+    } job_t;
+
+
+  // PROTECTED METHODS
+  protected:
+
+    inline void _queueReset(void) { }
+    inline void _queueLost(void) { }
+    inline uint8_t _queueGetLost(void) { return 0; }
+    inline void _queueResetLost(void) { }
+    inline bool _queuePending(void) { return false; }
+    inline uint8_t _queueFree(void) { return 0; }
+    inline bool _queuePush(LIN_Master::frame_t, LIN_Master::version_t, uint8_t, uint8_t, const uint8_t[]) { return false; }
+    inline const job_t *_queuePeek(void) { return NULL; }
+    inline void _queuePop(void) { }
+
+}; // class LIN_Master_StaticQueue<0>
+
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASSES
+-----------------------------------------------------------------------------*/
+/**
+  \brief  Compile-time configured LIN master node
+
+  \details LIN master frame engine without virtual functions. The backend is passed as derived class (CRTP) and
+           must provide the following inline methods, which are called without state checks:
+             - void _open(uint16_t Baudrate): open interface
+             - void _close(void): close interface
+             - void _startBreak(void): flush buffers and start BREAK
+             - bool _breakDone(void): check if BREAK is finished, i.e. the frame body can be sent
+             - void _write(const uint8_t Data[], uint8_t Num): send bytes
+             - bool _available(void): check for received byte
+             - uint8_t _read(void): read received byte
+           Frames are checked byte-wise against the echo like LIN_Master. A single buffer is used for sent and received
+           bytes, i.e. the RAM usage is MaxData+4 bytes plus the feature storage.
+  \tparam Derived   backend class derived from this class
+  \tparam MaxData   max. number of data bytes per frame (1..8)
+  \tparam Features  feature set, combination of LIN_FEATURE_DEBUG and LIN_FEATURE_STATS (0 = none)
+  \tparam SizeQueue number of job queue entries incl. one free entry (0 = no job queue)
+*/
+template <class Derived, uint8_t MaxData = 8, uint8_t Features = 0, uint8_t SizeQueue = 0>
+class LIN_Master_Static : protected LIN_Master_StaticStats<(Features & LIN_FEATURE_STATS) != 0>,
+  protected LIN_Master_StaticQueue<SizeQueue, MaxData>
+{
+  static_assert((MaxData >= 1) && (MaxData <= 8), "LIN frame must have 1..8 data bytes");
+  static_assert((SizeQueue == 0) || (SizeQueue >= 2), "LIN job queue must have 0 or >=2 entries");
+
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// callback for finished frame. Called from handler() when STATE_DONE is reached
+    typedef void (*callback_t)(Derived &LIN);
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    uint16_t              baudrate;               //!< communication baudrate [Baud]
+    LIN_Master::state_t   state;                  //!< status of LIN state machine
+    LIN_Master::error_t   error;                  //!< error state. Is latched until cleared
+    uint32_t              timePerByte;            //!< time [ticks] per byte at specified baudrate, see LIN_Master_Timebase
+    uint32_t              timeStart;              //!< starting time [ticks] for frame timeout
+    uint32_t              timeMax;                //!< max. frame duration [ticks]
+    callback_t            callback;               //!< user function called when frame is finished (NULL = none)
+
+    // frame properties
+    LIN_Master::version_t version;                //!< LIN protocol version
+    LIN_Master::frame_t   type;                   //!< LIN frame type
+    uint8_t               id;                     //!< LIN frame identifier (protected or unprotected)
+    uint8_t               lenTx;                  //!< number of sent bytes incl. BREAK
+    uint8_t               lenRx;                  //!< number of received bytes incl. BREAK
+    uint8_t               numRx;                  //!< number of bytes already received
+    uint8_t               buf[MaxData+4];         //!< sent and received bytes incl. BREAK, SYNC, PID, DATA and CHK
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Getter for backend (CRTP)
+    inline Derived &_backend(void) { return *static_cast<Derived*>(this); }
+
+    /// @brief Set error and finish frame
+    inline void _abort(LIN_Master::error_t Error)
+    {
+      this->error = (LIN_Master::error_t) ((int) this->error | (int) Error);
+      this->state = LIN_Master::STATE_DONE;
+    }
+
+    /// @brief Start a frame. Slave response data is received into buf, master request data must already be in buf
+    inline LIN_Master::state_t _startFrame(LIN_Master::frame_t Type, LIN_Master::version_t Version, uint8_t Id, uint8_t NumData)
+    {
+      // invalid state or length -> abort frame
+      if ((this->state != LIN_Master::STATE_IDLE) || (NumData > MaxData))
+      {
+        this->_abort(LIN_Master::ERROR_STATE);
+        this->_frameDone();
+        return this->state;
+      }
+
+      // with job queue, error is reported per frame -> clear latched error
+      if (SizeQueue > 0)
+        this->error = LIN_Master::NO_ERROR;
+
+      // construct header. Master request: DATA[] is already in buffer
+      this->type    = Type;
+      this->version = Version;
+      this->id      = Id;
+      this->buf[0]  = 0x00;                                         // BREAK
+      this->buf[1]  = 0x55;                                         // SYNC
+      this->buf[2]  = LIN_Master::calculatePID(Id);                 // PID
+      this->lenRx   = NumData + 4;
+      if (Type == LIN_Master::MASTER_REQUEST)
+      {
+        this->buf[NumData+3] = LIN_Master::calculateChecksum(Version, Id, NumData, this->buf+3);
+        this->lenTx = this->lenRx;                                  // just receive LIN echo
+      }
+      else
+        this->lenTx = 3;                                            // send header, receive DATA[] and CHK
+      this->numRx = 0;
+
+      // set frame timeout (= 150% nominal) and start BREAK
+      this->timeStart = LIN_Master_Timebase::getTicks();
+      this->timeMax   = (((this->lenRx + 1) * this->timePerByte) * 3) >> 1;
+      this->_backend()._startBreak();
+      this->state     = LIN_Master::STATE_BREAK;
+      return this->state;
+    }
+
+    /// @brief Append frame to job queue if bus is busy. Returns false if frame can be started directly
+    inline bool _deferFrame(LIN_Master::frame_t Type, LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[])
+    {
+      // no job queue, or bus idle and no older frames pending -> start directly
+      if ((SizeQueue == 0) || ((this->state == LIN_Master::STATE_IDLE) && (!this->_queuePending())))
+        return false;
+
+      // append to job queue. Queue full -> drop frame, don't touch ongoing frame
+      if (!this->_queuePush(Type, Version, Id, NumData, Data))
+        this->_queueLost();
+      return true;
+    }
+
+    /// @brief Start oldest frame from job queue
+    inline void _startJob(void)
+    {
+      const typename LIN_Master_StaticQueue<SizeQueue, MaxData>::job_t *pJob = this->_queuePeek();
+      if (pJob == NULL)
+        return;
+      if (pJob->type == LIN_Master::MASTER_REQUEST)
+        memcpy(this->buf+3, pJob->data, pJob->numData);
+      this->_startFrame(pJob->type, pJob->version, pJob->id, pJob->numData);
+      this->_queuePop();
+    }
+
+    /// @brief Frame finished, update statistics and notify user
+    inline void _frameDone(void)
+    {
+      this->_statsFrame(this->timeStart, this->error);
+      #if defined(LIN_DEBUG_SERIAL)
+        if ((Features & LIN_FEATURE_DEBUG) && (this->error != LIN_Master::NO_ERROR))
+        {
+          LIN_DEBUG_SERIAL.print("LIN_Master_Static: ID 0x");
+          LIN_DEBUG_SERIAL.print((int) (this->id & 0x3F), HEX);
+          LIN_DEBUG_SERIAL.print(", error 0x");
+          LIN_DEBUG_SERIAL.println((int) this->error, HEX);
+        }
+      #endif
+      if (this->callback != NULL)
+        this->callback(this->_backend());
+
+      // with job queue, release state machine for next frame
+      if ((SizeQueue > 0) && (this->state == LIN_Master::STATE_DONE))
+        this->state = LIN_Master::STATE_IDLE;
+    }
+
+    /// @brief Finish ongoing and queued frames
+    inline void _flushJobs(void)
+    {
+      while ((this->state == LIN_Master::STATE_BREAK) || (this->state == LIN_Master::STATE_BODY) || this->_queuePending())
+        this->handler();
+    }
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_Static(void)
+    {
+      this->baudrate    = 0;
+      this->state       = LIN_Master::STATE_OFF;
+      this->error       = LIN_Master::NO_ERROR;
+      this->timePerByte = 0;
+      this->timeStart   = 0;
+      this->timeMax     = 0;
+      this->callback    = NULL;
+      this->version     = LIN_Master::LIN_V2;
+      this->type        = LIN_Master::MASTER_REQUEST;
+      this->id          = 0;
+      this->lenTx       = 4;
+      this->lenRx       = 4;
+      this->numRx       = 0;
+      memset(this->buf, 0, sizeof(this->buf));
+      this->_statsReset();
+      this->_queueReset();
+    }
+
+    /// @brief Open serial interface
+    inline void begin(uint16_t Baudrate)
+    {
+      this->baudrate    = Baudrate;
+      this->timePerByte = LIN_Master_Timebase::usToTicks(10000000L / (uint32_t) Baudrate);
+      LIN_Master_Timebase::begin();
+      this->_backend()._open(Baudrate);
+      this->error       = LIN_Master::NO_ERROR;
+      this->state       = LIN_Master::STATE_IDLE;
+    }
+
+    /// @brief Close serial interface
+    inline void end(void)
+    {
+      this->_backend()._close();
+      this->state = LIN_Master::STATE_OFF;
+    }
+
+
+    /// @brief Reset LIN state machine
+    inline void resetStateMachine(void) { this->state = LIN_Master::STATE_IDLE; }
+
+    /// @brief Getter for LIN state machine state
+    inline LIN_Master::state_t getState(void) { return this->state; }
+
+    /// @brief Clear error of LIN state machine
+    inline void resetError(void) { this->error = LIN_Master::NO_ERROR; }
+
+    /// @brief Getter for LIN state machine error
+    inline LIN_Master::error_t getError(void) { return this->error; }
+
+    /// @brief Attach callback for finished frames (NULL = detach)
+    inline void attachCallback(callback_t Callback) { this->callback = Callback; }
+
+
+    /// @brief Getter for LIN frame. Call in STATE_DONE or from callback
+    inline void getFrame(LIN_Master::frame_t &Type, uint8_t &Id, uint8_t &NumData, uint8_t Data[])
+    {
+      Type    = this->type;
+      Id      = this->id;
+      NumData = this->lenRx - 4;
+      memcpy(Data, this->buf+3, NumData);
+    }
+
+
+    /// @brief Start sending a LIN master request frame in background. With job queue and bus busy the frame is queued, or dropped if the queue is full
+    inline LIN_Master::state_t sendMasterRequest(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[])
+    {
+      if (this->_deferFrame(LIN_Master::MASTER_REQUEST, Version, Id, NumData, Data))
+        return this->state;
+      if ((this->state == LIN_Master::STATE_IDLE) && (NumData <= MaxData))
+        memcpy(this->buf+3, Data, NumData);
+      return this->_startFrame(LIN_Master::MASTER_REQUEST, Version, Id, NumData);
+    }
+
+    /// @brief Start a LIN slave response frame in background. With job queue and bus busy the frame is queued, or dropped if the queue is full
+    inline LIN_Master::state_t receiveSlaveResponse(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData)
+    {
+      if (this->_deferFrame(LIN_Master::SLAVE_RESPONSE, Version, Id, NumData, NULL))
+        return this->state;
+      return this->_startFrame(LIN_Master::SLAVE_RESPONSE, Version, Id, NumData);
+    }
+
+    /// @brief Send a blocking LIN master request frame
+    LIN_Master::error_t sendMasterRequestBlocking(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[])
+    {
+      this->_flushJobs();
+      if (NumData <= MaxData)
+        memcpy(this->buf+3, Data, NumData);
+      this->_startFrame(LIN_Master::MASTER_REQUEST, Version, Id, NumData);
+      while ((this->state == LIN_Master::STATE_BREAK) || (this->state == LIN_Master::STATE_BODY))
+        this->handler();
+      return this->error;
+    }
+
+    /// @brief Send a blocking LIN slave response frame
+    LIN_Master::error_t receiveSlaveResponseBlocking(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, uint8_t Data[])
+    {
+      this->_flushJobs();
+      this->_startFrame(LIN_Master::SLAVE_RESPONSE, Version, Id, NumData);
+      while ((this->state == LIN_Master::STATE_BREAK) || (this->state == LIN_Master::STATE_BODY))
+        this->handler();
+      if (NumData <= MaxData)
+        memcpy(Data, this->buf+3, NumData);
+      return this->error;
+    }
+
+
+    /// @brief Append a master request frame to job queue (only with job queue)
+    inline bool queueMasterRequest(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[])
+    {
+      static_assert(SizeQueue > 0, "LIN_Master_Static has no job queue");
+      return (this->_queuePush(LIN_Master::MASTER_REQUEST, Version, Id, NumData, Data));
+    }
+
+    /// @brief Append a slave response frame to job queue (only with job queue)
+    inline bool queueSlaveResponse(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData)
+    {
+      static_assert(SizeQueue > 0, "LIN_Master_Static has no job queue");
+      return (this->_queuePush(LIN_Master::SLAVE_RESPONSE, Version, Id, NumData, NULL));
+    }
+
+    /// @brief Getter for number of free job queue entries (only with job queue)
+    inline uint8_t freeJobs(void)
+    {
+      static_assert(SizeQueue > 0, "LIN_Master_Static has no job queue");
+      return this->_queueFree();
+    }
+
+    /// @brief Getter for number of frames dropped due to full job queue, saturated at 255 (only with job queue)
+    inline uint8_t getLostJobs(void)
+    {
+      static_assert(SizeQueue > 0, "LIN_Master_Static has no job queue");
+      return this->_queueGetLost();
+    }
+
+    /// @brief Clear number of dropped frames (only with job queue)
+    inline void resetLostJobs(void)
+    {
+      static_assert(SizeQueue > 0, "LIN_Master_Static has no job queue");
+      this->_queueResetLost();
+    }
+
+
+    /// @brief Getter for copy of frame statistics (only with LIN_FEATURE_STATS)
+    inline void getStats(LIN_Master::stats_t &Stats)
+    {
+      static_assert((Features & LIN_FEATURE_STATS) != 0, "LIN_Master_Static has no statistics");
+      noInterrupts();
+      Stats = this->stats;
+      interrupts();
+    }
+
+    /// @brief Reset frame statistics (only with LIN_FEATURE_STATS)
+    inline void resetStats(void)
+    {
+      static_assert((Features & LIN_FEATURE_STATS) != 0, "LIN_Master_Static has no statistics");
+      noInterrupts();
+      this->_statsReset();
+      interrupts();
+    }
+
+
+    /// @brief Handle LIN background operation (call until STATE_DONE is returned)
+    LIN_Master::state_t handler(void)
+    {
+      LIN_Master::state_t   stateOld  = this->state;                 // for detecting end of frame
+      uint32_t              timeEntry = this->_statsEntry();         // for duration of handler()
+
+      // act according to current state
+      switch (this->state)
+      {
+        // BREAK ongoing -> when finished, send rest of frame. BREAK echo is not checked
+        case LIN_Master::STATE_BREAK:
+          if (this->_backend()._breakDone())
+          {
+            this->numRx = 1;
+            this->_backend()._write(this->buf+1, this->lenTx-1);
+            this->state = LIN_Master::STATE_BODY;
+            this->_statsBreak(this->timeStart);
+          }
+          else if (LIN_Master_Timebase::getTicks() - this->timeStart > this->timeMax)
+            this->_abort(LIN_Master::ERROR_TIMEOUT);
+          break;
+
+        // frame body ongoing -> receive bytes and check echo byte-wise. Abort on first mismatch
+        case LIN_Master::STATE_BODY:
+          while ((this->numRx < this->lenRx) && this->_backend()._available())
+          {
+            uint8_t byte = this->_backend()._read();
+            if ((this->numRx < this->lenTx) && (byte != this->buf[this->numRx]))
+            {
+              this->_abort(LIN_Master::ERROR_ECHO);
+              break;
+            }
+            this->buf[this->numRx++] = byte;
+          }
+
+          // frame received -> check checksum of slave response (master request is covered by echo)
+          if (this->state != LIN_Master::STATE_BODY)
+            break;
+          if (this->numRx >= this->lenRx)
+          {
+            if ((this->type != LIN_Master::MASTER_REQUEST) &&
+              (this->buf[this->lenRx-1] != LIN_Master::calculateChecksum(this->version, this->id, this->lenRx-4, this->buf+3)))
+              this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_CHK);
+            this->state = LIN_Master::STATE_DONE;
+          }
+          else if (LIN_Master_Timebase::getTicks() - this->timeStart > this->timeMax)
+            this->_abort(LIN_Master::ERROR_TIMEOUT);
+          break;
+
+        // other states -> don't do anything
+        default:
+          break;
+
+      } // switch (state)
+
+      // frame finished in this call -> notify user
+      if ((this->state == LIN_Master::STATE_DONE) && (stateOld != LIN_Master::STATE_DONE))
+        this->_frameDone();
+
+      // bus idle -> directly start next queued frame (if any)
+      if ((SizeQueue > 0) && (this->state == LIN_Master::STATE_IDLE))
+        this->_startJob();
+
+      // update duration of handler() incl. callbacks
+      this->_statsHandler(timeEntry);
+
+      // return state machine state
+      return this->state;
+    }
+
+}; // class LIN_Master_Static
+
+
+
+/**
+  \brief  Compile-time configured LIN master node via HardwareSerial
+
+  \details LIN master node via HardwareSerial or a compatible class with echo of sent bytes. BREAK is sent as 0x00
+           at half baudrate like LIN_Master_HardwareSerial. All methods are inlined, no vtable is used.
+  \tparam MaxData   max. number of data bytes per frame (1..8)
+  \tparam Features  feature set, combination of LIN_FEATURE_DEBUG and LIN_FEATURE_STATS (0 = none)
+  \tparam SizeQueue number of job queue entries incl. one free entry (0 = no job queue)
+  \tparam Serial_t  serial class with begin(), write(), read(), available(), flush() and end()
+*/
+template <uint8_t MaxData = 8, uint8_t Features = 0, uint8_t SizeQueue = 0, class Serial_t = HardwareSerial>
+class LIN_Master_Static_HardwareSerial :
+  public LIN_Master_Static<LIN_Master_Static_HardwareSerial<MaxData, Features, SizeQueue, Serial_t>, MaxData, Features, SizeQueue>
+{
+  // frame engine calls backend primitives
+  friend class LIN_Master_Static<LIN_Master_Static_HardwareSerial<MaxData, Features, SizeQueue, Serial_t>, MaxData, Features, SizeQueue>;
+
+  // PROTECTED VARIABLES
+  protected:
+
+    Serial_t              *pSerial;               //!< pointer to used serial interface
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Open serial interface
+    inline void _open(uint16_t Baudrate)
+    {
+      this->pSerial->begin(Baudrate);
+      while(!(*(this->pSerial)));
+    }
+
+    /// @brief Close serial interface
+    inline void _close(void) { this->pSerial->end(); }
+
+    /// @brief Empty buffers and send BREAK (0x00 at half baudrate)
+    inline void _startBreak(void)
+    {
+      this->pSerial->flush();
+      while (this->pSerial->available())
+        this->pSerial->read();
+      this->pSerial->begin(this->baudrate >> 1);
+      while(!(*(this->pSerial)));
+      this->pSerial->write((uint8_t) 0x00);
+    }
+
+    /// @brief Check for BREAK echo. If received, restore nominal baudrate
+    inline bool _breakDone(void)
+    {
+      if (!this->pSerial->available())
+        return false;
+      this->pSerial->read();
+      this->pSerial->begin(this->baudrate);
+      while(!(*(this->pSerial)));
+      return true;
+    }
+
+    /// @brief Send bytes
+    inline void _write(const uint8_t Data[], uint8_t Num) { this->pSerial->write(Data, Num); }
+
+    /// @brief Check for received byte
+    inline bool _available(void) { return (this->pSerial->available() > 0); }
+
+    /// @brief Read received byte
+    inline uint8_t _read(void) { return (uint8_t) this->pSerial->read(); }
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor. Interface is opened in begin()
+    LIN_Master_Static_HardwareSerial(Serial_t &Interface) { this->pSerial = &Interface; }
+
+}; // class LIN_Master_Static_HardwareSerial
+
+
+
+#if defined(ARDUINO_ARCH_AVR) || defined(ARDUINO_ARCH_ESP8266)
+
+/**
+  \brief  Compile-time configured LIN master node via SoftwareSerial
+
+  \details LIN master node via SoftwareSerial, e.g. for ATtiny85 which has no hardware UART. Like
+           LIN_Master_SoftwareSerial, BREAK is generated via GPIO (blocking) and reception is disabled while sending,
+           as SoftwareSerial is half-duplex. The echo of sent bytes is emulated, i.e. echo errors are not detected.
+           Requires a LIN transceiver, as Rx&Tx cannot be connected. All methods are inlined, no vtable is used.
+  \tparam MaxData   max. number of data bytes per frame (1..8)
+  \tparam Features  feature set, combination of LIN_FEATURE_DEBUG and LIN_FEATURE_STATS (0 = none)
+  \tparam SizeQueue number of job queue entries incl. one free entry (0 = no job queue)
+  \tparam Serial_t  serial class with begin(), write(), read(), available(), listen(), stopListening() and end()
+*/
+template <uint8_t MaxData = 8, uint8_t Features = 0, uint8_t SizeQueue = 0, class Serial_t = SoftwareSerial>
+class LIN_Master_Static_SoftwareSerial :
+  public LIN_Master_Static<LIN_Master_Static_SoftwareSerial<MaxData, Features, SizeQueue, Serial_t>, MaxData, Features, SizeQueue>
+{
+  // frame engine calls backend primitives
+  friend class LIN_Master_Static<LIN_Master_Static_SoftwareSerial<MaxData, Features, SizeQueue, Serial_t>, MaxData, Features, SizeQueue>;
+
+  // PROTECTED VARIABLES
+  protected:
+
+    Serial_t              *pSerial;               //!< pointer to used serial interface
+    uint8_t               pinTx;                  //!< pin used for transmit, for BREAK via GPIO
+    uint16_t              durationBit;            //!< duration [us] of one bit
+    const uint8_t         *pEcho;                 //!< emulated echo of last sent bytes
+    uint8_t               numEcho;                //!< number of pending echo bytes
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Open serial interface
+    inline void _open(uint16_t Baudrate)
+    {
+      this->durationBit = (uint16_t) (1000000L / (uint32_t) Baudrate);
+      this->numEcho     = 0;
+      this->pSerial->begin(Baudrate);
+    }
+
+    /// @brief Close serial interface
+    inline void _close(void) { this->pSerial->end(); }
+
+    /// @brief Empty buffers and send BREAK via GPIO (13 bit low, 1 bit delimiter). Is blocking
+    inline void _startBreak(void)
+    {
+      while (this->pSerial->available())
+        this->pSerial->read();
+      this->numEcho = 0;
+      digitalWrite(this->pinTx, LOW);
+      delayMicroseconds(13 * this->durationBit);
+      digitalWrite(this->pinTx, HIGH);
+      delayMicroseconds(this->durationBit);
+    }
+
+    /// @brief BREAK is already finished in _startBreak()
+    inline bool _breakDone(void) { return true; }
+
+    /// @brief Send bytes with reception disabled (blocking), and emulate their echo
+    inline void _write(const uint8_t Data[], uint8_t Num)
+    {
+      this->pSerial->stopListening();
+      this->pSerial->write(Data, Num);
+      this->pSerial->listen();
+      this->pEcho   = Data;
+      this->numEcho = Num;
+    }
+
+    /// @brief Check for received byte or pending echo
+    inline bool _available(void) { return ((this->numEcho > 0) || (this->pSerial->available() > 0)); }
+
+    /// @brief Read emulated echo, then received bytes
+    inline uint8_t _read(void)
+    {
+      if (this->numEcho > 0)
+      {
+        this->numEcho--;
+        return *(this->pEcho++);
+      }
+      return (uint8_t) this->pSerial->read();
+    }
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor. Interface is opened in begin()
+    LIN_Master_Static_SoftwareSerial(Serial_t &Interface, uint8_t PinTx)
+    {
+      this->pSerial     = &Interface;
+      this->pinTx       = PinTx;
+      this->durationBit = 0;
+      this->pEcho       = NULL;
+      this->numEcho     = 0;
+    }
+
+}; // class LIN_Master_Static_SoftwareSerial
+
+#endif // ARDUINO_ARCH_AVR || ARDUINO_ARCH_ESP8266
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_STATIC_H_
@@ -0,0 +1,423 @@
+/**
+  \file     LIN_master_TP.cpp
+  \brief    Diagnostic transport layer (ISO 17987-2 / LIN TP) for LIN master emulation
+  \details  This library provides the LIN transport protocol on top of a LIN master node. Requests are
+            segmented into single/first/consecutive frames on master request ID 0x3C, and responses are
+            polled via slave response ID 0x3D and reassembled in place, i.e. the response overwrites the request
+            in the same message buffer. Consecutive frames are started from the handler() call which finished
+            the previous frame, i.e. back-to-back.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \note     While a request is ongoing, the LIN node must not be used for other frames
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "LIN_master_TP.h"
+
+
+/**************************
+ * PROTECTED METHODS
+**************************/
+
+/**
+  \brief      Start next request frame
+  \details    Start next request frame, i.e. single frame (SF) or first frame (FF) for the first segment, else
+              consecutive frame (CF). Unused bytes are filled with 0xFF
+*/
+void LIN_Master_TP::_sendRequest(void)
+{
+  uint8_t   *pData;
+  uint8_t   num;
+
+  // init frame with NAD and fill bytes
+  memset(this->frame, 0xFF, 8);
+  this->frame[0] = this->nad;
+
+  // single frame: PCI = 0x0L
+  if ((this->pos == 0) && (this->length <= 6))
+  {
+    this->frame[1] = (uint8_t) this->length;
+    pData = this->frame + 2;
+    num   = (uint8_t) this->length;
+  }
+
+  // first frame: PCI = 0x1H, LEN = 0xLL
+  else if (this->pos == 0)
+  {
+    this->frame[1] = (uint8_t) (0x10 | ((this->length >> 8) & 0x0F));
+    this->frame[2] = (uint8_t) (this->length & 0xFF);
+    pData = this->frame + 3;
+    num   = 5;
+    this->sn = 1;
+  }
+
+  // consecutive frame: PCI = 0x2N
+  else
+  {
+    this->frame[1] = (uint8_t) (0x20 | this->sn);
+    this->sn = (this->sn + 1) & 0x0F;
+    pData = this->frame + 2;
+    num   = ((this->length - this->pos) > 6) ? 6 : (uint8_t) (this->length - this->pos);
+  }
+
+  // copy segment
+  memcpy(pData, this->buffer + this->pos, num);
+  this->pos += num;
+
+  // start frame. Completion is detected via frame sequence number
+  this->seqFrame    = this->pLIN->getFrameSeq();
+  this->frameActive = true;
+  this->timeFrame   = millis();
+  this->pLIN->sendMasterRequest(LIN_Master::LIN_V2, LIN_TP_ID_REQUEST, 8, this->frame);
+
+} // LIN_Master_TP::_sendRequest()
+
+
+
+/**
+  \brief      Start slave response header
+  \details    Start slave response header for polling (next segment of) response
+*/
+void LIN_Master_TP::_pollResponse(void)
+{
+  // start frame. Completion is detected via frame sequence number
+  this->seqFrame    = this->pLIN->getFrameSeq();
+  this->frameActive = true;
+  this->timeFrame   = millis();
+  this->pLIN->receiveSlaveResponse(LIN_Master::LIN_V2, LIN_TP_ID_RESPONSE, 8);
+
+} // LIN_Master_TP::_pollResponse()
+
+
+
+/**
+  \brief      Evaluate received response frame
+  \details    Evaluate received response frame and reassemble message in buffer. Frames of other nodes are ignored.
+              A negative response with NRC 0x78 (response pending) extends the response timeout to P2ext
+  \param[in]  Data      received frame (NAD, PCI, D1..D6)
+*/
+void LIN_Master_TP::_receiveResponse(const uint8_t Data[])
+{
+  uint8_t   pci = Data[1];
+  uint8_t   num;
+
+  // response of other node -> ignore (any node may respond to functional or broadcast request)
+  if ((Data[0] != this->nad) && (this->nad != LIN_TP_NAD_FUNCTIONAL) && (this->nad != LIN_TP_NAD_BROADCAST))
+    return;
+
+  // act according to frame type
+  switch (pci >> 4)
+  {
+    // single frame
+    case 0x0:
+      num = pci & 0x0F;
+      if (this->pos != 0)
+        this->_abort(ERROR_SEQUENCE);
+      else if ((num == 0) || (num > 6))
+        this->_abort(ERROR_PCI);
+      else if ((num == 3) && (Data[2] == 0x7F) && (Data[4] == 0x78))
+      {
+        this->timeWait = millis();                            // response pending -> extend timeout
+        this->timeMax  = this->timeP2ext;
+      }
+      else if (num > this->size)
+        this->_abort(ERROR_OVERFLOW);
+      else
+      {
+        memcpy(this->buffer, Data + 2, num);
+        this->length = num;
+        this->state  = STATE_DONE;
+      }
+      break;
+
+    // first frame
+    case 0x1:
+      if (this->pos != 0)
+        this->_abort(ERROR_SEQUENCE);
+      else if ((((uint16_t) (pci & 0x0F) << 8) | Data[2]) <= 6)
+        this->_abort(ERROR_PCI);
+      else if ((((uint16_t) (pci & 0x0F) << 8) | Data[2]) > this->size)
+        this->_abort(ERROR_OVERFLOW);
+      else
+      {
+        this->length   = ((uint16_t) (pci & 0x0F) << 8) | Data[2];
+        memcpy(this->buffer, Data + 3, 5);
+        this->pos      = 5;
+        this->sn       = 1;
+        this->timeWait = millis();
+        this->timeMax  = this->timeNCr;
+      }
+      break;
+
+    // consecutive frame
+    case 0x2:
+      if ((this->pos == 0) || ((pci & 0x0F) != this->sn))
+        this->_abort(ERROR_SEQUENCE);
+      else
+      {
+        num = ((this->length - this->pos) > 6) ? 6 : (uint8_t) (this->length - this->pos);
+        memcpy(this->buffer + this->pos, Data + 2, num);
+        this->pos += num;
+        this->sn   = (this->sn + 1) & 0x0F;
+        this->timeWait = millis();
+        if (this->pos >= this->length)
+          this->state = STATE_DONE;
+      }
+      break;
+
+    // invalid frame type
+    default:
+      this->_abort(ERROR_PCI);
+
+  } // switch (frame type)
+
+} // LIN_Master_TP::_receiveResponse()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor for LIN transport layer
+  \details    Constructor for LIN transport layer. Store LIN node and message buffer
+  \param[in]  Interface     LIN master node used for diagnostic frames
+  \param[in]  Buffer        message buffer for request and response
+  \param[in]  Size          size of message buffer (max. 4095)
+*/
+LIN_Master_TP::LIN_Master_TP(LIN_Master &Interface, uint8_t Buffer[], uint16_t Size)
+{
+  // store parameters in class variables
+  this->pLIN        = &Interface;
+  this->buffer      = Buffer;
+  this->size        = (Size <= LIN_TP_MAX_LENGTH) ? Size : LIN_TP_MAX_LENGTH;
+
+  // initialize transport layer properties
+  this->state       = STATE_IDLE;
+  this->error       = NO_ERROR;
+  this->nad         = 0x00;
+  this->length      = 0;
+  this->pos         = 0;
+  this->sn          = 0;
+  this->response    = false;
+  this->frameActive = false;
+  this->seqFrame    = 0;
+  this->timeFrame   = 0;
+  this->timeWait    = 0;
+  this->timeMax     = 0;
+
+  // default timing
+  this->setTiming(LIN_TP_TIME_NAS, LIN_TP_TIME_NCR, LIN_TP_TIME_P2, LIN_TP_TIME_P2EXT, LIN_TP_TIME_POLL);
+
+} // LIN_Master_TP::LIN_Master_TP()
+
+
+
+/**
+  \brief      Set timing parameters
+  \details    Set timing parameters of transport layer. All times in [ms]
+  \param[in]  NAs       N_As: max. duration of a request frame
+  \param[in]  NCr       N_Cr: max. time until next consecutive frame of response
+  \param[in]  P2        max. time from end of request to first response frame
+  \param[in]  P2ext     max. time after negative response "response pending" (NRC 0x78)
+  \param[in]  Poll      period of slave response headers while waiting for first response frame
+*/
+void LIN_Master_TP::setTiming(uint16_t NAs, uint16_t NCr, uint16_t P2, uint16_t P2ext, uint16_t Poll)
+{
+  this->timeNAs   = NAs;
+  this->timeNCr   = NCr;
+  this->timeP2    = P2;
+  this->timeP2ext = P2ext;
+  this->timePoll  = Poll;
+
+} // LIN_Master_TP::setTiming()
+
+
+
+/**
+  \brief      Start request with data in message buffer
+  \details    Start request with data already stored in message buffer, i.e. without copying. The response
+              is reassembled in the same buffer. LIN node must be idle
+  \param[in]  NAD       node address of slave, or LIN_TP_NAD_FUNCTIONAL / LIN_TP_NAD_BROADCAST
+  \param[in]  Length    request length [B] (1..buffer size)
+  \param[in]  Response  wait for response after request (false e.g. for functional requests)
+  \return     true if request was started
+*/
+bool LIN_Master_TP::request(uint8_t NAD, uint16_t Length, bool Response)
+{
+  // request ongoing, invalid length or LIN node busy
+  if ((this->state == STATE_REQUEST) || (this->state == STATE_RESPONSE) || (Length == 0) || (Length > this->size) ||
+    (this->pLIN->getState() != LIN_Master::STATE_IDLE))
+    return false;
+
+  // init request
+  this->nad      = NAD;
+  this->length   = Length;
+  this->pos      = 0;
+  this->response = Response;
+  this->error    = NO_ERROR;
+  this->state    = STATE_REQUEST;
+
+  // start first frame
+  this->_sendRequest();
+
+  // request started
+  return true;
+
+} // LIN_Master_TP::request()
+
+
+
+/**
+  \brief      Start request
+  \details    Copy request into message buffer and start it. The response is reassembled in the same buffer
+  \param[in]  NAD       node address of slave, or LIN_TP_NAD_FUNCTIONAL / LIN_TP_NAD_BROADCAST
+  \param[in]  Data      request data, e.g. service ID and parameters
+  \param[in]  Length    request length [B] (1..buffer size)
+  \param[in]  Response  wait for response after request (false e.g. for functional requests)
+  \return     true if request was started
+*/
+bool LIN_Master_TP::request(uint8_t NAD, const uint8_t Data[], uint16_t Length, bool Response)
+{
+  // request ongoing or invalid length
+  if ((this->state == STATE_REQUEST) || (this->state == STATE_RESPONSE) || (Length == 0) || (Length > this->size))
+    return false;
+
+  // copy data and start request
+  memmove(this->buffer, Data, Length);
+  return this->request(NAD, Length, Response);
+
+} // LIN_Master_TP::request()
+
+
+
+/**
+  \brief      Send request and wait for response
+  \details    Send request with data in message buffer and wait until response is received or timeout (blocking)
+  \param[in]  NAD       node address of slave, or LIN_TP_NAD_FUNCTIONAL / LIN_TP_NAD_BROADCAST
+  \param[in]  Length    request length [B] (1..buffer size)
+  \param[in]  Response  wait for response after request (false e.g. for functional requests)
+  \return     transport layer error
+*/
+LIN_Master_TP::error_t LIN_Master_TP::requestBlocking(uint8_t NAD, uint16_t Length, bool Response)
+{
+  // start request
+  if (!this->request(NAD, Length, Response))
+    return ERROR_STATE;
+
+  // wait until request is finished. Timeouts guarantee termination
+  while ((this->state == STATE_REQUEST) || (this->state == STATE_RESPONSE))
+    this->handler();
+
+  // return error
+  return this->error;
+
+} // LIN_Master_TP::requestBlocking()
+
+
+
+/**
+  \brief      Handle transport layer in background
+  \details    Handle transport layer in background. Calls LIN handler(), evaluates finished frames and starts
+              the next frame. Consecutive request frames and response polls are started directly from the call
+              which finished the previous frame, i.e. back-to-back
+  \return     current state of transport layer
+*/
+LIN_Master_TP::state_t LIN_Master_TP::handler(void)
+{
+  LIN_Master::view_t    view;
+  uint32_t              timeNow;
+
+  // no request ongoing
+  if ((this->state == STATE_IDLE) || (this->state == STATE_DONE))
+    return this->state;
+
+  // handle LIN node
+  this->pLIN->handler();
+  timeNow = millis();
+
+  // LIN frame ongoing
+  if (this->frameActive)
+  {
+    // frame not finished -> check N_As
+    if (this->pLIN->getFrameSeq() == this->seqFrame)
+    {
+      if (timeNow - this->timeFrame > this->timeNAs)
+      {
+        this->frameActive = false;
+        this->pLIN->resetStateMachine();
+        this->_abort(ERROR_TIMEOUT);
+      }
+      return this->state;
+    }
+
+    // frame finished -> get frame and release LIN node
+    this->frameActive = false;
+    this->pLIN->getFrameView(view);
+    if (this->pLIN->getState() == LIN_Master::STATE_DONE)
+    {
+      this->pLIN->resetStateMachine();
+      this->pLIN->resetError();
+    }
+
+    // request frame finished
+    if (this->state == STATE_REQUEST)
+    {
+      // LIN error -> abort request
+      if (view.error != LIN_Master::NO_ERROR)
+      {
+        this->_abort(ERROR_FRAME);
+        return this->state;
+      }
+
+      // request complete -> wait for response (if any)
+      if (this->pos >= this->length)
+      {
+        this->length = 0;
+        this->pos    = 0;
+        if (!this->response)
+        {
+          this->state = STATE_DONE;
+          return this->state;
+        }
+        this->state    = STATE_RESPONSE;
+        this->timeWait = timeNow;
+        this->timeMax  = this->timeP2;
+      }
+
+      // send next consecutive frame back-to-back
+      else
+      {
+        this->_sendRequest();
+        return this->state;
+      }
+
+    } // request frame finished
+
+    // response frame finished. No slave response (LIN timeout) -> continue polling until response timeout
+    else if (view.error == LIN_Master::NO_ERROR)
+      this->_receiveResponse(view.data);
+
+  } // LIN frame ongoing
+
+  // waiting for response
+  if (this->state == STATE_RESPONSE)
+  {
+    // P2, P2ext or N_Cr timeout
+    if (timeNow - this->timeWait > this->timeMax)
+      this->_abort(ERROR_TIMEOUT);
+
+    // poll next response frame. Consecutive frames back-to-back, else with poll period
+    else if ((this->pos > 0) || (timeNow - this->timeFrame >= this->timePoll))
+      this->_pollResponse();
+  }
+
+  // return state
+  return this->state;
+
+} // LIN_Master_TP::handler()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,173 @@
+/**
+  \file     LIN_master_TP.h
+  \brief    Diagnostic transport layer (ISO 17987-2 / LIN TP) for LIN master emulation
+  \details  This library provides the LIN transport protocol on top of a LIN master node. Requests are
+            segmented into single/first/consecutive frames on master request ID 0x3C, and responses are
+            polled via slave response ID 0x3D and reassembled in place, i.e. the response overwrites the request
+            in the same message buffer. Consecutive frames are started from the handler() call which finished
+            the previous frame, i.e. back-to-back.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \note     While a request is ongoing, the LIN node must not be used for other frames
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_TP_H_
+#define _LIN_MASTER_TP_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <Arduino.h>
+#include "LIN_master.h"
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+#define LIN_TP_ID_REQUEST       0x3C        //!< frame ID of diagnostic master request
+#define LIN_TP_ID_RESPONSE      0x3D        //!< frame ID of diagnostic slave response
+#define LIN_TP_NAD_FUNCTIONAL   0x7E        //!< functional NAD (no response)
+#define LIN_TP_NAD_BROADCAST    0x7F        //!< broadcast NAD
+#define LIN_TP_MAX_LENGTH       4095        //!< max. message length [B]
+
+#define LIN_TP_TIME_NAS         1000        //!< default N_As: max. duration of a request frame [ms]
+#define LIN_TP_TIME_NCR         1000        //!< default N_Cr: max. time until next consecutive frame of response [ms]
+#define LIN_TP_TIME_P2          1000        //!< default max. time from end of request to first response frame [ms]
+#define LIN_TP_TIME_P2EXT       5000        //!< default max. time after "response pending" (NRC 0x78) [ms]
+#define LIN_TP_TIME_POLL        10          //!< default period of slave response headers while waiting for response [ms]
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  LIN diagnostic transport layer
+
+  \details LIN diagnostic transport layer (ISO 17987-2). Sends segmented requests and receives segmented responses in background.
+*/
+class LIN_Master_TP
+{
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// state of transport layer
+    typedef enum
+    {
+      STATE_IDLE      = 0,                        //!< no request ongoing
+      STATE_REQUEST   = 1,                        //!< request frames are being sent
+      STATE_RESPONSE  = 2,                        //!< response frames are being received
+      STATE_DONE      = 3                         //!< request finished (with or without error)
+    } state_t;
+
+
+    /// transport layer error codes. Use bitmasks, as error is latched
+    typedef enum
+    {
+      NO_ERROR        = 0x00,                     //!< no error
+      ERROR_STATE     = 0x01,                     //!< request started while busy or LIN node closed
+      ERROR_FRAME     = 0x02,                     //!< LIN error in request frame (e.g. echo)
+      ERROR_TIMEOUT   = 0x04,                     //!< N_As, N_Cr or P2 timeout
+      ERROR_SEQUENCE  = 0x08,                     //!< wrong sequence number or unexpected frame type
+      ERROR_PCI       = 0x10,                     //!< invalid protocol control information
+      ERROR_OVERFLOW  = 0x20                      //!< message too long for buffer
+    } error_t;
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    LIN_Master            *pLIN;                  //!< pointer to LIN master node
+    uint8_t               *buffer;                //!< message buffer for request and response
+    uint16_t              size;                   //!< size of message buffer
+    state_t               state;                  //!< state of transport layer
+    error_t               error;                  //!< error. Is latched until next request
+
+    // message properties
+    uint8_t               nad;                    //!< node address of request
+    uint16_t              length;                 //!< length of request or received response
+    uint16_t              pos;                    //!< number of bytes already sent or received
+    uint8_t               sn;                     //!< sequence number of next consecutive frame
+    bool                  response;               //!< response expected after request
+
+    // frame handling
+    uint8_t               frame[8];               //!< data of next request frame (NAD, PCI, D1..D6)
+    bool                  frameActive;            //!< LIN frame ongoing
+    uint8_t               seqFrame;               //!< LIN frame sequence number at frame start
+
+    // timing [ms]
+    uint16_t              timeNAs;                //!< N_As: max. duration of request frame
+    uint16_t              timeNCr;                //!< N_Cr: max. time until next consecutive frame
+    uint16_t              timeP2;                 //!< max. time until first response frame
+    uint16_t              timeP2ext;              //!< max. time after response pending
+    uint16_t              timePoll;               //!< period of slave response headers while waiting
+    uint32_t              timeFrame;              //!< millis() at start of current frame
+    uint32_t              timeWait;               //!< millis() at start of current response timeout
+    uint16_t              timeMax;                //!< current response timeout
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Start next request frame (SF, FF or CF)
+    void _sendRequest(void);
+
+    /// @brief Start slave response header for polling response
+    void _pollResponse(void);
+
+    /// @brief Evaluate received response frame
+    void _receiveResponse(const uint8_t Data[]);
+
+    /// @brief Finish request with error
+    inline void _abort(error_t Error) { this->error = (error_t) ((int) this->error | (int) Error); this->state = STATE_DONE; }
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_TP(LIN_Master &Interface, uint8_t Buffer[], uint16_t Size);
+
+    /// @brief Set timing parameters [ms]
+    void setTiming(uint16_t NAs, uint16_t NCr, uint16_t P2, uint16_t P2ext, uint16_t Poll);
+
+    /// @brief Start request with data already in message buffer (in place)
+    bool request(uint8_t NAD, uint16_t Length, bool Response = true);
+
+    /// @brief Start request, copy data into message buffer
+    bool request(uint8_t NAD, const uint8_t Data[], uint16_t Length, bool Response = true);
+
+    /// @brief Send request and wait for response (blocking)
+    error_t requestBlocking(uint8_t NAD, uint16_t Length, bool Response = true);
+
+    /// @brief Reset transport layer after finished request
+    inline void reset(void) { this->state = STATE_IDLE; this->error = NO_ERROR; }
+
+    /// @brief Getter for transport layer state
+    inline state_t getState(void) { return this->state; }
+
+    /// @brief Getter for transport layer error
+    inline error_t getError(void) { return this->error; }
+
+    /// @brief Getter for message buffer (contains response after STATE_DONE)
+    inline uint8_t *getBuffer(void) { return this->buffer; }
+
+    /// @brief Getter for length of received response
+    inline uint16_t getLength(void) { return this->length; }
+
+    /// @brief Handle transport layer in background (call as often as possible). Also calls LIN handler()
+    state_t handler(void);
+
+}; // class LIN_Master_TP
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_TP_H_
@@ -0,0 +1,79 @@
+/**
+  \file     LIN_master_Timebase.cpp
+  \brief    Time base for frame timing of LIN master emulation
+  \details  This library provides the time base for frame timeouts and durations. By default micros() is used,
+            with LIN_MASTER_TIMEBASE_HW a free-running hardware counter. For details see LIN_master_Timebase.h
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include "LIN_master.h"
+#include "LIN_master_Timebase.h"
+
+
+/**************************
+ * STATIC VARIABLES
+**************************/
+
+#if defined(LIN_TIMEBASE_AVR_T1)
+  volatile uint16_t LIN_Master_Timebase::ticksHigh = 0;
+#endif
+
+
+/**************************
+ * TIMER ISR
+**************************/
+
+#if defined(LIN_TIMEBASE_AVR_T1)
+
+  /**
+    \brief      Timer1 overflow ISR
+    \details    Extend 16bit Timer1 to 32bit tick counter
+  */
+  ISR(TIMER1_OVF_vect)
+  {
+    LIN_Master_Timebase::ticksHigh++;
+
+  } // ISR(TIMER1_OVF_vect)
+
+#endif // LIN_TIMEBASE_AVR_T1
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Start hardware counter
+  \details    Start free-running hardware counter (if used). Is called by LIN_Master::begin() and may be called
+              repeatedly, e.g. for several LIN nodes. For micros() nothing is done
+*/
+void LIN_Master_Timebase::begin(void)
+{
+  // AVR: Timer1 in normal mode with prescaler 8 and overflow interrupt
+  #if defined(LIN_TIMEBASE_AVR_T1)
+    if (TCCR1B != (1 << CS11))
+    {
+      noInterrupts();
+      TCCR1A = 0;
+      TCCR1B = (1 << CS11);
+      TIFR1  = (1 << TOV1);                                   // clear pending overflow
+      TIMSK1 = (1 << TOIE1);
+      interrupts();
+    }
+
+  // SAM: enable DWT cycle counter
+  #elif defined(LIN_TIMEBASE_DWT)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+  #endif
+
+  // CPU cycle counter (ESP32, ESP8266) and micros() are always running
+
+} // LIN_Master_Timebase::begin()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,118 @@
+/**
+  \file     LIN_master_Timebase.h
+  \brief    Time base for frame timing of LIN master emulation
+  \details  This library provides the time base for frame timeouts and durations. By default micros() is used.
+            With LIN_MASTER_TIMEBASE_HW (see LIN_master.h) a free-running hardware counter is used instead, which
+            has a higher resolution and is read without function call:
+              - AVR (ATmega): Timer1 at F_CPU/8, extended to 32bit via overflow ISR. Resolution 0.5us at 16MHz
+              - SAM: DWT cycle counter. Resolution 1/84us
+              - ESP32, ESP8266: CPU cycle counter (CCOUNT). Resolution 1/F_CPU
+            Timeouts are converted to ticks once per frame, i.e. each timeout check is a single subtraction and compare.
+            Durations reported to the user (statistics, trace, learned response times) are converted back to [us].
+  \note     AVR: Timer1 is reconfigured, i.e. PWM on the Timer1 pins and libraries using Timer1 (e.g. Servo) are not available
+  \note     SAM, ESP32, ESP8266: cycle counter wraps after 2^32 CPU cycles (e.g. ~18s at 240MHz), i.e. only for durations
+            below that. CPU frequency must not be changed at runtime. ESP32: cycle counters of the two cores are not
+            synchronized, i.e. a frame must be started and handled on the same core
+  \note     Other platforms, e.g. ATtiny, fall back to micros()
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_TIMEBASE_H_
+#define _LIN_MASTER_TIMEBASE_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <Arduino.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+// select hardware counter (if requested and available)
+#if defined(LIN_MASTER_TIMEBASE_HW)
+  #if defined(ARDUINO_ARCH_AVR) && defined(TCCR1B) && defined(TIFR1) && ((F_CPU % 8000000L) == 0)
+    #define LIN_TIMEBASE_AVR_T1                   //!< use Timer1 of ATmega
+    #define LIN_TICKS_PER_US    (F_CPU / 8000000L)  //!< counter ticks per us
+  #elif defined(ARDUINO_ARCH_SAM)
+    #define LIN_TIMEBASE_DWT                      //!< use DWT cycle counter of Cortex-M3
+    #define LIN_TICKS_PER_US    (F_CPU / 1000000L)  //!< counter ticks per us
+  #elif defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+    #define LIN_TIMEBASE_CCOUNT                   //!< use CPU cycle counter
+    #define LIN_TICKS_PER_US    (F_CPU / 1000000L)  //!< counter ticks per us
+  #endif
+#endif
+
+// default: use micros()
+#if !defined(LIN_TICKS_PER_US)
+  #define LIN_TIMEBASE_MICROS                     //!< use micros()
+  #define LIN_TICKS_PER_US      1                 //!< counter ticks per us
+#endif
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  Time base for LIN frame timing
+
+  \details Time base for LIN frame timing. Free-running 32bit tick counter, either micros() or a hardware counter.
+*/
+class LIN_Master_Timebase
+{
+  // PUBLIC VARIABLES
+  public:
+
+    #if defined(LIN_TIMEBASE_AVR_T1)
+      static volatile uint16_t  ticksHigh;        //!< upper 16bit of tick counter, incremented by Timer1 overflow ISR
+    #endif
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Start hardware counter (if used). Called by LIN_Master::begin(), may be called repeatedly
+    static void begin(void);
+
+    /// @brief Getter for current tick counter
+    static inline uint32_t getTicks(void)
+    {
+      #if defined(LIN_TIMEBASE_AVR_T1)
+        uint8_t   sreg = SREG;
+        uint16_t  low, high;
+        cli();
+        low  = TCNT1;
+        high = LIN_Master_Timebase::ticksHigh;
+        if ((TIFR1 & (1 << TOV1)) && (low < 0x8000))   // overflow not yet handled by ISR
+          high++;
+        SREG = sreg;
+        return ((uint32_t) high << 16) | low;
+      #elif defined(LIN_TIMEBASE_DWT)
+        return DWT->CYCCNT;
+      #elif defined(LIN_TIMEBASE_CCOUNT)
+        return ESP.getCycleCount();
+      #else
+        return micros();
+      #endif
+    }
+
+    /// @brief Convert duration [us] to ticks
+    static inline uint32_t usToTicks(uint32_t Time) { return Time * LIN_TICKS_PER_US; }
+
+    /// @brief Convert duration in ticks to [us]
+    static inline uint32_t ticksToUs(uint32_t Ticks) { return Ticks / LIN_TICKS_PER_US; }
+
+}; // class LIN_Master_Timebase
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_TIMEBASE_H_
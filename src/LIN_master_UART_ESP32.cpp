@@ -0,0 +1,503 @@
+/**
+  \file     LIN_master_UART_ESP32.cpp
+  \brief    LIN master emulation library using the ESP-IDF UART driver of ESP32
+  \details  This library provides a master node emulation for a LIN bus via the ESP-IDF UART driver and its event queue.
+            The complete frame is received with a single RX FIFO threshold event, i.e. without per-byte polling
+            and without the >1ms delay of HardwareSerial::available().
+            Optionally the node runs in its own FreeRTOS task pinned to a core, which blocks on the UART event queue
+            and exchanges jobs and results with the application via FreeRTOS queues, see startTask().
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \note     The UART is used directly, i.e. the corresponding HardwareSerial (e.g. Serial2) must not be used.
+  \note     Pattern detection is not used, because frame length is known. Instead the RX FIFO threshold is set to the
+            number of expected bytes, so the driver signals the finished frame with one event.
+  \author   Georg Icking-Konert
+*/
+
+// assert ESP32 platform
+#if defined(ARDUINO_ARCH_ESP32)
+
+// include files
+#include "Arduino.h"
+#include "LIN_master_UART_ESP32.h"
+
+
+/**
+  \brief      Read pending events from UART event queue
+  \details    Read pending events from UART event queue without blocking and store time of last data event.
+              On buffer overflow the receive buffer is flushed, i.e. the frame ends with a timeout
+  \return     true if a data event was received
+*/
+bool LIN_Master_UART_ESP32::_readEvents(void)
+{
+  uart_event_t  event;
+  bool          data = false;
+
+  // read all pending events
+  while (xQueueReceive(this->queueEvent, (void*) &event, 0) == pdTRUE)
+  {
+    // data received -> store time of reception
+    if (event.type == UART_DATA)
+    {
+      this->timeEvent = LIN_Master_Timebase::getTicks();
+      data = true;
+    }
+
+    // overflow -> flush receive buffer
+    else if ((event.type == UART_FIFO_OVF) || (event.type == UART_BUFFER_FULL))
+      uart_flush_input(this->port);
+
+    // ignore other events, e.g. UART_BREAK or UART_FRAME_ERR due to own BREAK
+
+  } // while events pending
+
+  // return if data was received
+  return data;
+
+} // LIN_Master_UART_ESP32::_readEvents()
+
+
+
+/**
+  \brief      Send LIN break
+  \details    Send LIN break (=16bit low)
+  \return     current state of LIN state machine
+*/
+LIN_Master::state_t LIN_Master_UART_ESP32::_sendBreak(void)
+{
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master_UART_ESP32::_sendBreak()");
+  #endif
+
+  // if state is wrong, exit immediately
+  if (this->state != LIN_Master::STATE_IDLE)
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_STATE);
+    this->state = LIN_Master::STATE_DONE;
+    return this->state;
+  }
+
+  // empty buffers, just in case...
+  uart_flush_input(this->port);
+  xQueueReset(this->queueEvent);
+
+  // signal BREAK echo immediately
+  uart_set_rx_full_threshold(this->port, 1);
+
+  // set half baudrate for BREAK. Is only a register access, no re-init of UART
+  uart_set_baudrate(this->port, this->baudrate >> 1);
+
+  // send BREAK (>=13 bit low)
+  uart_write_bytes(this->port, (const char*) this->bufTx, 1);
+
+  // progress state
+  this->state = LIN_Master::STATE_BREAK;
+
+  // return state
+  return this->state;
+
+} // LIN_Master_UART_ESP32::_sendBreak()
+
+
+
+/**
+  \brief      Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+  \details    Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+  \return     current state of LIN state machine
+*/
+LIN_Master::state_t LIN_Master_UART_ESP32::_sendFrame(void)
+{
+  size_t    len = 0;
+
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master_UART_ESP32::_sendFrame()");
+  #endif
+
+  // if state is wrong, exit immediately
+  if (this->state != LIN_Master::STATE_BREAK)
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_STATE);
+    this->state = LIN_Master::STATE_DONE;
+    return this->state;
+  }
+
+  // check for BREAK echo
+  this->_readEvents();
+  uart_get_buffered_data_len(this->port, &len);
+
+  // BREAK echo received
+  if (len >= 1)
+  {
+    // store echo in Rx
+    uart_read_bytes(this->port, this->bufRx, 1, 0);
+
+    // restore nominal baudrate
+    uart_set_baudrate(this->port, this->baudrate);
+
+    // signal end of frame with a single event (-1 because BREAK is already handled)
+    uart_set_rx_full_threshold(this->port, this->lenRx-1);
+
+    // send rest of frame (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID). Fits into Tx FIFO, i.e. no blocking
+    uart_write_bytes(this->port, (const char*) (this->bufTx+1), this->lenTx-1);
+
+    // progress state
+    this->state = LIN_Master::STATE_BODY;
+
+  } // BREAK echo received
+
+  // no byte(s) received
+  else
+  {
+    // check for timeout
+    if (this->_checkTimeout())
+    {
+      this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_TIMEOUT);
+      this->state = LIN_Master::STATE_DONE;
+    }
+
+  } // no byte(s) received
+
+  // return state
+  return this->state;
+
+} // LIN_Master_UART_ESP32::_sendFrame()
+
+
+
+/**
+  \brief      Receive and check LIN frame
+  \details    Receive and check LIN frame (request frame: check echo; response frame: check header echo & checksum)
+  \return     current state of LIN state machine
+*/
+LIN_Master::state_t LIN_Master_UART_ESP32::_receiveFrame(void)
+{
+  size_t    len = 0;
+
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master_UART_ESP32::_receiveFrame()");
+  #endif
+
+  // if state is wrong, exit immediately
+  if (this->state != LIN_Master::STATE_BODY)
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_STATE);
+    this->state = LIN_Master::STATE_DONE;
+    return this->state;
+  }
+
+  // check for end of frame
+  this->_readEvents();
+  uart_get_buffered_data_len(this->port, &len);
+
+  // frame body received (-1 because BREAK is already handled in _sendFrame())
+  if (len >= (size_t) (this->lenRx-1))
+  {
+    // store bytes in Rx
+    uart_read_bytes(this->port, this->bufRx+1, this->lenRx-1, 0);
+
+    // check frame for errors
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) this->_checkFrame());
+
+    // progress state
+    this->state = LIN_Master::STATE_DONE;
+
+  } // frame body received
+
+  // frame body received not yet received
+  else
+  {
+    // check for timeout
+    if (this->_checkTimeout())
+    {
+      this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_TIMEOUT);
+      this->state = LIN_Master::STATE_DONE;
+    }
+
+  } // not enough bytes received
+
+  // return state
+  return this->state;
+
+} // LIN_Master_UART_ESP32::_receiveFrame()
+
+
+
+/**
+  \brief      Process one job of LIN task until frame is finished
+  \details    Start frame and block on UART event queue until frame is finished or timeout is reached.
+              Then post result to result queue and release LIN node. Callbacks are executed in LIN task context.
+  \param[in]  Job     frame to send
+*/
+void LIN_Master_UART_ESP32::_taskFrame(const LIN_Master::job_t &Job)
+{
+  LIN_Master::result_t  result;
+  uart_event_t          event;
+  uint32_t              timeElapsed;
+  TickType_t            wait;
+
+  // errors are reported per frame
+  this->resetStateMachine();
+  this->resetError();
+
+  // start frame, bypassing job queue
+  if (Job.type == LIN_Master::MASTER_REQUEST)
+    this->_sendMasterRequest(Job.version, Job.id, Job.numData, Job.data, Job.callback);
+  else
+    this->_receiveSlaveResponse(Job.version, Job.id, Job.numData, Job.callback);
+
+  // block on UART events until frame is finished. Wake at latest at frame timeout
+  while ((this->state == LIN_Master::STATE_BREAK) || (this->state == LIN_Master::STATE_BODY))
+  {
+    timeElapsed = this->_elapsed();
+    wait = (timeElapsed < this->timeMax) ? (pdMS_TO_TICKS(LIN_Master_Timebase::ticksToUs(this->timeMax - timeElapsed) / 1000L) + 1) : 0;
+    xQueuePeek(this->queueEvent, (void*) &event, wait);
+    this->handler();
+  }
+
+  // post result. On overflow discard newest result
+  this->_getResult(result);
+  if ((xQueueSend(this->queueTaskResult, (void*) &result, 0) != pdTRUE) && (this->lostResults < 255))
+    this->lostResults++;
+
+  // release LIN node for next job
+  this->resetStateMachine();
+  this->resetError();
+
+} // LIN_Master_UART_ESP32::_taskFrame()
+
+
+
+/**
+  \brief      LIN task function
+  \details    LIN task function. Blocks on job queue while idle and on UART event queue during a frame, i.e. no polling
+  \param[in]  Param     pointer to LIN node
+*/
+void LIN_Master_UART_ESP32::_task(void *Param)
+{
+  LIN_Master_UART_ESP32   *pLIN = (LIN_Master_UART_ESP32*) Param;
+  LIN_Master::job_t       job;
+
+  // process jobs forever. Task is deleted by stopTask()
+  while (true)
+  {
+    if (xQueueReceive(pLIN->queueTaskJob, (void*) &job, portMAX_DELAY) == pdTRUE)
+      pLIN->_taskFrame(job);
+  }
+
+} // LIN_Master_UART_ESP32::_task()
+
+
+
+/**
+  \brief      Constructor for LIN node class using ESP32 UART driver
+  \details    Constructor for LIN node class using ESP32 UART driver. Store UART port and pins.
+  \param[in]  Port          UART port, e.g. UART_NUM_2
+  \param[in]  PinRx         GPIO used for reception
+  \param[in]  PinTx         GPIO used for transmission
+  \param[in]  NameLIN       LIN node name
+*/
+LIN_Master_UART_ESP32::LIN_Master_UART_ESP32(uart_port_t Port, int8_t PinRx, int8_t PinTx, const char NameLIN[]) : LIN_Master::LIN_Master(NameLIN)
+{
+  // store parameters in class variables
+  this->port       = Port;                                    // UART port
+  this->pinRx      = PinRx;                                   // receive pin
+  this->pinTx      = PinTx;                                   // transmit pin
+  this->queueEvent = NULL;                                    // driver not yet installed
+  this->timeEvent  = 0;
+
+  // no LIN task by default
+  this->task            = NULL;
+  this->queueTaskJob    = NULL;
+  this->queueTaskResult = NULL;
+
+  // must not install driver here, else system resets
+
+} // LIN_Master_UART_ESP32::LIN_Master_UART_ESP32()
+
+
+
+/**
+  \brief      Open UART driver
+  \details    Install UART driver with event queue and configure UART and pins
+  \param[in]  Baudrate    communication speed [Baud]
+*/
+void LIN_Master_UART_ESP32::begin(uint16_t Baudrate)
+{
+  uart_config_t   config;
+
+  // call base class method
+  LIN_Master::begin(Baudrate);
+
+  // set UART parameters (8N1, no flow control)
+  memset(&config, 0, sizeof(config));
+  config.baud_rate = this->baudrate;
+  config.data_bits = UART_DATA_8_BITS;
+  config.parity    = UART_PARITY_DISABLE;
+  config.stop_bits = UART_STOP_BITS_1;
+  config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+  #if defined(ESP_IDF_VERSION_MAJOR) && (ESP_IDF_VERSION_MAJOR >= 5)
+    config.source_clk = UART_SCLK_DEFAULT;
+  #endif
+
+  // install driver with event queue. No Tx buffer, as frame fits into Tx FIFO
+  if (this->queueEvent == NULL)
+    uart_driver_install(this->port, LIN_UART_RX_BUFFER, 0, LIN_UART_EVENT_QUEUE, &(this->queueEvent), 0);
+  uart_param_config(this->port, &config);
+  uart_set_pin(this->port, this->pinTx, this->pinRx, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+
+  // fallback if less bytes than expected are received: signal after 2 idle characters
+  uart_set_rx_timeout(this->port, 2);
+
+} // LIN_Master_UART_ESP32::begin()
+
+
+
+/**
+  \brief      Close UART driver
+  \details    Uninstall UART driver
+*/
+void LIN_Master_UART_ESP32::end()
+{
+  // stop LIN task (if running)
+  this->stopTask();
+
+  // call base class method
+  LIN_Master::end();
+
+  // uninstall UART driver
+  if (this->queueEvent != NULL)
+    uart_driver_delete(this->port);
+  this->queueEvent = NULL;
+
+} // LIN_Master_UART_ESP32::end()
+
+
+
+/**
+  \brief      Start LIN task pinned to a core
+  \details    Create job and result queues and start a FreeRTOS task pinned to the specified core, which executes
+              posted frames. While the task runs, don't call handler() or start frames directly. Call after begin()
+  \param[in]  Core          core to run LIN task on (0 or 1; Arduino loop() runs on 1)
+  \param[in]  SizeJobs      length of job queue
+  \param[in]  SizeResults   length of result queue
+  \param[in]  Priority      priority of LIN task
+  \return     true if task was started
+*/
+bool LIN_Master_UART_ESP32::startTask(BaseType_t Core, uint8_t SizeJobs, uint8_t SizeResults, UBaseType_t Priority)
+{
+  // driver not installed or task already running
+  if ((this->queueEvent == NULL) || (this->task != NULL))
+    return false;
+
+  // create queues for jobs and results
+  this->queueTaskJob    = xQueueCreate(SizeJobs, sizeof(LIN_Master::job_t));
+  this->queueTaskResult = xQueueCreate(SizeResults, sizeof(LIN_Master::result_t));
+
+  // start LIN task
+  if ((this->queueTaskJob == NULL) || (this->queueTaskResult == NULL) ||
+    (xTaskCreatePinnedToCore(LIN_Master_UART_ESP32::_task, this->nameLIN, LIN_UART_TASK_STACK, (void*) this, Priority, &(this->task), Core) != pdPASS))
+  {
+    this->task = NULL;
+    this->stopTask();
+    return false;
+  }
+
+  // task started
+  return true;
+
+} // LIN_Master_UART_ESP32::startTask()
+
+
+
+/**
+  \brief      Stop LIN task
+  \details    Delete LIN task and its queues. An ongoing frame is aborted
+*/
+void LIN_Master_UART_ESP32::stopTask(void)
+{
+  // delete task
+  if (this->task != NULL)
+    vTaskDelete(this->task);
+  this->task = NULL;
+
+  // delete queues
+  if (this->queueTaskJob != NULL)
+    vQueueDelete(this->queueTaskJob);
+  if (this->queueTaskResult != NULL)
+    vQueueDelete(this->queueTaskResult);
+  this->queueTaskJob    = NULL;
+  this->queueTaskResult = NULL;
+
+  // release LIN node
+  if (this->state != LIN_Master::STATE_OFF)
+    this->resetStateMachine();
+
+} // LIN_Master_UART_ESP32::stopTask()
+
+
+
+/**
+  \brief      Post a master request frame to LIN task
+  \details    Append a master request frame to job queue of LIN task. Data is copied
+  \param[in]  Version   LIN protocol version
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \param[in]  NumData   number of data bytes (0..8)
+  \param[in]  Data      data bytes
+  \param[in]  Wait      max. ticks to wait for free queue entry
+  \return     true if frame was queued
+*/
+bool LIN_Master_UART_ESP32::postMasterRequest(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[], TickType_t Wait)
+{
+  LIN_Master::job_t   job;
+
+  // no task or invalid frame
+  if ((this->queueTaskJob == NULL) || (NumData > 8))
+    return false;
+
+  // post job to LIN task
+  job.type     = LIN_Master::MASTER_REQUEST;
+  job.version  = Version;
+  job.id       = Id;
+  job.numData  = NumData;
+  memcpy(job.data, Data, NumData);
+  job.callback = NULL;
+  return (xQueueSend(this->queueTaskJob, (void*) &job, Wait) == pdTRUE);
+
+} // LIN_Master_UART_ESP32::postMasterRequest()
+
+
+
+/**
+  \brief      Post a slave response frame to LIN task
+  \details    Append a slave response frame to job queue of LIN task
+  \param[in]  Version   LIN protocol version
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \param[in]  NumData   number of data bytes (0..8)
+  \param[in]  Wait      max. ticks to wait for free queue entry
+  \return     true if frame was queued
+*/
+bool LIN_Master_UART_ESP32::postSlaveResponse(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, TickType_t Wait)
+{
+  LIN_Master::job_t   job;
+
+  // no task or invalid frame
+  if ((this->queueTaskJob == NULL) || (NumData > 8))
+    return false;
+
+  // post job to LIN task
+  job.type     = LIN_Master::SLAVE_RESPONSE;
+  job.version  = Version;
+  job.id       = Id;
+  job.numData  = NumData;
+  job.callback = NULL;
+  return (xQueueSend(this->queueTaskJob, (void*) &job, Wait) == pdTRUE);
+
+} // LIN_Master_UART_ESP32::postSlaveResponse()
+
+#endif // ARDUINO_ARCH_ESP32
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,138 @@
+/**
+  \file     LIN_master_UART_ESP32.h
+  \brief    LIN master emulation library using the ESP-IDF UART driver of ESP32
+  \details  This library provides a master node emulation for a LIN bus via the ESP-IDF UART driver and its event queue.
+            The complete frame is received with a single RX FIFO threshold event, i.e. without per-byte polling
+            and without the >1ms delay of HardwareSerial::available().
+            Optionally the node runs in its own FreeRTOS task pinned to a core, which blocks on the UART event queue
+            and exchanges jobs and results with the application via FreeRTOS queues, see startTask().
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \note     The UART is used directly, i.e. the corresponding HardwareSerial (e.g. Serial2) must not be used.
+  \author   Georg Icking-Konert
+*/
+
+// assert ESP32 platform
+#if defined(ARDUINO_ARCH_ESP32)
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_UART_ESP32_H_
+#define _LIN_MASTER_UART_ESP32_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <Arduino.h>
+#include "driver/uart.h"
+#include "LIN_master.h"
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+#define LIN_UART_RX_BUFFER      256         //!< size of UART driver receive buffer (must be >128)
+#define LIN_UART_EVENT_QUEUE    20          //!< length of UART driver event queue
+#define LIN_UART_TASK_STACK     3072        //!< stack size [B] of LIN task (callbacks are executed in this task)
+#define LIN_UART_TASK_PRIORITY  5           //!< default priority of LIN task (Arduino loop() has priority 1)
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  LIN master node class via ESP32 UART driver
+
+  \details LIN master node class via ESP-IDF UART driver with event queue.
+*/
+class LIN_Master_UART_ESP32 : public LIN_Master
+{
+  // PROTECTED VARIABLES
+  protected:
+
+    uart_port_t           port;               //!< used UART port (e.g. UART_NUM_2)
+    int8_t                pinRx;              //!< pin used for receive
+    int8_t                pinTx;              //!< pin used for transmit
+    QueueHandle_t         queueEvent;         //!< UART driver event queue
+    uint32_t              timeEvent;          //!< time [ticks] of last UART data event, i.e. end of reception
+    TaskHandle_t          task;               //!< LIN task handle (NULL = no task)
+    QueueHandle_t         queueTaskJob;       //!< FreeRTOS queue of frames to send by LIN task
+    QueueHandle_t         queueTaskResult;    //!< FreeRTOS queue of frames finished by LIN task
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Read pending events from UART event queue
+    bool _readEvents(void);
+
+    /// @brief Send LIN break
+    LIN_Master::state_t _sendBreak(void);
+
+    /// @brief Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+    LIN_Master::state_t _sendFrame(void);
+
+    /// @brief Read and check LIN frame
+    LIN_Master::state_t _receiveFrame(void);
+
+    /// @brief Process one job of LIN task until frame is finished
+    void _taskFrame(const LIN_Master::job_t &Job);
+
+    /// @brief LIN task function. Parameter is pointer to LIN node
+    static void _task(void *Param);
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_UART_ESP32(uart_port_t Port, int8_t PinRx, int8_t PinTx, const char NameLIN[] = "");
+
+    /// @brief Open UART driver
+    void begin(uint16_t Baudrate);
+
+    /// @brief Close UART driver
+    void end(void);
+
+    /// @brief Getter for UART event queue, e.g. for blocking on UART events
+    inline QueueHandle_t getEventQueue(void) { return this->queueEvent; }
+
+    /// @brief Getter for time of last UART data event [us]
+    inline uint32_t getEventTime(void) { return this->timeEvent; }
+
+
+    /// @brief Start LIN task pinned to a core. Call after begin()
+    bool startTask(BaseType_t Core, uint8_t SizeJobs, uint8_t SizeResults, UBaseType_t Priority = LIN_UART_TASK_PRIORITY);
+
+    /// @brief Stop LIN task and delete its queues
+    void stopTask(void);
+
+    /// @brief Check if LIN task is running
+    inline bool isTaskRunning(void) { return (this->task != NULL); }
+
+    /// @brief Post a master request frame to LIN task
+    bool postMasterRequest(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, const uint8_t Data[], TickType_t Wait = 0);
+
+    /// @brief Post a slave response frame to LIN task
+    bool postSlaveResponse(LIN_Master::version_t Version, uint8_t Id, uint8_t NumData, TickType_t Wait = 0);
+
+    /// @brief Read oldest result of LIN task, wait up to Wait ticks
+    inline bool waitResult(LIN_Master::result_t &Result, TickType_t Wait = portMAX_DELAY)
+      { return ((this->queueTaskResult != NULL) && (xQueueReceive(this->queueTaskResult, &Result, Wait) == pdTRUE)); }
+
+    /// @brief Getter for FreeRTOS result queue of LIN task, e.g. for queue sets
+    inline QueueHandle_t getTaskResultQueue(void) { return this->queueTaskResult; }
+
+}; // class LIN_Master_UART_ESP32
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_UART_ESP32_H_
+
+#endif // ARDUINO_ARCH_ESP32
@@ -0,0 +1,298 @@
+/**
+  \file     LIN_master_USART_SAM.cpp
+  \brief    LIN master emulation library using a USART with PDC of SAM3X (Arduino Due)
+  \details  This library provides a master node emulation for a LIN bus via a USART of SAM3X and its
+            Peripheral DMA Controller (PDC). Frame body is sent and received by PDC, i.e. without per-byte polling.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \note     During a frame the Rx interrupt of the Arduino core is disabled, i.e. the USART must not be used otherwise.
+  \note     The USART interrupt handler is owned by the Arduino core, therefore PDC completion is checked via
+            the receive counter in handler() instead of ENDRX interrupt. This is a single register read per call.
+  \author   Georg Icking-Konert
+*/
+
+// assert SAM platform
+#if defined(ARDUINO_ARCH_SAM)
+
+// include files
+#include "Arduino.h"
+#include "LIN_master_USART_SAM.h"
+
+
+/**
+  \brief      Stop PDC transfers and restore Arduino Rx interrupt
+  \details    Stop PDC transfers, restore nominal baudrate and re-enable Rx interrupt of Arduino core
+*/
+void LIN_Master_USART_SAM::_stopPDC(void)
+{
+  // stop PDC Rx and Tx
+  this->pUsart->US_PTCR = US_PTCR_RXTDIS | US_PTCR_TXTDIS;
+  this->pUsart->US_RCR  = 0;
+  this->pUsart->US_TCR  = 0;
+
+  // restore nominal baudrate (e.g. after timeout during BREAK)
+  this->pUsart->US_BRGR = this->brgr;
+
+  // re-enable Rx interrupt of Arduino core
+  this->pUsart->US_CR  = US_CR_RSTSTA;
+  this->pUsart->US_IER = US_IER_RXRDY;
+
+} // LIN_Master_USART_SAM::_stopPDC()
+
+
+
+/**
+  \brief      Send LIN break
+  \details    Send LIN break (=16bit low)
+  \return     current state of LIN state machine
+*/
+LIN_Master::state_t LIN_Master_USART_SAM::_sendBreak(void)
+{
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master_USART_SAM::_sendBreak()");
+  #endif
+
+  // if state is wrong, exit immediately
+  if (this->state != LIN_Master::STATE_IDLE)
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_STATE);
+    this->state = LIN_Master::STATE_DONE;
+    return this->state;
+  }
+
+  // empty buffers, just in case...
+  this->pSerial->flush();
+  while (this->pSerial->available())
+    this->pSerial->read();
+
+  // disable Rx interrupt of Arduino core, PDC reads Rx register instead
+  this->pUsart->US_IDR = US_IDR_RXRDY;
+  (void) this->pUsart->US_RHR;
+  this->pUsart->US_CR  = US_CR_RSTSTA;
+
+  // set half baudrate for BREAK. Is only a register access, no re-init of USART
+  this->pUsart->US_BRGR = this->brgr << 1;
+
+  // receive BREAK echo via PDC
+  this->pUsart->US_RPR  = (uint32_t) this->bufRx;
+  this->pUsart->US_RCR  = 1;
+  this->pUsart->US_PTCR = US_PTCR_RXTEN;
+
+  // send BREAK (>=13 bit low)
+  this->pUsart->US_THR = this->bufTx[0];
+
+  // progress state
+  this->state = LIN_Master::STATE_BREAK;
+
+  // return state
+  return this->state;
+
+} // LIN_Master_USART_SAM::_sendBreak()
+
+
+
+/**
+  \brief      Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+  \details    Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID) via PDC
+  \return     current state of LIN state machine
+*/
+LIN_Master::state_t LIN_Master_USART_SAM::_sendFrame(void)
+{
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master_USART_SAM::_sendFrame()");
+  #endif
+
+  // if state is wrong, exit immediately
+  if (this->state != LIN_Master::STATE_BREAK)
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_STATE);
+    this->state = LIN_Master::STATE_DONE;
+    return this->state;
+  }
+
+  // BREAK echo received by PDC
+  if (this->pUsart->US_RCR == 0)
+  {
+    // wait until stop bit of BREAK is sent (<1 bit)
+    while (!(this->pUsart->US_CSR & US_CSR_TXEMPTY));
+
+    // restore nominal baudrate
+    this->pUsart->US_BRGR = this->brgr;
+
+    // receive rest of frame via PDC (-1 because BREAK is already handled)
+    this->pUsart->US_RPR  = (uint32_t) (this->bufRx+1);
+    this->pUsart->US_RCR  = this->lenRx-1;
+
+    // send rest of frame via PDC (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+    this->pUsart->US_TPR  = (uint32_t) (this->bufTx+1);
+    this->pUsart->US_TCR  = this->lenTx-1;
+    this->pUsart->US_PTCR = US_PTCR_TXTEN;
+
+    // progress state
+    this->state = LIN_Master::STATE_BODY;
+
+  } // BREAK echo received
+
+  // no byte(s) received
+  else
+  {
+    // check for timeout
+    if (this->_checkTimeout())
+    {
+      this->_stopPDC();
+      this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_TIMEOUT);
+      this->state = LIN_Master::STATE_DONE;
+    }
+
+  } // no byte(s) received
+
+  // return state
+  return this->state;
+
+} // LIN_Master_USART_SAM::_sendFrame()
+
+
+
+/**
+  \brief      Receive and check LIN frame
+  \details    Receive and check LIN frame (request frame: check echo; response frame: check header echo & checksum)
+  \return     current state of LIN state machine
+*/
+LIN_Master::state_t LIN_Master_USART_SAM::_receiveFrame(void)
+{
+  // print debug message
+  #if defined(LIN_DEBUG_SERIAL) && (LIN_DEBUG_LEVEL >= 2)
+    LIN_DEBUG_SERIAL.println("LIN_Master_USART_SAM::_receiveFrame()");
+  #endif
+
+  // if state is wrong, exit immediately
+  if (this->state != LIN_Master::STATE_BODY)
+  {
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_STATE);
+    this->state = LIN_Master::STATE_DONE;
+    return this->state;
+  }
+
+  // frame body received by PDC
+  if (this->pUsart->US_RCR == 0)
+  {
+    // release USART to Arduino core
+    this->_stopPDC();
+
+    // check frame for errors
+    this->error = (LIN_Master::error_t) ((int) this->error | (int) this->_checkFrame());
+
+    // progress state
+    this->state = LIN_Master::STATE_DONE;
+
+  } // frame body received
+
+  // frame body received not yet received
+  else
+  {
+    // check for timeout
+    if (this->_checkTimeout())
+    {
+      this->_stopPDC();
+      this->error = (LIN_Master::error_t) ((int) this->error | (int) LIN_Master::ERROR_TIMEOUT);
+      this->state = LIN_Master::STATE_DONE;
+    }
+
+  } // not enough bytes received
+
+  // return state
+  return this->state;
+
+} // LIN_Master_USART_SAM::_receiveFrame()
+
+
+
+/**
+  \brief      Apply changed baudrate to USART
+  \details    Apply changed baudrate to USART. Calculate baudrate register like USARTClass::begin(). Is only a register
+              access, no re-init of USART
+*/
+void LIN_Master_USART_SAM::_setBaudrate(void)
+{
+  // set baudrate register. Is also used as base for BREAK
+  this->brgr = (SystemCoreClock / this->baudrate) >> 4;
+  this->pUsart->US_BRGR = this->brgr;
+
+} // LIN_Master_USART_SAM::_setBaudrate()
+
+
+
+/**
+  \brief      Constructor for LIN node class using SAM3X USART with PDC
+  \details    Constructor for LIN node class using SAM3X USART with PDC. Store pointers to used serial
+              interface and corresponding USART peripheral (Serial1=USART0, Serial2=USART1, Serial3=USART3).
+  \param[in]  Interface     serial interface for LIN (Serial1..Serial3)
+  \param[in]  NameLIN       LIN node name
+*/
+LIN_Master_USART_SAM::LIN_Master_USART_SAM(USARTClass &Interface, const char NameLIN[]) : LIN_Master::LIN_Master(NameLIN)
+{
+  // store pointer to used serial
+  this->pSerial = &Interface;
+
+  // get USART peripheral of serial interface (see variant.cpp of Arduino Due)
+  if (&Interface == &Serial1)
+    this->pUsart = USART0;
+  else if (&Interface == &Serial2)
+    this->pUsart = USART1;
+  else
+    this->pUsart = USART3;
+
+  // baudrate register is set in begin()
+  this->brgr = 0;
+
+  // must not open connection here
+
+} // LIN_Master_USART_SAM::LIN_Master_USART_SAM()
+
+
+
+/**
+  \brief      Open serial interface
+  \details    Open serial interface with specified baudrate and store baudrate register for BREAK generation
+  \param[in]  Baudrate    communication speed [Baud]
+*/
+void LIN_Master_USART_SAM::begin(uint16_t Baudrate)
+{
+  // call base class method
+  LIN_Master::begin(Baudrate);
+
+  // open serial interface
+  this->pSerial->begin(this->baudrate);
+  while(!(*(this->pSerial)));
+
+  // store nominal baudrate register
+  this->brgr = this->pUsart->US_BRGR;
+
+  // PDC idle
+  this->pUsart->US_PTCR = US_PTCR_RXTDIS | US_PTCR_TXTDIS;
+
+} // LIN_Master_USART_SAM::begin()
+
+
+
+/**
+  \brief      Close serial interface
+  \details    Stop PDC and close serial interface
+*/
+void LIN_Master_USART_SAM::end()
+{
+  // call base class method
+  LIN_Master::end();
+
+  // stop PDC and close serial interface
+  this->_stopPDC();
+  this->pSerial->end();
+
+} // LIN_Master_USART_SAM::end()
+
+#endif // ARDUINO_ARCH_SAM
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,87 @@
+/**
+  \file     LIN_master_USART_SAM.h
+  \brief    LIN master emulation library using a USART with PDC of SAM3X (Arduino Due)
+  \details  This library provides a master node emulation for a LIN bus via a USART of SAM3X and its
+            Peripheral DMA Controller (PDC). Frame body is sent and received by PDC, i.e. without per-byte polling.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \note     During a frame the Rx interrupt of the Arduino core is disabled, i.e. the USART must not be used otherwise.
+  \author   Georg Icking-Konert
+*/
+
+// assert SAM platform
+#if defined(ARDUINO_ARCH_SAM)
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_USART_SAM_H_
+#define _LIN_MASTER_USART_SAM_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <Arduino.h>
+#include "LIN_master.h"
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  LIN master node class via SAM3X USART with PDC
+
+  \details LIN master node class via SAM3X USART with Peripheral DMA Controller (PDC).
+*/
+class LIN_Master_USART_SAM : public LIN_Master
+{
+  // PROTECTED VARIABLES
+  protected:
+
+    USARTClass            *pSerial;           //!< pointer to used Arduino serial (Serial1..Serial3)
+    Usart                 *pUsart;            //!< pointer to USART peripheral registers
+    uint32_t              brgr;               //!< USART baudrate register for nominal baudrate
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Stop PDC transfers and restore Arduino Rx interrupt
+    void _stopPDC(void);
+
+    /// @brief Send LIN break
+    LIN_Master::state_t _sendBreak(void);
+
+    /// @brief Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+    LIN_Master::state_t _sendFrame(void);
+
+    /// @brief Read and check LIN frame
+    LIN_Master::state_t _receiveFrame(void);
+
+    /// @brief Apply changed baudrate to USART (register access only)
+    void _setBaudrate(void);
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_USART_SAM(USARTClass &Interface, const char NameLIN[] = "");
+
+    /// @brief Open serial interface
+    void begin(uint16_t Baudrate);
+
+    /// @brief Close serial interface
+    void end(void);
+
+}; // class LIN_Master_USART_SAM
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_USART_SAM_H_
+
+#endif // ARDUINO_ARCH_SAM